@@ -20,12 +20,16 @@
  *
  */
 
+#include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/util.h"
+#include "common/mutex.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
 #include "audio/mixer_intern.h"
 #include "audio/rate.h"
+#include "audio/rate_kernels.h"
 #include "audio/audiostream.h"
 #include "audio/timestamp.h"
 
@@ -42,24 +46,76 @@ namespace Audio {
  */
 class Channel {
 public:
-	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent);
+	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, RateConverterQuality quality, uint ringFrames);
 	~Channel();
 
 	/**
 	 * Mixes the channel's samples into the given buffer.
 	 *
-	 * @param data buffer where to mix the data
-	 * @param len  number of sample *pairs*. So a value of
-	 *             10 means that the buffer contains twice 10 sample, each
-	 *             16 bits, for a total of 40 bytes.
+	 * @param data     buffer where to mix the data
+	 * @param len      number of sample *pairs*. So a value of
+	 *                 10 means that the buffer contains twice 10 sample, each
+	 *                 16 bits, for a total of 40 bytes.
+	 * @param finished set to true if the channel has finished playing
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
-	int mix(int16 *data, uint len);
+	int mix(int16 *data, uint len, bool &finished);
 
 	/**
-	 * Queries whether the channel is still playing or not.
+	 * Decodes samples into the ring buffer of the channel, until it is full
+	 * or no more input is available. Only used in decode-ahead mode.
 	 */
-	bool isFinished() const { return _stream->endOfStream(); }
+	void decode();
+
+	/**
+	 * Queries whether the ring buffer of the channel should be refilled.
+	 * This is only a hint, since it is checked without locking.
+	 */
+	bool needsDecode() const {
+		return _ring && !_stopped && !_ringEnded && !isPaused() && _ringFill < _ringSize / 2;
+	}
+
+	/**
+	 * Queries whether the ring buffer ran dry in the last mix() call.
+	 */
+	bool hadUnderrun() const { return _underrun; }
+
+	/**
+	 * Queries whether the channel is still playing or not. Must not be
+	 * called once the channel is stopped.
+	 */
+	bool isFinished();
+
+	/**
+	 * Stops the channel. Waits for a mix of this channel which might be in
+	 * progress in the audio thread and releases the stream afterwards, so
+	 * that the stream is guaranteed not to be accessed anymore once this
+	 * returns.
+	 */
+	void stop();
+
+	/**
+	 * Adds resp. removes a reference of a decode pass to the channel.
+	 * Stopped channels are only deleted once they are not referenced
+	 * anymore. Only accessed with the mixer mutex held.
+	 */
+	void retain() { _refCount++; }
+	void release() { _refCount--; }
+	bool isReferenced() const { return _refCount > 0; }
+
+	/**
+	 * The generation of the first channel snapshot which does not contain
+	 * the channel anymore. Only accessed with the mixer mutex held.
+	 */
+	void setRetiredGeneration(uint32 generation) { _retiredGeneration = generation; }
+	uint32 getRetiredGeneration() const { return _retiredGeneration; }
+
+	/**
+	 * Marks the channel as being decoded by a worker thread. Only accessed
+	 * with the mixer mutex held.
+	 */
+	void setClaimed(bool claimed) { _claimed = claimed; }
+	bool isClaimed() const { return _claimed; }
 
 	/**
 	 * Queries whether the channel is a permanent channel.
@@ -104,7 +160,7 @@ public:
 	 * Notifies the channel that the global sound type
 	 * volume settings changed.
 	 */
-	void notifyGlobalVolChange() { updateChannelVolumes(); }
+	void notifyGlobalVolChange();
 
 	/**
 	 * Queries how long the channel has been playing.
@@ -135,6 +191,33 @@ private:
 	int _pauseLevel;
 	int _id;
 
+	/** Held while the stream is decoded and while the channel is stopped. */
+	Common::Mutex _mutex;
+	bool _stopped;
+	int _refCount;
+	bool _claimed;
+	uint32 _retiredGeneration;
+
+	/**
+	 * Ring buffer of converted stereo samples (at full volume) in
+	 * decode-ahead mode, 0 otherwise. _ringRead and _ringFill are
+	 * guarded by _ringMutex.
+	 */
+	Common::Mutex _ringMutex;
+	int16 *_ring;
+	uint _ringSize;
+	uint _ringRead;
+	uint _ringFill;
+	bool _ringEnded;
+	bool _underrun;
+	const MixKernels &_kernels;
+
+	/**
+	 * The mutex held by mix(), which also guards the volume, pause and
+	 * timing state of the channel.
+	 */
+	Common::Mutex &stateMutex() { return _ring ? _ringMutex : _mutex; }
+
 	byte _volume;
 	int8 _balance;
 
@@ -160,17 +243,32 @@ private:
 
 
 MixerImpl::MixerImpl(OSystem *system, uint sampleRate)
-	: _syst(system), _mutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _syst(system), _mutex(), _handoffMutex(), _sampleRate(sampleRate), _mixerReady(false), _handleSeed(0),
+	  _publishedChannels(0), _mixGeneration(0), _channelsFinished(false), _generation(1), _channelsChanged(false),
+	  _activeChannels(0), _stats(), _decodeAheadFrames(0), _resamplingQuality(kRateQualityFast),
+	  _soundTypeSettings() {
 
 	assert(sampleRate > 0);
 
-	for (int i = 0; i != NUM_CHANNELS; i++)
-		_channels[i] = 0;
+	setResamplingQuality(ConfMan.getInt("resampling_quality"));
+
+	_channels.resize(kInitialChannels);
+
+	_publishedChannels = new ChannelSnapshot();
+	_publishedChannels->generation = _generation;
 }
 
 MixerImpl::~MixerImpl() {
-	for (int i = 0; i != NUM_CHANNELS; i++)
+	for (uint i = 0; i != _channels.size(); i++)
 		delete _channels[i];
+	for (uint i = 0; i != _retiredChannels.size(); i++)
+		delete _retiredChannels[i];
+	for (uint i = 0; i != _oldSnapshots.size(); i++)
+		delete _oldSnapshots[i];
+	delete _publishedChannels;
+
+	debug(1, "MixerImpl: %d channels at peak, %d overflowed the former channel table, %d calls contended with the mixer, %d decode underruns",
+	      _stats.peakChannels, _stats.overflowedChannels, _stats.contendedCalls, _stats.decodeUnderruns);
 }
 
 void MixerImpl::setReady(bool ready) {
@@ -182,23 +280,31 @@ uint MixerImpl::getOutputRate() const {
 }
 
 void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
-	int index = -1;
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] == 0) {
-			index = i;
-			break;
+	uint index = 0;
+	while (index < _channels.size() && _channels[index] != 0)
+		index++;
+
+	if (index == _channels.size()) {
+		if (index >= kMaxChannels) {
+			warning("MixerImpl::out of mixer slots");
+			delete chan;
+			return;
 		}
+
+		_channels.resize(MIN<uint>(index * 2, kMaxChannels));
 	}
-	if (index == -1) {
-		warning("MixerImpl::out of mixer slots");
-		delete chan;
-		return;
-	}
+
+	if (_activeChannels >= kInitialChannels)
+		_stats.overflowedChannels++;
+	_activeChannels++;
+	if (_activeChannels > _stats.peakChannels)
+		_stats.peakChannels = _activeChannels;
 
 	_channels[index] = chan;
+	_channelsChanged = true;
 
 	SoundHandle chanHandle;
-	chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
+	chanHandle._val = index | (_handleSeed << kHandleIndexBits);
 
 	chan->setHandle(chanHandle);
 	_handleSeed++;
@@ -206,6 +312,95 @@ void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 		*handle = chanHandle;
 }
 
+Channel *MixerImpl::findChannel(SoundHandle handle) const {
+	const uint index = handle._val & kHandleIndexMask;
+	if (index >= _channels.size() || !_channels[index] || _channels[index]->getHandle()._val != handle._val)
+		return 0;
+
+	return _channels[index];
+}
+
+void MixerImpl::removeChannel(uint index) {
+	Channel *chan = _channels[index];
+	_channels[index] = 0;
+	_activeChannels--;
+	_channelsChanged = true;
+
+	chan->stop();
+
+	// The audio thread might still be mixing a snapshot containing the
+	// channel, and a decoding thread might still hold a reference to it.
+	// The channel is deleted by commitChannels() once both are done.
+	chan->setRetiredGeneration(_generation + 1);
+	_retiredChannels.push_back(chan);
+}
+
+void MixerImpl::commitChannels() {
+	if (_channelsChanged) {
+		// Build the new snapshot outside of the handoff lock
+		ChannelSnapshot *snapshot = new ChannelSnapshot();
+		snapshot->generation = ++_generation;
+		snapshot->channels.reserve(_activeChannels);
+		for (uint i = 0; i != _channels.size(); i++)
+			if (_channels[i])
+				snapshot->channels.push_back(_channels[i]);
+
+		{
+			Common::StackLock lock(_handoffMutex);
+			SWAP(snapshot, _publishedChannels);
+		}
+
+		_oldSnapshots.push_back(snapshot);
+		_channelsChanged = false;
+	}
+
+	uint32 mixGeneration;
+	{
+		Common::StackLock lock(_handoffMutex);
+		mixGeneration = _mixGeneration;
+	}
+
+	// Snapshots older than the one being mixed are not used anymore. If
+	// no mix is in progress, the next one picks up the published snapshot.
+	for (uint i = 0; i < _oldSnapshots.size(); ) {
+		if (mixGeneration == 0 || _oldSnapshots[i]->generation < mixGeneration) {
+			delete _oldSnapshots[i];
+			_oldSnapshots.remove_at(i);
+		} else {
+			i++;
+		}
+	}
+
+	for (uint i = 0; i < _retiredChannels.size(); ) {
+		Channel *chan = _retiredChannels[i];
+		if (!chan->isReferenced() && (mixGeneration == 0 || mixGeneration >= chan->getRetiredGeneration())) {
+			delete chan;
+			_retiredChannels.remove_at(i);
+		} else {
+			i++;
+		}
+	}
+}
+
+void MixerImpl::beginEngineCall() {
+	bool finished;
+	{
+		Common::StackLock lock(_handoffMutex);
+		if (_mixGeneration)
+			_stats.contendedCalls++;
+		finished = _channelsFinished;
+		_channelsFinished = false;
+	}
+
+	if (finished) {
+		for (uint i = 0; i != _channels.size(); i++)
+			if (_channels[i] && _channels[i]->isFinished())
+				removeChannel(i);
+	}
+
+	commitChannels();
+}
+
 void MixerImpl::playStream(
 			SoundType type,
 			SoundHandle *handle,
@@ -214,8 +409,6 @@ void MixerImpl::playStream(
 			DisposeAfterUse::Flag autofreeStream,
 			bool permanent,
 			bool reverseStereo) {
-	Common::StackLock lock(_mutex);
-
 	if (stream == 0) {
 		warning("stream is 0");
 		return;
@@ -224,38 +417,54 @@ void MixerImpl::playStream(
 
 	assert(_mixerReady);
 
-	// Prevent duplicate sounds
-	if (id != -1) {
-		for (int i = 0; i != NUM_CHANNELS; i++)
-			if (_channels[i] != 0 && _channels[i]->getId() == id) {
-				// Delete the stream if were asked to auto-dispose it.
-				// Note: This could cause trouble if the client code does not
-				// yet expect the stream to be gone. The primary example to
-				// keep in mind here is QueuingAudioStream.
-				// Thus, as a quick rule of thumb, you should never, ever,
-				// try to play QueuingAudioStreams with a sound id.
-				if (autofreeStream == DisposeAfterUse::YES)
-					delete stream;
-				return;
-			}
-	}
-
 #ifdef AUDIO_REVERSE_STEREO
 	reverseStereo = !reverseStereo;
 #endif
 
-	// Create the channel
-	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
+	RateConverterQuality quality;
+	{
+		Common::StackLock lock(_mutex);
+		beginEngineCall();
+
+		// Prevent duplicate sounds. This is checked before the channel is
+		// created, since in decode-ahead mode that already reads the start
+		// of the stream.
+		if (id != -1 && hasChannelWithId(id)) {
+			// Delete the stream if were asked to auto-dispose it.
+			// Note: This could cause trouble if the client code does not
+			// yet expect the stream to be gone. The primary example to
+			// keep in mind here is QueuingAudioStream.
+			// Thus, as a quick rule of thumb, you should never, ever,
+			// try to play QueuingAudioStreams with a sound id.
+			if (autofreeStream == DisposeAfterUse::YES)
+				delete stream;
+			return;
+		}
+
+		quality = (RateConverterQuality)_resamplingQuality;
+	}
+
+	// Create the channel. This is done outside of the lock, since setting
+	// up the rate converter does not need access to the channel table.
+	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent, quality, _decodeAheadFrames);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
+
+	Common::StackLock lock(_mutex);
+
+	// Another thread might have started a sound with the same id meanwhile
+	if (id != -1 && hasChannelWithId(id)) {
+		delete chan;
+		return;
+	}
+
 	insertChannel(handle, chan);
+	commitChannels();
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
-	Common::StackLock lock(_mutex);
-
 	int16 *buf = (int16 *)samples;
 	// we store stereo, 16-bit samples
 	assert(len % 4 == 0);
@@ -267,61 +476,114 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	//  zero the buf
 	memset(buf, 0, 2 * len * sizeof(int16));
 
+	// Pick up the latest snapshot of the channels. It stays valid until
+	// the mix is marked as done below.
+	const ChannelSnapshot *snapshot;
+	{
+		Common::StackLock lock(_handoffMutex);
+		snapshot = _publishedChannels;
+		_mixGeneration = snapshot->generation;
+	}
+
 	// mix all channels
 	int res = 0, tmp;
-	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i]) {
-			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = 0;
-			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
-
-				if (tmp > res)
-					res = tmp;
+	bool finished = false;
+	uint underruns = 0;
+	for (uint i = 0; i != snapshot->channels.size(); i++) {
+		Channel *chan = snapshot->channels[i];
+		bool chanFinished = false;
+		tmp = chan->mix(buf, len, chanFinished);
+
+		if (tmp > res)
+			res = tmp;
+		if (chanFinished)
+			finished = true;
+		if (chan->hadUnderrun())
+			underruns++;
+	}
+
+	{
+		Common::StackLock lock(_handoffMutex);
+		_mixGeneration = 0;
+		if (finished)
+			_channelsFinished = true;
+		_stats.decodeUnderruns += underruns;
+	}
+
+	return res;
+}
+
+bool MixerImpl::decodeAhead() {
+	Channel *chan = 0;
+
+	{
+		Common::StackLock lock(_mutex);
+
+		for (uint i = 0; i != _channels.size(); i++) {
+			if (_channels[i] && !_channels[i]->isClaimed() && _channels[i]->needsDecode()) {
+				chan = _channels[i];
+				break;
 			}
 		}
 
-	return res;
+		if (!chan)
+			return false;
+
+		chan->setClaimed(true);
+		chan->retain();
+	}
+
+	chan->decode();
+
+	{
+		Common::StackLock lock(_mutex);
+
+		chan->setClaimed(false);
+		chan->release();
+		commitChannels();
+	}
+
+	return true;
 }
 
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = 0;
-		}
+	beginEngineCall();
+	for (uint i = 0; i != _channels.size(); i++) {
+		if (_channels[i] != 0 && !_channels[i]->isPermanent())
+			removeChannel(i);
 	}
+	commitChannels();
 }
 
 void MixerImpl::stopID(int id) {
 	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != 0 && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = 0;
-		}
+	beginEngineCall();
+	for (uint i = 0; i != _channels.size(); i++) {
+		if (_channels[i] != 0 && _channels[i]->getId() == id)
+			removeChannel(i);
 	}
+	commitChannels();
 }
 
 void MixerImpl::stopHandle(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
+	beginEngineCall();
 
 	// Simply ignore stop requests for handles of sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	if (!findChannel(handle))
 		return;
 
-	delete _channels[index];
-	_channels[index] = 0;
+	removeChannel(handle._val & kHandleIndexMask);
+	commitChannels();
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
 	assert(0 <= type && type < ARRAYSIZE(_soundTypeSettings));
 	_soundTypeSettings[type].mute = mute;
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
+	Common::StackLock lock(_mutex);
+	for (uint i = 0; i != _channels.size(); ++i) {
 		if (_channels[i] && _channels[i]->getType() == type)
 			_channels[i]->notifyGlobalVolChange();
 	}
@@ -334,22 +596,20 @@ bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
 	Common::StackLock lock(_mutex);
+	beginEngineCall();
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setVolume(volume);
+	Channel *chan = findChannel(handle);
+	if (chan)
+		chan->setVolume(volume);
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
 	Common::StackLock lock(_mutex);
+	beginEngineCall();
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->setBalance(balance);
+	Channel *chan = findChannel(handle);
+	if (chan)
+		chan->setBalance(balance);
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -358,17 +618,19 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
+	beginEngineCall();
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	Channel *chan = findChannel(handle);
+	if (!chan)
 		return Timestamp(0, _sampleRate);
 
-	return _channels[index]->getElapsedTime();
+	return chan->getElapsedTime();
 }
 
 void MixerImpl::pauseAll(bool paused) {
 	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
+	beginEngineCall();
+	for (uint i = 0; i != _channels.size(); i++) {
 		if (_channels[i] != 0) {
 			_channels[i]->pause(paused);
 		}
@@ -377,7 +639,8 @@ void MixerImpl::pauseAll(bool paused) {
 
 void MixerImpl::pauseID(int id, bool paused) {
 	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
+	beginEngineCall();
+	for (uint i = 0; i != _channels.size(); i++) {
 		if (_channels[i] != 0 && _channels[i]->getId() == id) {
 			_channels[i]->pause(paused);
 			return;
@@ -387,18 +650,22 @@ void MixerImpl::pauseID(int id, bool paused) {
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
 	Common::StackLock lock(_mutex);
+	beginEngineCall();
 
 	// Simply ignore (un)pause requests for sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return;
-
-	_channels[index]->pause(paused);
+	Channel *chan = findChannel(handle);
+	if (chan)
+		chan->pause(paused);
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
 	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++)
+	beginEngineCall();
+	return hasChannelWithId(id);
+}
+
+bool MixerImpl::hasChannelWithId(int id) const {
+	for (uint i = 0; i != _channels.size(); i++)
 		if (_channels[i] && _channels[i]->getId() == id)
 			return true;
 	return false;
@@ -406,21 +673,23 @@ bool MixerImpl::isSoundIDActive(int id) {
 
 int MixerImpl::getSoundID(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
+	beginEngineCall();
+	Channel *chan = findChannel(handle);
+	if (chan)
+		return chan->getId();
 	return 0;
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
 	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	beginEngineCall();
+	return findChannel(handle) != 0;
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
 	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++)
+	beginEngineCall();
+	for (uint i = 0; i != _channels.size(); i++)
 		if (_channels[i] && _channels[i]->getType() == type)
 			return true;
 	return false;
@@ -441,7 +710,7 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	Common::StackLock lock(_mutex);
 	_soundTypeSettings[type].volume = volume;
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
+	for (uint i = 0; i != _channels.size(); ++i) {
 		if (_channels[i] && _channels[i]->getType() == type)
 			_channels[i]->notifyGlobalVolChange();
 	}
@@ -453,14 +722,21 @@ int MixerImpl::getVolumeForSoundType(SoundType type) const {
 	return _soundTypeSettings[type].volume;
 }
 
+void MixerImpl::setResamplingQuality(int quality) {
+	Common::StackLock lock(_mutex);
+	_resamplingQuality = CLIP<int>(quality, kRateQualityFast, kRateQualityHigh);
+}
+
 
 #pragma mark -
 #pragma mark --- Channel implementations ---
 #pragma mark -
 
 Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
-                 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent)
-    : _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
+                 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, RateConverterQuality quality, uint ringFrames)
+    : _type(type), _mixer(mixer), _id(id), _permanent(permanent), _stopped(false), _refCount(0), _claimed(false), _retiredGeneration(0),
+      _ring(0), _ringSize(0), _ringRead(0), _ringFill(0), _ringEnded(false), _underrun(false), _kernels(getBestMixKernels()),
+      _volume(Mixer::kMaxChannelVolume),
       _balance(0), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
       _pauseStartTime(0), _pauseTime(0), _autofreeStream(autofreeStream), _converter(0),
       _stream(stream) {
@@ -468,25 +744,61 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo);
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo, quality);
+
+	// In decode-ahead mode, decode the start of the stream right away, so
+	// that the first mix pass does not have to wait for a worker thread.
+	if (ringFrames) {
+		_ringSize = ringFrames;
+		_ring = new int16[_ringSize * 2];
+		decode();
+	}
 }
 
 Channel::~Channel() {
+	delete[] _ring;
 	delete _converter;
 	if (_autofreeStream == DisposeAfterUse::YES)
 		delete _stream;
 }
 
+void Channel::stop() {
+	Common::StackLock lock(_mutex);
+	Common::StackLock ringLock(_ringMutex);
+
+	_stopped = true;
+
+	delete _converter;
+	_converter = 0;
+	if (_autofreeStream == DisposeAfterUse::YES)
+		delete _stream;
+	_stream = 0;
+}
+
+bool Channel::isFinished() {
+	Common::StackLock lock(stateMutex());
+
+	assert(!_stopped);
+	return _ring ? (_ringEnded && _ringFill == 0) : _stream->endOfStream();
+}
+
 void Channel::setVolume(const byte volume) {
+	Common::StackLock lock(stateMutex());
 	_volume = volume;
 	updateChannelVolumes();
 }
 
 void Channel::setBalance(const int8 balance) {
+	Common::StackLock lock(stateMutex());
 	_balance = balance;
 	updateChannelVolumes();
 }
 
+void Channel::notifyGlobalVolChange() {
+	Common::StackLock lock(stateMutex());
+	updateChannelVolumes();
+}
+
 void Channel::updateChannelVolumes() {
 	// From the channel balance/volume and the global volume, we compute
 	// the effective volume for the left and right channel. Note the
@@ -516,6 +828,7 @@ void Channel::updateChannelVolumes() {
 
 void Channel::pause(bool paused) {
 	//assert((paused && _pauseLevel >= 0) || (!paused && _pauseLevel));
+	Common::StackLock lock(stateMutex());
 
 	if (paused) {
 		_pauseLevel++;
@@ -533,6 +846,10 @@ void Channel::pause(bool paused) {
 }
 
 Timestamp Channel::getElapsedTime() {
+	// In decode-ahead mode the timing is updated with the ring lock held,
+	// which avoids waiting for a worker thread.
+	Common::StackLock lock(stateMutex());
+
 	const uint32 rate = _mixer->getOutputRate();
 	uint32 delta = 0;
 
@@ -560,7 +877,76 @@ Timestamp Channel::getElapsedTime() {
 	return ts;
 }
 
-int Channel::mix(int16 *data, uint len) {
+void Channel::decode() {
+	Common::StackLock lock(_mutex);
+
+	if (_stopped || _ringEnded)
+		return;
+
+	uint free, write;
+	{
+		Common::StackLock ringLock(_ringMutex);
+		free = _ringSize - _ringFill;
+		write = (_ringRead + _ringFill) % _ringSize;
+	}
+
+	// The free part of the ring buffer is not touched by mix(), so it can
+	// be filled without holding the ring lock.
+	while (free > 0) {
+		const uint len = MIN(free, _ringSize - write);
+		int16 *dst = _ring + write * 2;
+
+		memset(dst, 0, len * 2 * sizeof(int16));
+		int res = 0;
+		if (!_stream->endOfData())
+			res = _converter->flow(*_stream, dst, len, Mixer::kMaxMixerVolume, Mixer::kMaxMixerVolume);
+
+		Common::StackLock ringLock(_ringMutex);
+		_ringFill += res;
+		if (_stream->endOfStream())
+			_ringEnded = true;
+
+		if (res < (int)len)
+			break;
+
+		free -= res;
+		write = (write + res) % _ringSize;
+	}
+}
+
+int Channel::mix(int16 *data, uint len, bool &finished) {
+	if (_ring) {
+		Common::StackLock ringLock(_ringMutex);
+
+		if (_stopped || isPaused())
+			return 0;
+
+		const uint res = MIN(len, _ringFill);
+		const uint first = MIN(res, _ringSize - _ringRead);
+
+		_kernels.mixStereo(data, _ring + _ringRead * 2, first, _volL, _volR);
+		_kernels.mixStereo(data + first * 2, _ring, res - first, _volL, _volR);
+
+		_ringRead = (_ringRead + res) % _ringSize;
+		_ringFill -= res;
+		_underrun = (res < len && !_ringEnded);
+
+		_samplesConsumed = _samplesDecoded;
+		_mixerTimeStamp = g_system->getMillis();
+		_pauseTime = 0;
+		_samplesDecoded += res;
+
+		finished = (_ringEnded && _ringFill == 0);
+		return res;
+	}
+
+	Common::StackLock lock(_mutex);
+
+	// The channel might have been stopped or paused after the mixer picked
+	// it up for the current mix pass.
+	if (_stopped || isPaused())
+		return 0;
+
 	assert(_stream);
 
 	int res = 0;
@@ -576,6 +962,7 @@ int Channel::mix(int16 *data, uint len) {
 		_samplesDecoded += res;
 	}
 
+	finished = _stream->endOfStream();
 	return res;
 }
 
@@ -255,6 +255,15 @@ public:
 	 */
 	virtual int getVolumeForSoundType(SoundType type) const = 0;
 
+	/**
+	 * Set the quality of the sample rate conversion for sounds started
+	 * from now on.
+	 *
+	 * @param quality the quality level, as stored in the
+	 *                "resampling_quality" config key
+	 */
+	virtual void setResamplingQuality(int quality) = 0;
+
 	/**
 	 * Query the system's audio output sample rate.
 	 *
@@ -24,6 +24,7 @@
 #define SOUND_MIXER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
 
@@ -42,6 +43,22 @@ namespace Audio {
  * 4) Change the mixer into ready mode via setReady(true).
  * 5) Start audio processing (e.g. by resuming the audio thread, if applicable).
  *
+ * The channel table grows on demand. It is only accessed by the engine
+ * side, with the mixer mutex held. Whenever the table changes, an immutable
+ * snapshot of the channels is handed over to mixCallback(), which never
+ * takes the mixer mutex and thus never waits for engine calls such as
+ * playStream() or stopHandle(). Channels removed from the table are kept
+ * alive until the audio thread stopped using the snapshots referring to
+ * them. Stopping a channel that is being mixed at that very moment waits
+ * for that single channel only, which keeps the guarantee that a stream is
+ * not touched anymore once the stop call returned.
+ *
+ * Optionally, decoding and rate conversion of the channels can be moved out
+ * of mixCallback() (see setDecodeAhead()). Each channel then gets a ring
+ * buffer of converted samples, which is filled ahead of time by decodeAhead()
+ * calls from worker threads of the backend, so that the callback itself only
+ * has to sum up ready PCM data.
+ *
  * In the future, we might make it possible for backends to provide
  * (partial) alternative implementations of the mixer, e.g. to make
  * better use of native sound mixing support on low-end devices.
@@ -49,18 +66,96 @@ namespace Audio {
  * @see OSystem::getMixer()
  */
 class MixerImpl : public Mixer {
+public:
+	/**
+	 * Statistics about the usage of the channel table.
+	 */
+	struct ChannelStats {
+		ChannelStats() : contendedCalls(0), overflowedChannels(0), peakChannels(0), decodeUnderruns(0) {}
+
+		/**
+		 * Number of engine calls which were made while a mix was in
+		 * progress, i.e. which would have been blocked until the end of
+		 * the mix by a global mixer lock.
+		 */
+		uint32 contendedCalls;
+
+		/**
+		 * Number of channels which were started while kInitialChannels
+		 * channels were already active, i.e. which would have been dropped
+		 * by the former fixed size channel table.
+		 */
+		uint32 overflowedChannels;
+
+		/** Highest number of simultaneously active channels. */
+		uint peakChannels;
+
+		/**
+		 * Number of times a channel ran out of decoded samples in
+		 * decode-ahead mode.
+		 */
+		uint32 decodeUnderruns;
+	};
+
 private:
 	enum {
-		NUM_CHANNELS = 16
+		/** Initial size of the channel table (the size of the former fixed table). */
+		kInitialChannels = 16,
+		/** Number of bits of a SoundHandle used for the channel table index. */
+		kHandleIndexBits = 16,
+		kHandleIndexMask = (1 << kHandleIndexBits) - 1,
+		/** Maximal size of the channel table; the last index is never used, so that an invalid SoundHandle can never match. */
+		kMaxChannels = kHandleIndexMask
+	};
+
+	/**
+	 * An immutable list of the channels to mix, handed over from the
+	 * engine side to mixCallback(). Generations start at 1.
+	 */
+	struct ChannelSnapshot {
+		uint32 generation;
+		Common::Array<Channel *> channels;
 	};
 
 	OSystem *_syst;
+
+	/** Guards the channel table. Never taken by mixCallback(). */
 	Common::Mutex _mutex;
 
+	/**
+	 * Guards the handoff between the engine side and mixCallback(). It is
+	 * only ever held for a few instructions, without calling into streams
+	 * or allocating memory.
+	 */
+	Common::Mutex _handoffMutex;
+
 	const uint _sampleRate;
 	bool _mixerReady;
 	uint32 _handleSeed;
 
+	/** The snapshot mixCallback() picks up next. Guarded by _handoffMutex. */
+	ChannelSnapshot *_publishedChannels;
+	/** Generation of the snapshot being mixed, 0 if no mix is in progress. Guarded by _handoffMutex. */
+	uint32 _mixGeneration;
+	/** Set by mixCallback() when a channel ran out of data. Guarded by _handoffMutex. */
+	bool _channelsFinished;
+
+	/** Generation of the last published snapshot. Guarded by _mutex. */
+	uint32 _generation;
+	/** Set when the channel table changed since the last snapshot. Guarded by _mutex. */
+	bool _channelsChanged;
+	/** Replaced snapshots which might still be used by mixCallback(). Guarded by _mutex. */
+	Common::Array<ChannelSnapshot *> _oldSnapshots;
+
+	uint _activeChannels;
+	ChannelStats _stats;
+
+	/** Size of the decode-ahead ring buffers in sample pairs, 0 if disabled. */
+	uint _decodeAheadFrames;
+
+	/** Quality of the rate converters of new channels. Guarded by _mutex. */
+	int _resamplingQuality;
+
 	struct SoundTypeSettings {
 		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
 
@@ -69,7 +164,12 @@ private:
 	};
 
 	SoundTypeSettings _soundTypeSettings[4];
-	Channel *_channels[NUM_CHANNELS];
+
+	/** The channel table, indexed by the lower bits of a SoundHandle. */
+	Common::Array<Channel *> _channels;
+
+	/** Stopped channels which are still referenced by a snapshot or a decode pass. */
+	Common::Array<Channel *> _retiredChannels;
 
 
 public:
@@ -115,11 +215,52 @@ public:
 	virtual void setVolumeForSoundType(SoundType type, int volume);
 	virtual int getVolumeForSoundType(SoundType type) const;
 
+	virtual void setResamplingQuality(int quality);
+
 	virtual uint getOutputRate() const;
 
+	/**
+	 * Returns statistics about the usage of the channel table.
+	 */
+	const ChannelStats &getChannelStats() const { return _stats; }
+
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
 
+	/**
+	 * Looks up the channel belonging to the given handle. Must be called
+	 * with _mutex held.
+	 *
+	 * @return the channel, or 0 if the sound already terminated
+	 */
+	Channel *findChannel(SoundHandle handle) const;
+
+	/**
+	 * Queries whether a channel with the given id is playing. Must be
+	 * called with _mutex held.
+	 */
+	bool hasChannelWithId(int id) const;
+
+	/**
+	 * Stops the channel in the given slot and frees the slot. Must be
+	 * called with _mutex held.
+	 */
+	void removeChannel(uint index);
+
+	/**
+	 * Hands a snapshot of the channel table over to mixCallback() if the
+	 * table changed, and deletes the retired channels and snapshots which
+	 * are not used anymore. Must be called with _mutex held.
+	 */
+	void commitChannels();
+
+	/**
+	 * To be called at the start of each engine call, with _mutex held.
+	 * Accounts for the call in the channel statistics, and removes the
+	 * channels which mixCallback() found to be finished.
+	 */
+	void beginEngineCall();
+
 public:
 	/**
 	 * The mixer callback function, to be called at regular intervals by
@@ -138,6 +279,25 @@ public:
 	 * their audio system has been completed.
 	 */
 	void setReady(bool ready);
+
+	/**
+	 * Enables decoding ahead of the channels. Channels started afterwards
+	 * get a ring buffer of the given size, which has to be filled by
+	 * calling decodeAhead() from one or more worker threads.
+	 *
+	 * @param frames size of the ring buffers in sample pairs, 0 to disable
+	 */
+	void setDecodeAhead(uint frames) { _decodeAheadFrames = frames; }
+
+	/**
+	 * Decodes and rate converts samples for one channel whose ring buffer
+	 * is running low. Meant to be called repeatedly by the worker threads
+	 * of the backend; several threads can do so at the same time, each
+	 * working on a different channel.
+	 *
+	 * @return true if a channel was processed, false if there was nothing to do
+	 */
+	bool decodeAhead();
 };
 
 
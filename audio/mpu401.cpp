@@ -89,6 +89,7 @@ const char *MidiDriver::getErrorName(int error_code) {
 MidiDriver_MPU401::MidiDriver_MPU401() :
 	MidiDriver(),
 	_timer_proc(0),
+	_timer_handle(0),
 	_channel_mask(0xFFFF) // Permit all 16 channels by default
 {
 
@@ -103,8 +104,9 @@ MidiDriver_MPU401::~MidiDriver_MPU401() {
 
 void MidiDriver_MPU401::close() {
 	if (_timer_proc) {
-		g_system->getTimerManager()->removeTimerProc(_timer_proc);
+		g_system->getTimerManager()->removeTimerHandle(_timer_handle);
 		_timer_proc = 0;
+		_timer_handle = 0;
 	}
 	if (isOpen()) {
 		for (int i = 0; i < 16; ++i)
@@ -139,10 +141,13 @@ MidiChannel *MidiDriver_MPU401::allocateChannel() {
 
 void MidiDriver_MPU401::setTimerCallback(void *timer_param, Common::TimerManager::TimerProc timer_proc) {
 	if (!_timer_proc || !timer_proc) {
+		// Only remove our own instance of the callback, other drivers might
+		// use the same one.
 		if (_timer_proc)
-			g_system->getTimerManager()->removeTimerProc(_timer_proc);
+			g_system->getTimerManager()->removeTimerHandle(_timer_handle);
 		_timer_proc = timer_proc;
+		_timer_handle = 0;
 		if (timer_proc)
-			g_system->getTimerManager()->installTimerProc(timer_proc, 10000, timer_param);
+			g_system->getTimerManager()->installTimerProc(timer_proc, 10000, timer_param, &_timer_handle);
 	}
 }
@@ -69,6 +69,7 @@ class MidiDriver_MPU401 : public MidiDriver {
 private:
 	MidiChannel_MPU401 _midi_channels[16];
 	Common::TimerManager::TimerProc _timer_proc;
+	Common::TimerManager::TimerHandle _timer_handle;
 	uint16 _channel_mask;
 
 public:
@@ -30,6 +30,8 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/rate_sinc.h"
+#include "audio/rate_kernels.h"
 #include "audio/mixer.h"
 #include "common/frac.h"
 #include "common/textconsole.h"
@@ -67,6 +69,13 @@ protected:
 	/** fractional position increment in the output stream */
 	long opos_inc;
 
+	/** resampled frames, waiting to be mixed into the output buffer */
+	st_sample_t frameBuf[INTERMEDIATE_BUFFER_SIZE];
+
+	const MixKernels &_kernels;
+
+	st_size_t fillFrames(AudioStream &input, st_size_t count);
+
 public:
 	SimpleRateConverter(st_rate_t inrate, st_rate_t outrate);
 	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
@@ -80,7 +89,8 @@ public:
  * Prepare processing.
  */
 template<bool stereo, bool reverseStereo>
-SimpleRateConverter<stereo, reverseStereo>::SimpleRateConverter(st_rate_t inrate, st_rate_t outrate) {
+SimpleRateConverter<stereo, reverseStereo>::SimpleRateConverter(st_rate_t inrate, st_rate_t outrate)
+	: _kernels(getBestMixKernels()) {
 	if ((inrate % outrate) != 0) {
 		error("Input rate must be a multiple of output rate to use rate effect");
 	}
@@ -98,17 +108,14 @@ SimpleRateConverter<stereo, reverseStereo>::SimpleRateConverter(st_rate_t inrate
 }
 
 /*
- * Processed signed long samples from ibuf to obuf.
- * Return number of sample pairs processed.
+ * Resamples up to count frames from the input into frameBuf.
+ * Return number of frames stored, which is less than count at the end of the input.
  */
 template<bool stereo, bool reverseStereo>
-int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
+st_size_t SimpleRateConverter<stereo, reverseStereo>::fillFrames(AudioStream &input, st_size_t count) {
+	st_sample_t *frame = frameBuf;
 
-	ostart = obuf;
-	oend = obuf + osamp * 2;
-
-	while (obuf < oend) {
+	for (st_size_t i = 0; i < count; ++i) {
 
 		// read enough input samples so that opos >= 0
 		do {
@@ -117,7 +124,7 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 				inPtr = inBuf;
 				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
 				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+					return i;
 			}
 			inLen -= (stereo ? 2 : 1);
 			opos--;
@@ -133,13 +140,29 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 		// Increment output position
 		opos += opos_inc;
 
-		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+		frame = storeFrame<stereo, reverseStereo>(frame, out0, out1);
+	}
+	return count;
+}
 
-		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+/*
+ * Processed signed long samples from ibuf to obuf.
+ * Return number of sample pairs processed.
+ */
+template<bool stereo, bool reverseStereo>
+int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	st_sample_t *ostart = obuf;
 
-		obuf += 2;
+	while (osamp > 0) {
+		const st_size_t count = MIN<st_size_t>(osamp, ARRAYSIZE(frameBuf) / (stereo ? 2 : 1));
+		const st_size_t filled = fillFrames(input, count);
+
+		mixFrames<stereo, reverseStereo>(_kernels, obuf, frameBuf, filled, vol_l, vol_r);
+		obuf += filled * 2;
+		osamp -= filled;
+
+		if (filled < count)
+			break;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -173,6 +196,13 @@ protected:
 	/** current sample(s) in the input stream (left/right channel) */
 	st_sample_t icur0, icur1;
 
+	/** interpolated frames, waiting to be mixed into the output buffer */
+	st_sample_t frameBuf[INTERMEDIATE_BUFFER_SIZE];
+
+	const MixKernels &_kernels;
+
+	st_size_t fillFrames(AudioStream &input, st_size_t count);
+
 public:
 	LinearRateConverter(st_rate_t inrate, st_rate_t outrate);
 	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
@@ -186,7 +216,8 @@ public:
  * Prepare processing.
  */
 template<bool stereo, bool reverseStereo>
-LinearRateConverter<stereo, reverseStereo>::LinearRateConverter(st_rate_t inrate, st_rate_t outrate) {
+LinearRateConverter<stereo, reverseStereo>::LinearRateConverter(st_rate_t inrate, st_rate_t outrate)
+	: _kernels(getBestMixKernels()) {
 	if (inrate >= 65536 || outrate >= 65536) {
 		error("rate effect can only handle rates < 65536");
 	}
@@ -207,17 +238,15 @@ LinearRateConverter<stereo, reverseStereo>::LinearRateConverter(st_rate_t inrate
 }
 
 /*
- * Processed signed long samples from ibuf to obuf.
- * Return number of sample pairs processed.
+ * Interpolates up to count frames from the input into frameBuf.
+ * Return number of frames stored, which is less than count at the end of the input.
  */
 template<bool stereo, bool reverseStereo>
-int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
+st_size_t LinearRateConverter<stereo, reverseStereo>::fillFrames(AudioStream &input, st_size_t count) {
+	st_sample_t *frame = frameBuf;
+	st_size_t i = 0;
 
-	ostart = obuf;
-	oend = obuf + osamp * 2;
-
-	while (obuf < oend) {
+	while (i < count) {
 
 		// read enough input samples so that opos < 0
 		while ((frac_t)FRAC_ONE <= opos) {
@@ -226,7 +255,7 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 				inPtr = inBuf;
 				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
 				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+					return i;
 			}
 			inLen -= (stereo ? 2 : 1);
 			ilast0 = icur0;
@@ -239,8 +268,8 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 		}
 
 		// Loop as long as the outpos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (opos < (frac_t)FRAC_ONE && obuf < oend) {
+		// still space in the frame buffer.
+		while (opos < (frac_t)FRAC_ONE && i < count) {
 			// interpolate
 			st_sample_t out0, out1;
 			out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF) >> FRAC_BITS));
@@ -248,18 +277,35 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 						  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF) >> FRAC_BITS)) :
 						  out0);
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
+			frame = storeFrame<stereo, reverseStereo>(frame, out0, out1);
+			i++;
 
 			// Increment output position
 			opos += opos_inc;
 		}
 	}
+	return count;
+}
+
+/*
+ * Processed signed long samples from ibuf to obuf.
+ * Return number of sample pairs processed.
+ */
+template<bool stereo, bool reverseStereo>
+int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	st_sample_t *ostart = obuf;
+
+	while (osamp > 0) {
+		const st_size_t count = MIN<st_size_t>(osamp, ARRAYSIZE(frameBuf) / (stereo ? 2 : 1));
+		const st_size_t filled = fillFrames(input, count);
+
+		mixFrames<stereo, reverseStereo>(_kernels, obuf, frameBuf, filled, vol_l, vol_r);
+		obuf += filled * 2;
+		osamp -= filled;
+
+		if (filled < count)
+			break;
+	}
 	return (obuf - ostart) / 2;
 }
 
@@ -274,8 +320,9 @@ template<bool stereo, bool reverseStereo>
 class CopyRateConverter : public RateConverter {
 	st_sample_t *_buffer;
 	st_size_t _bufferSize;
+	const MixKernels &_kernels;
 public:
-	CopyRateConverter() : _buffer(0), _bufferSize(0) {}
+	CopyRateConverter() : _buffer(0), _bufferSize(0), _kernels(getBestMixKernels()) {}
 	~CopyRateConverter() {
 		free(_buffer);
 	}
@@ -283,11 +330,8 @@ public:
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
 		assert(input.isStereo() == stereo);
 
-		st_sample_t *ptr;
 		st_size_t len;
 
-		st_sample_t *ostart = obuf;
-
 		if (stereo)
 			osamp *= 2;
 
@@ -301,22 +345,18 @@ public:
 		// Read up to 'osamp' samples into our temporary buffer
 		len = input.readBuffer(_buffer, osamp);
 
-		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
+		const st_size_t frames = len / (stereo ? 2 : 1);
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
-
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
+		// The mixing kernels expect the channels of reversed stereo frames
+		// to be swapped already
+		if (stereo && reverseStereo) {
+			for (st_size_t i = 0; i < frames; ++i)
+				SWAP(_buffer[2 * i], _buffer[2 * i + 1]);
 		}
-		return (obuf - ostart) / 2;
+
+		// Mix the data into the output buffer
+		mixFrames<stereo, reverseStereo>(_kernels, obuf, _buffer, frames, vol_l, vol_r);
+		return frames;
 	}
 
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
@@ -343,7 +383,10 @@ RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
 /**
  * Create and return a RateConverter object for the specified input and output rates.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
+	if (inrate != outrate && quality != kRateQualityFast)
+		return makeSincRateConverter(inrate, outrate, stereo, reverseStereo, quality);
+
 	if (stereo) {
 		if (reverseStereo)
 			return makeRateConverter<true, true>(inrate, outrate);
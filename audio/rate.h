@@ -78,7 +78,20 @@ public:
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
+/**
+ * Quality levels of the sample rate conversion, as selected by the
+ * "resampling_quality" config key.
+ */
+enum RateConverterQuality {
+	/** Nearest neighbour resp. linear interpolation */
+	kRateQualityFast = 0,
+	/** Windowed sinc filters of increasing length */
+	kRateQualityLow = 1,
+	kRateQualityMedium = 2,
+	kRateQualityHigh = 3
+};
+
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false, RateConverterQuality quality = kRateQualityFast);
 
 } // End of namespace Audio
 
@@ -43,6 +43,7 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/rate_sinc.h"
 #include "audio/mixer.h"
 #include "common/util.h"
 #include "common/textconsole.h"
@@ -436,7 +437,10 @@ public:
 /**
  * Create and return a RateConverter object for the specified input and output rates.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
+	if (inrate != outrate && quality != kRateQualityFast)
+		return makeSincRateConverter(inrate, outrate, stereo, reverseStereo, quality);
+
 	if (inrate != outrate) {
 		if ((inrate % outrate) == 0) {
 			if (stereo) {
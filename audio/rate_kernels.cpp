@@ -0,0 +1,328 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/rate_kernels.h"
+#include "audio/mixer.h"
+#include "common/cpudetect.h"
+#include "common/util.h"
+
+// The SIMD kernels rely on signed saturating arithmetic, so they can not be
+// used when the output is unsigned.
+#ifndef OUTPUT_UNSIGNED_AUDIO
+#ifdef SCUMMVM_SSE2
+#define RATE_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef SCUMMVM_AVX2
+#define RATE_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+#ifdef SCUMMVM_NEON
+#define RATE_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace Audio {
+
+#pragma mark -
+#pragma mark --- Scalar kernels ---
+#pragma mark -
+
+static void mixStereoScalar(st_sample_t *obuf, const st_sample_t *frames, st_size_t count, st_volume_t vol_l, st_volume_t vol_r) {
+	for (; count > 0; --count) {
+		clampedAdd(obuf[0], (frames[0] * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+		clampedAdd(obuf[1], (frames[1] * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+		frames += 2;
+		obuf += 2;
+	}
+}
+
+static void mixMonoScalar(st_sample_t *obuf, const st_sample_t *frames, st_size_t count, st_volume_t vol_l, st_volume_t vol_r) {
+	for (; count > 0; --count) {
+		clampedAdd(obuf[0], (*frames * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+		clampedAdd(obuf[1], (*frames * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+		frames++;
+		obuf += 2;
+	}
+}
+
+static int32 dotProductScalar(const int16 *a, const int16 *b, uint len) {
+	int32 sum = 0;
+	for (uint i = 0; i < len; ++i)
+		sum += a[i] * b[i];
+	return sum;
+}
+
+// All SIMD kernels below compute the same as the scalar ones: the 32 bit
+// product of sample and volume is divided by kMaxMixerVolume (256) with
+// rounding towards zero, which is done by adding 255 to negative products
+// before the arithmetic shift. The result always fits into 16 bits, so the
+// final accumulation is a plain saturating 16 bit add.
+
+#ifdef RATE_KERNELS_SSE2
+
+#pragma mark -
+#pragma mark --- SSE2 kernels ---
+#pragma mark -
+
+static inline __m128i scaleSSE2(__m128i samples, __m128i vol) {
+	const __m128i lo = _mm_mullo_epi16(samples, vol);
+	const __m128i hi = _mm_mulhi_epi16(samples, vol);
+	const __m128i round = _mm_set1_epi32(Audio::Mixer::kMaxMixerVolume - 1);
+
+	__m128i p0 = _mm_unpacklo_epi16(lo, hi);
+	__m128i p1 = _mm_unpackhi_epi16(lo, hi);
+	p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), round)), 8);
+	p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), round)), 8);
+
+	return _mm_packs_epi32(p0, p1);
+}
+
+static inline void accumulateSSE2(st_sample_t *obuf, __m128i samples, __m128i vol) {
+	__m128i *out = (__m128i *)obuf;
+	_mm_storeu_si128(out, _mm_adds_epi16(_mm_loadu_si128(out), scaleSSE2(samples, vol)));
+}
+
+static void mixStereoSSE2(st_sample_t *obuf, const st_sample_t *frames, st_size_t count, st_volume_t vol_l, st_volume_t vol_r) {
+	const __m128i vol = _mm_setr_epi16(vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r);
+
+	for (; count >= 4; count -= 4) {
+		accumulateSSE2(obuf, _mm_loadu_si128((const __m128i *)frames), vol);
+		frames += 8;
+		obuf += 8;
+	}
+
+	mixStereoScalar(obuf, frames, count, vol_l, vol_r);
+}
+
+static void mixMonoSSE2(st_sample_t *obuf, const st_sample_t *frames, st_size_t count, st_volume_t vol_l, st_volume_t vol_r) {
+	const __m128i vol = _mm_setr_epi16(vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r);
+
+	for (; count >= 8; count -= 8) {
+		const __m128i samples = _mm_loadu_si128((const __m128i *)frames);
+		accumulateSSE2(obuf, _mm_unpacklo_epi16(samples, samples), vol);
+		accumulateSSE2(obuf + 8, _mm_unpackhi_epi16(samples, samples), vol);
+		frames += 8;
+		obuf += 16;
+	}
+
+	mixMonoScalar(obuf, frames, count, vol_l, vol_r);
+}
+
+static int32 dotProductSSE2(const int16 *a, const int16 *b, uint len) {
+	__m128i sum = _mm_setzero_si128();
+
+	for (uint i = 0; i < len; i += 8)
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i))));
+
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum);
+}
+
+#endif
+
+#ifdef RATE_KERNELS_AVX2
+
+#pragma mark -
+#pragma mark --- AVX2 kernels ---
+#pragma mark -
+
+// The 256 bit unpack and pack instructions operate on each 128 bit lane
+// separately, which cancels out here, so the samples stay in order.
+static inline SCUMMVM_TARGET_AVX2 void accumulateAVX2(st_sample_t *obuf, __m256i samples, __m256i vol) {
+	const __m256i lo = _mm256_mullo_epi16(samples, vol);
+	const __m256i hi = _mm256_mulhi_epi16(samples, vol);
+	const __m256i round = _mm256_set1_epi32(Audio::Mixer::kMaxMixerVolume - 1);
+
+	__m256i p0 = _mm256_unpacklo_epi16(lo, hi);
+	__m256i p1 = _mm256_unpackhi_epi16(lo, hi);
+	p0 = _mm256_srai_epi32(_mm256_add_epi32(p0, _mm256_and_si256(_mm256_srai_epi32(p0, 31), round)), 8);
+	p1 = _mm256_srai_epi32(_mm256_add_epi32(p1, _mm256_and_si256(_mm256_srai_epi32(p1, 31), round)), 8);
+
+	__m256i *out = (__m256i *)obuf;
+	_mm256_storeu_si256(out, _mm256_adds_epi16(_mm256_loadu_si256(out), _mm256_packs_epi32(p0, p1)));
+}
+
+static SCUMMVM_TARGET_AVX2 void mixStereoAVX2(st_sample_t *obuf, const st_sample_t *frames, st_size_t count, st_volume_t vol_l, st_volume_t vol_r) {
+	const __m256i vol = _mm256_set1_epi32((vol_r << 16) | vol_l);
+
+	for (; count >= 8; count -= 8) {
+		accumulateAVX2(obuf, _mm256_loadu_si256((const __m256i *)frames), vol);
+		frames += 16;
+		obuf += 16;
+	}
+
+	mixStereoScalar(obuf, frames, count, vol_l, vol_r);
+}
+
+static SCUMMVM_TARGET_AVX2 void mixMonoAVX2(st_sample_t *obuf, const st_sample_t *frames, st_size_t count, st_volume_t vol_l, st_volume_t vol_r) {
+	const __m256i vol = _mm256_set1_epi32((vol_r << 16) | vol_l);
+
+	for (; count >= 8; count -= 8) {
+		const __m128i samples = _mm_loadu_si128((const __m128i *)frames);
+		const __m256i stereo = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(samples, samples)),
+		                                               _mm_unpackhi_epi16(samples, samples), 1);
+		accumulateAVX2(obuf, stereo, vol);
+		frames += 8;
+		obuf += 16;
+	}
+
+	mixMonoScalar(obuf, frames, count, vol_l, vol_r);
+}
+
+static SCUMMVM_TARGET_AVX2 int32 dotProductAVX2(const int16 *a, const int16 *b, uint len) {
+	__m256i sum256 = _mm256_setzero_si256();
+
+	uint i = 0;
+	for (; i + 16 <= len; i += 16)
+		sum256 = _mm256_add_epi32(sum256, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(a + i)), _mm256_loadu_si256((const __m256i *)(b + i))));
+
+	__m128i sum = _mm_add_epi32(_mm256_castsi256_si128(sum256), _mm256_extracti128_si256(sum256, 1));
+	if (i < len)
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i))));
+
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum);
+}
+
+#endif
+
+#ifdef RATE_KERNELS_NEON
+
+#pragma mark -
+#pragma mark --- NEON kernels ---
+#pragma mark -
+
+static inline int32x4_t divideNEON(int32x4_t p) {
+	// The arithmetic shift yields 0 or -1, the logical shift turns the
+	// latter into 255.
+	const int32x4_t round = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(p, 31)), 24));
+	return vshrq_n_s32(vaddq_s32(p, round), 8);
+}
+
+static inline void accumulateNEON(st_sample_t *obuf, int16x8_t samples, int16x8_t vol) {
+	const int32x4_t p0 = divideNEON(vmull_s16(vget_low_s16(samples), vget_low_s16(vol)));
+	const int32x4_t p1 = divideNEON(vmull_s16(vget_high_s16(samples), vget_high_s16(vol)));
+
+	vst1q_s16(obuf, vqaddq_s16(vld1q_s16(obuf), vcombine_s16(vmovn_s32(p0), vmovn_s32(p1))));
+}
+
+static void mixStereoNEON(st_sample_t *obuf, const st_sample_t *frames, st_size_t count, st_volume_t vol_l, st_volume_t vol_r) {
+	const int16 volumes[8] = { vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r };
+	const int16x8_t vol = vld1q_s16(volumes);
+
+	for (; count >= 4; count -= 4) {
+		accumulateNEON(obuf, vld1q_s16(frames), vol);
+		frames += 8;
+		obuf += 8;
+	}
+
+	mixStereoScalar(obuf, frames, count, vol_l, vol_r);
+}
+
+static void mixMonoNEON(st_sample_t *obuf, const st_sample_t *frames, st_size_t count, st_volume_t vol_l, st_volume_t vol_r) {
+	const int16 volumes[8] = { vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r };
+	const int16x8_t vol = vld1q_s16(volumes);
+
+	for (; count >= 8; count -= 8) {
+		const int16x8_t samples = vld1q_s16(frames);
+		const int16x8x2_t stereo = vzipq_s16(samples, samples);
+		accumulateNEON(obuf, stereo.val[0], vol);
+		accumulateNEON(obuf + 8, stereo.val[1], vol);
+		frames += 8;
+		obuf += 16;
+	}
+
+	mixMonoScalar(obuf, frames, count, vol_l, vol_r);
+}
+
+static int32 dotProductNEON(const int16 *a, const int16 *b, uint len) {
+	int32x4_t sum = vdupq_n_s32(0);
+
+	for (uint i = 0; i < len; i += 8) {
+		const int16x8_t va = vld1q_s16(a + i);
+		const int16x8_t vb = vld1q_s16(b + i);
+		sum = vmlal_s16(sum, vget_low_s16(va), vget_low_s16(vb));
+		sum = vmlal_s16(sum, vget_high_s16(va), vget_high_s16(vb));
+	}
+
+	const int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+	return vget_lane_s32(vpadd_s32(pair, pair), 0);
+}
+
+#endif
+
+#pragma mark -
+
+static const MixKernels s_mixKernels[kMixKernelCount] = {
+	{ "scalar", mixStereoScalar, mixMonoScalar, dotProductScalar },
+#ifdef RATE_KERNELS_SSE2
+	{ "SSE2", mixStereoSSE2, mixMonoSSE2, dotProductSSE2 },
+#else
+	{ "SSE2", 0, 0, 0 },
+#endif
+#ifdef RATE_KERNELS_AVX2
+	{ "AVX2", mixStereoAVX2, mixMonoAVX2, dotProductAVX2 },
+#else
+	{ "AVX2", 0, 0, 0 },
+#endif
+#ifdef RATE_KERNELS_NEON
+	{ "NEON", mixStereoNEON, mixMonoNEON, dotProductNEON }
+#else
+	{ "NEON", 0, 0, 0 }
+#endif
+};
+
+const MixKernels *getMixKernels(MixKernelType type) {
+	assert(type >= 0 && type < kMixKernelCount);
+
+	if (!s_mixKernels[type].mixStereo)
+		return 0;
+
+	switch (type) {
+	case kMixKernelSSE2:
+		return Common::hasCPUFeature(Common::kCPUFeatureSSE2) ? &s_mixKernels[type] : 0;
+	case kMixKernelAVX2:
+		return Common::hasCPUFeature(Common::kCPUFeatureAVX2) ? &s_mixKernels[type] : 0;
+	case kMixKernelNEON:
+		return Common::hasCPUFeature(Common::kCPUFeatureNEON) ? &s_mixKernels[type] : 0;
+	default:
+		return &s_mixKernels[type];
+	}
+}
+
+const MixKernels &getBestMixKernels() {
+	static const MixKernelType preferred[] = { kMixKernelAVX2, kMixKernelSSE2, kMixKernelNEON };
+
+	for (int i = 0; i < ARRAYSIZE(preferred); ++i) {
+		const MixKernels *kernels = getMixKernels(preferred[i]);
+		if (kernels)
+			return *kernels;
+	}
+
+	return s_mixKernels[kMixKernelScalar];
+}
+
+} // End of namespace Audio
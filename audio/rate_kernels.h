@@ -0,0 +1,128 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef SOUND_RATE_KERNELS_H
+#define SOUND_RATE_KERNELS_H
+
+#include "audio/rate.h"
+
+namespace Audio {
+
+/**
+ * Scales the given sample frames by the channel volumes and adds them with
+ * saturation to the interleaved stereo output buffer, i.e. for every frame
+ * it does the same as:
+ *
+ *   clampedAdd(obuf[0], (left  * (int)vol_l) / Mixer::kMaxMixerVolume);
+ *   clampedAdd(obuf[1], (right * (int)vol_r) / Mixer::kMaxMixerVolume);
+ *
+ * For mono input the single sample of a frame is used for both channels.
+ *
+ * @param obuf   interleaved stereo output buffer
+ * @param frames input frames (interleaved stereo, resp. mono samples)
+ * @param count  number of frames to mix
+ * @param vol_l  volume of the left channel
+ * @param vol_r  volume of the right channel
+ */
+typedef void (*MixFramesProc)(st_sample_t *obuf, const st_sample_t *frames, st_size_t count, st_volume_t vol_l, st_volume_t vol_r);
+
+/**
+ * Computes the dot product of two sample vectors, as used by the FIR
+ * filters of the resamplers.
+ *
+ * @param a   first vector
+ * @param b   second vector
+ * @param len number of elements, must be a multiple of 8
+ * @return the 32 bit sum of the products
+ */
+typedef int32 (*DotProductProc)(const int16 *a, const int16 *b, uint len);
+
+/**
+ * A set of mixing kernels for one instruction set.
+ */
+struct MixKernels {
+	const char *name;
+	MixFramesProc mixStereo;
+	MixFramesProc mixMono;
+	DotProductProc dotProduct;
+};
+
+enum MixKernelType {
+	kMixKernelScalar,
+	kMixKernelSSE2,
+	kMixKernelAVX2,
+	kMixKernelNEON,
+
+	kMixKernelCount
+};
+
+/**
+ * Returns the kernels for the given instruction set, or 0 if they are not
+ * compiled in or not supported by the host CPU.
+ */
+const MixKernels *getMixKernels(MixKernelType type);
+
+/**
+ * Returns the fastest set of kernels supported by the host CPU.
+ */
+const MixKernels &getBestMixKernels();
+
+/**
+ * Mixes resampled frames into the output buffer, using the given kernels.
+ * For reversed stereo the frames are expected to be stored with swapped
+ * channels already (see storeFrame()), so only the volumes need to be
+ * swapped here.
+ */
+template<bool stereo, bool reverseStereo>
+inline void mixFrames(const MixKernels &kernels, st_sample_t *obuf, const st_sample_t *frames, st_size_t count, st_volume_t vol_l, st_volume_t vol_r) {
+	if (reverseStereo) {
+		const st_volume_t tmp = vol_l;
+		vol_l = vol_r;
+		vol_r = tmp;
+	}
+
+	if (stereo)
+		kernels.mixStereo(obuf, frames, count, vol_l, vol_r);
+	else
+		kernels.mixMono(obuf, frames, count, vol_l, vol_r);
+}
+
+/**
+ * Stores a resampled frame in an intermediate frame buffer.
+ *
+ * @return the position of the next frame in the buffer
+ */
+template<bool stereo, bool reverseStereo>
+inline st_sample_t *storeFrame(st_sample_t *frame, st_sample_t out0, st_sample_t out1) {
+	if (stereo) {
+		frame[0] = reverseStereo ? out1 : out0;
+		frame[1] = reverseStereo ? out0 : out1;
+		return frame + 2;
+	} else {
+		frame[0] = out0;
+		return frame + 1;
+	}
+}
+
+} // End of namespace Audio
+
+#endif
@@ -0,0 +1,434 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/audiostream.h"
+#include "audio/rate_sinc.h"
+#include "audio/rate_kernels.h"
+#include "common/algorithm.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+#include <math.h>
+
+namespace Audio {
+
+/**
+ * Cache of the filter coefficient tables. All converters with the same
+ * number of phases, taps and cut off frequency share one table, so that
+ * playing many sounds at the same rates computes it only once. A few
+ * tables which are not used anymore are kept around, since sounds are
+ * typically started over and over at the same rates.
+ */
+class SincTableManager : public Common::Singleton<SincTableManager> {
+public:
+	enum {
+		/** Precision of the filter coefficients */
+		COEF_BITS = 14
+	};
+
+	/**
+	 * Returns the table for the given parameters, consisting of phases rows
+	 * of taps coefficients. It has to be handed back with release().
+	 */
+	const int16 *acquire(uint phases, uint taps, double cutoff);
+	void release(const int16 *coefs);
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	SincTableManager();
+	~SincTableManager();
+
+	enum {
+		/** Maximal number of unused tables kept in the cache */
+		MAX_UNUSED_TABLES = 8
+	};
+
+	struct Table {
+		uint phases, taps;
+		double cutoff;
+		int16 *coefs;
+		uint refCount;
+	};
+
+	typedef Common::List<Table> TableList;
+
+	/**
+	 * Locks the table list for the lifetime of the object. Without an
+	 * OSystem, as in the unit tests, there are no other threads and thus
+	 * no mutex either.
+	 */
+	class TableLock {
+	public:
+		TableLock(Common::MutexRef mutex) : _mutex(mutex) {
+			if (_mutex)
+				g_system->lockMutex(_mutex);
+		}
+		~TableLock() {
+			if (_mutex)
+				g_system->unlockMutex(_mutex);
+		}
+
+	private:
+		Common::MutexRef _mutex;
+	};
+
+	static void computeCoefficients(int16 *coefs, uint phases, uint taps, double cutoff);
+
+	/** Guards _tables, since converters are created from any thread */
+	Common::MutexRef _mutex;
+	TableList _tables;
+};
+
+SincTableManager::SincTableManager() {
+	_mutex = g_system ? g_system->createMutex() : 0;
+}
+
+SincTableManager::~SincTableManager() {
+	for (TableList::iterator i = _tables.begin(); i != _tables.end(); ++i)
+		delete[] i->coefs;
+	if (_mutex)
+		g_system->deleteMutex(_mutex);
+}
+
+const int16 *SincTableManager::acquire(uint phases, uint taps, double cutoff) {
+	TableLock lock(_mutex);
+
+	for (TableList::iterator i = _tables.begin(); i != _tables.end(); ++i) {
+		if (i->phases == phases && i->taps == taps && i->cutoff == cutoff) {
+			i->refCount++;
+			return i->coefs;
+		}
+	}
+
+	Table table;
+	table.phases = phases;
+	table.taps = taps;
+	table.cutoff = cutoff;
+	table.coefs = new int16[phases * taps];
+	table.refCount = 1;
+	computeCoefficients(table.coefs, phases, taps, cutoff);
+
+	_tables.push_back(table);
+	return table.coefs;
+}
+
+void SincTableManager::release(const int16 *coefs) {
+	TableLock lock(_mutex);
+
+	uint unused = 0;
+	for (TableList::iterator i = _tables.begin(); i != _tables.end(); ++i) {
+		if (i->coefs == coefs) {
+			assert(i->refCount > 0);
+			i->refCount--;
+		}
+		if (i->refCount == 0)
+			unused++;
+	}
+
+	// Drop the oldest unused tables
+	for (TableList::iterator i = _tables.begin(); unused > MAX_UNUSED_TABLES && i != _tables.end(); ) {
+		if (i->refCount == 0) {
+			delete[] i->coefs;
+			i = _tables.erase(i);
+			unused--;
+		} else {
+			++i;
+		}
+	}
+}
+
+/*
+ * Compute the Blackman-Harris windowed sinc coefficients of all phases.
+ */
+void SincTableManager::computeCoefficients(int16 *coefs, uint phases, uint taps, double cutoff) {
+	const int center = taps / 2 - 1;
+	double *row = new double[taps];
+
+	for (uint phase = 0; phase < phases; ++phase) {
+		const double frac = (double)phase / phases;
+		double sum = 0.0;
+
+		for (uint tap = 0; tap < taps; ++tap) {
+			const double x = (int)tap - center - frac;
+			const double u = x / taps;
+
+			double val = cutoff;
+			if (x != 0.0)
+				val = sin(M_PI * cutoff * x) / (M_PI * x);
+
+			val *= 0.35875 + 0.48829 * cos(2 * M_PI * u) + 0.14128 * cos(4 * M_PI * u) + 0.01168 * cos(6 * M_PI * u);
+
+			row[tap] = val;
+			sum += val;
+		}
+
+		// Normalize to unity gain and make sure the quantized coefficients
+		// add up exactly, so that a constant signal stays constant.
+		int16 *rowCoefs = coefs + phase * taps;
+		int total = 0;
+		uint maxTap = 0;
+		for (uint tap = 0; tap < taps; ++tap) {
+			rowCoefs[tap] = (int16)floor(row[tap] / sum * (1 << COEF_BITS) + 0.5);
+			total += rowCoefs[tap];
+			if (rowCoefs[tap] > rowCoefs[maxTap])
+				maxTap = tap;
+		}
+		rowCoefs[maxTap] += (1 << COEF_BITS) - total;
+	}
+
+	delete[] row;
+}
+
+} // End of namespace Audio
+
+DECLARE_SINGLETON(Audio::SincTableManager);
+
+namespace Audio {
+
+/**
+ * Audio rate converter based on a polyphase windowed sinc filter.
+ *
+ * The conversion ratio is reduced to outrate/inrate = L/M. Each output
+ * sample lies at one of L fractional positions ("phases") between two input
+ * samples, and for each of those a set of FIR coefficients is precomputed
+ * when the converter is created, or taken from SincTableManager if another
+ * converter already uses the same filter. Floating point arithmetic is only used to
+ * compute these tables, the filtering itself is done in 16 bit fixed point
+ * using the dot product kernel of the host CPU.
+ *
+ * If L is bigger than MAX_PHASES, the phases are quantized to MAX_PHASES
+ * steps, which keeps the tables small for odd rates like 22254 Hz.
+ *
+ * Limited to sampling frequency <= 65535 Hz.
+ */
+template<bool stereo, bool reverseStereo>
+class SincRateConverter : public RateConverter {
+protected:
+	enum {
+		/** Maximal number of precomputed phases */
+		MAX_PHASES = 256,
+		/** Precision of the filter coefficients */
+		COEF_BITS = SincTableManager::COEF_BITS,
+		/** Number of input frames read from the stream at once */
+		INPUT_FRAMES = 256
+	};
+
+	/** number of taps per phase, a multiple of 8 */
+	uint _taps;
+	/** number of precomputed phases */
+	uint _phases;
+	/** the reduced conversion ratio */
+	uint32 _phaseCount, _phaseStep;
+	/** current phase, in the range [0, _phaseCount) */
+	uint32 _phase;
+
+	/** _phases rows of _taps filter coefficients, shared with other converters */
+	const int16 *_coefs;
+
+	/**
+	 * Input history of each channel. The filter window for the current
+	 * output sample starts at _histPos.
+	 */
+	int16 *_hist[2];
+	uint _histPos, _histLen, _histSize;
+
+	st_sample_t _inBuf[INPUT_FRAMES * 2];
+
+	/** filtered frames, waiting to be mixed into the output buffer */
+	st_sample_t _frameBuf[INPUT_FRAMES * 2];
+
+	const MixKernels &_kernels;
+
+	bool refill(AudioStream &input);
+	st_size_t fillFrames(AudioStream &input, st_size_t count);
+
+	inline st_sample_t filter(const int16 *hist, const int16 *coefs) const {
+		int32 val = _kernels.dotProduct(hist, coefs, _taps);
+		val = (val + (1 << (COEF_BITS - 1))) >> COEF_BITS;
+		return (st_sample_t)CLIP<int32>(val, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+	}
+
+public:
+	SincRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality);
+	~SincRateConverter();
+
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
+		return ST_SUCCESS;
+	}
+};
+
+
+/*
+ * Prepare processing.
+ */
+template<bool stereo, bool reverseStereo>
+SincRateConverter<stereo, reverseStereo>::SincRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality)
+	: _kernels(getBestMixKernels()) {
+	if (inrate >= 65536 || outrate >= 65536) {
+		error("rate effect can only handle rates < 65536");
+	}
+
+	// Taps per phase and pass band (relative to the Nyquist frequency) of
+	// each quality level
+	static const uint taps[] = { 8, 16, 32 };
+	static const double passBand[] = { 0.80, 0.90, 0.95 };
+	const int level = CLIP<int>(quality, kRateQualityLow, kRateQualityHigh) - kRateQualityLow;
+
+	const uint32 gcd = Common::gcd<uint32>(inrate, outrate);
+	_phaseCount = outrate / gcd;
+	_phaseStep = inrate / gcd;
+	_phase = 0;
+	_phases = MIN<uint>(_phaseCount, MAX_PHASES);
+
+	// When downsampling, the cut off frequency has to be lowered to the
+	// output Nyquist frequency, and the filter widened accordingly to keep
+	// the transition band.
+	double cutoff = passBand[level];
+	_taps = taps[level];
+	if (outrate < inrate) {
+		cutoff = cutoff * outrate / inrate;
+		_taps = MIN<uint>((_taps * inrate + outrate - 1) / outrate, 128);
+		_taps = (_taps + 7) & ~7;
+	}
+
+	_coefs = SincTableManager::instance().acquire(_phases, _taps, cutoff);
+
+	// Prime the history with silence, so that the first input sample is
+	// in the center of the filter window.
+	_histSize = _taps + INPUT_FRAMES;
+	for (int i = 0; i < 2; ++i) {
+		_hist[i] = new int16[_histSize];
+		memset(_hist[i], 0, _histSize * sizeof(int16));
+	}
+	_histPos = 0;
+	_histLen = _taps / 2 - 1;
+}
+
+template<bool stereo, bool reverseStereo>
+SincRateConverter<stereo, reverseStereo>::~SincRateConverter() {
+	SincTableManager::instance().release(_coefs);
+	delete[] _hist[0];
+	delete[] _hist[1];
+}
+
+/*
+ * Read more input into the history buffers.
+ * Return false when no input is available right now.
+ */
+template<bool stereo, bool reverseStereo>
+bool SincRateConverter<stereo, reverseStereo>::refill(AudioStream &input) {
+	// Move the remaining window to the start of the history
+	if (_histPos > 0) {
+		for (int i = 0; i < (stereo ? 2 : 1); ++i)
+			memmove(_hist[i], _hist[i] + _histPos, (_histLen - _histPos) * sizeof(int16));
+		_histLen -= _histPos;
+		_histPos = 0;
+	}
+
+	const int frames = MIN<int>(_histSize - _histLen, INPUT_FRAMES);
+	const int len = input.readBuffer(_inBuf, frames * (stereo ? 2 : 1));
+	if (len <= 0)
+		return false;
+
+	const st_sample_t *in = _inBuf;
+	for (int i = 0; i < len / (stereo ? 2 : 1); ++i) {
+		_hist[0][_histLen] = *in++;
+		if (stereo)
+			_hist[1][_histLen] = *in++;
+		_histLen++;
+	}
+
+	return true;
+}
+
+/*
+ * Filters up to count frames from the input into _frameBuf.
+ * Return number of frames stored, which is less than count at the end of the input.
+ */
+template<bool stereo, bool reverseStereo>
+st_size_t SincRateConverter<stereo, reverseStereo>::fillFrames(AudioStream &input, st_size_t count) {
+	st_sample_t *frame = _frameBuf;
+
+	for (st_size_t i = 0; i < count; ++i) {
+		// Make sure the whole filter window is available
+		while (_histPos + _taps > _histLen) {
+			if (!refill(input))
+				return i;
+		}
+
+		const uint phase = (_phases == _phaseCount) ? _phase : (_phase * _phases) / _phaseCount;
+		const int16 *coefs = _coefs + phase * _taps;
+
+		st_sample_t out0, out1;
+		out0 = filter(_hist[0] + _histPos, coefs);
+		out1 = (stereo ? filter(_hist[1] + _histPos, coefs) : out0);
+
+		frame = storeFrame<stereo, reverseStereo>(frame, out0, out1);
+
+		// Increment output position
+		_phase += _phaseStep;
+		while (_phase >= _phaseCount) {
+			_phase -= _phaseCount;
+			_histPos++;
+		}
+	}
+	return count;
+}
+
+/*
+ * Processed signed long samples from ibuf to obuf.
+ * Return number of sample pairs processed.
+ */
+template<bool stereo, bool reverseStereo>
+int SincRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	st_sample_t *ostart = obuf;
+
+	while (osamp > 0) {
+		const st_size_t count = MIN<st_size_t>(osamp, INPUT_FRAMES);
+		const st_size_t filled = fillFrames(input, count);
+
+		mixFrames<stereo, reverseStereo>(_kernels, obuf, _frameBuf, filled, vol_l, vol_r);
+		obuf += filled * 2;
+		osamp -= filled;
+
+		if (filled < count)
+			break;
+	}
+	return (obuf - ostart) / 2;
+}
+
+RateConverter *makeSincRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
+	if (stereo) {
+		if (reverseStereo)
+			return new SincRateConverter<true, true>(inrate, outrate, quality);
+		else
+			return new SincRateConverter<true, false>(inrate, outrate, quality);
+	} else
+		return new SincRateConverter<false, false>(inrate, outrate, quality);
+}
+
+} // End of namespace Audio
@@ -139,6 +139,8 @@ SdlGraphicsManager::SdlGraphicsManager(SdlEventSource *sdlEventSource)
 	_currentShakePos(0), _newShakePos(0),
 	_paletteDirtyStart(0), _paletteDirtyEnd(0),
 	_screenIsLocked(false),
+	_numScalerThreads(0), _scalerMutex(0), _scalerWorkCond(0), _scalerDoneCond(0),
+	_scalerThreadsShouldQuit(false),
 	_graphicsMutex(0),
 #ifdef USE_SDL_DEBUG_FOCUSRECT
 	_enableFocusRectDebugCode(false), _enableFocusRect(false), _focusRect(),
@@ -161,6 +163,9 @@ SdlGraphicsManager::SdlGraphicsManager(SdlEventSource *sdlEventSource)
 
 	memset(&_mouseCurState, 0, sizeof(_mouseCurState));
 
+	memset(&_frameDirtyRectStats, 0, sizeof(_frameDirtyRectStats));
+	memset(&_totalDirtyRectStats, 0, sizeof(_totalDirtyRectStats));
+
 	_graphicsMutex = g_system->createMutex();
 
 #ifdef USE_SDL_DEBUG_FOCUSRECT
@@ -193,6 +198,8 @@ SdlGraphicsManager::SdlGraphicsManager(SdlEventSource *sdlEventSource)
 #else
 	_videoMode.fullscreen = true;
 #endif
+
+	startScalerThreads();
 }
 
 SdlGraphicsManager::~SdlGraphicsManager() {
@@ -200,6 +207,8 @@ SdlGraphicsManager::~SdlGraphicsManager() {
 	if (g_system->getEventManager()->getEventDispatcher() != NULL)
 		g_system->getEventManager()->getEventDispatcher()->unregisterObserver(this);
 
+	stopScalerThreads();
+
 	unloadGFXMode();
 	if (_mouseSurface)
 		SDL_FreeSurface(_mouseSurface);
@@ -212,6 +221,146 @@ SdlGraphicsManager::~SdlGraphicsManager() {
 	free(_currentPalette);
 	free(_cursorPalette);
 	free(_mouseData);
+
+	if (_totalDirtyRectStats.frames) {
+		debug(2, "SdlGraphicsManager: %d frames redrawn, %d completely, %d dirty rects submitted, %d merged, %d pixels scaled per frame",
+		      _totalDirtyRectStats.frames, _totalDirtyRectStats.forceFull,
+		      _totalDirtyRectStats.submitted, _totalDirtyRectStats.merged,
+		      _totalDirtyRectStats.scaledPixels / _totalDirtyRectStats.frames);
+	}
+}
+
+void SdlGraphicsManager::startScalerThreads() {
+	const int threads = ConfMan.getInt("scaler_threads");
+	if (threads <= 0)
+		return;
+
+	debug(1, "Scaling the screen in %d threads", threads);
+
+	_scalerMutex = SDL_CreateMutex();
+	_scalerWorkCond = SDL_CreateCond();
+	_scalerDoneCond = SDL_CreateCond();
+	_scalerThreadsShouldQuit = false;
+	_numScalerBands = _nextScalerBand = _scalerBandsLeft = 0;
+
+	_numScalerThreads = 0;
+	for (int i = 0; i < MIN<int>(threads, kMaxScalerThreads); ++i) {
+		_scalerThreads[_numScalerThreads] = SDL_CreateThread(scalerThreadEntry, this);
+		if (!_scalerThreads[_numScalerThreads]) {
+			warning("Could not create scaler thread: %s", SDL_GetError());
+			break;
+		}
+		_numScalerThreads++;
+	}
+}
+
+void SdlGraphicsManager::stopScalerThreads() {
+	if (!_scalerMutex)
+		return;
+
+	// Signal the worker threads to end, and wait for them to actually finish.
+	SDL_LockMutex(_scalerMutex);
+	_scalerThreadsShouldQuit = true;
+	SDL_CondBroadcast(_scalerWorkCond);
+	SDL_UnlockMutex(_scalerMutex);
+
+	for (uint i = 0; i < _numScalerThreads; ++i)
+		SDL_WaitThread(_scalerThreads[i], NULL);
+	_numScalerThreads = 0;
+
+	SDL_DestroyMutex(_scalerMutex);
+	SDL_DestroyCond(_scalerWorkCond);
+	SDL_DestroyCond(_scalerDoneCond);
+	_scalerMutex = 0;
+	_scalerWorkCond = 0;
+	_scalerDoneCond = 0;
+}
+
+void SdlGraphicsManager::scalerThread() {
+	SDL_LockMutex(_scalerMutex);
+	while (!_scalerThreadsShouldQuit) {
+		if (!scaleNextBand())
+			SDL_CondWait(_scalerWorkCond, _scalerMutex);
+	}
+	SDL_UnlockMutex(_scalerMutex);
+}
+
+int SDLCALL SdlGraphicsManager::scalerThreadEntry(void *arg) {
+	SdlGraphicsManager *manager = (SdlGraphicsManager *)arg;
+	assert(manager);
+	manager->scalerThread();
+	return 0;
+}
+
+bool SdlGraphicsManager::scaleNextBand() {
+	if (_nextScalerBand >= _numScalerBands)
+		return false;
+
+	const ScalerBand band = _scalerBands[_nextScalerBand++];
+
+	SDL_UnlockMutex(_scalerMutex);
+	_bandScalerProc(band.srcPtr, _bandSrcPitch, band.dstPtr, _bandDstPitch, _bandWidth, band.height);
+	SDL_LockMutex(_scalerMutex);
+
+	if (--_scalerBandsLeft == 0)
+		SDL_CondSignal(_scalerDoneCond);
+	return true;
+}
+
+static bool isScalerThreadSafe(ScalerProc *scalerProc) {
+#if defined(USE_NASM) && defined(USE_HQ_SCALERS)
+	// The assembler versions of the HQ scalers keep their state in global
+	// variables
+	if (scalerProc == HQ2x || scalerProc == HQ3x)
+		return false;
+#endif
+	return true;
+}
+
+void SdlGraphicsManager::runScaler(ScalerProc *scalerProc, int scaleFactor, const uint8 *srcPtr, uint32 srcPitch,
+                                   uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+	if (!_numScalerThreads || height < 2 * kMinScalerBandHeight || !isScalerThreadSafe(scalerProc)) {
+		scalerProc(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+		return;
+	}
+
+	// Split the rect into one band for each thread, including this one
+	const int bands = MIN<int>(_numScalerThreads + 1, height / kMinScalerBandHeight);
+	const int bandHeight = ((height + bands - 1) / bands + 1) & ~1;
+
+	SDL_LockMutex(_scalerMutex);
+
+	_bandScalerProc = scalerProc;
+	_bandSrcPitch = srcPitch;
+	_bandDstPitch = dstPitch;
+	_bandWidth = width;
+
+	_numScalerBands = 0;
+	for (int y = 0; y < height; y += bandHeight) {
+		ScalerBand &band = _scalerBands[_numScalerBands++];
+		band.srcPtr = srcPtr + y * srcPitch;
+		band.dstPtr = dstPtr + y * scaleFactor * dstPitch;
+		band.height = bandHeight;
+
+		// Don't leave a last band of a single row
+		if (height - y < bandHeight + 2) {
+			band.height = height - y;
+			break;
+		}
+	}
+	assert(_numScalerBands <= ARRAYSIZE(_scalerBands));
+
+	_nextScalerBand = 0;
+	_scalerBandsLeft = _numScalerBands;
+	SDL_CondBroadcast(_scalerWorkCond);
+
+	// Help scaling, then wait for the bands the threads are still working on
+	while (scaleNextBand())
+		;
+	while (_scalerBandsLeft > 0)
+		SDL_CondWait(_scalerDoneCond, _scalerMutex);
+
+	SDL_UnlockMutex(_scalerMutex);
 }
 
 void SdlGraphicsManager::initEventObserver() {
@@ -1045,6 +1194,9 @@ void SdlGraphicsManager::internUpdateScreen() {
 		uint32 srcPitch, dstPitch;
 		SDL_Rect *lastRect = _dirtyRectList + _numDirtyRects;
 
+		_frameDirtyRectStats.frames = 1;
+		_frameDirtyRectStats.forceFull = _forceFull ? 1 : 0;
+
 		for (r = _dirtyRectList; r != lastRect; ++r) {
 			dst = *r;
 			dst.x++;	// Shift rect by one since 2xSai needs to access the data around
@@ -1078,8 +1230,10 @@ void SdlGraphicsManager::internUpdateScreen() {
 					dst_y = real2Aspect(dst_y);
 
 				assert(scalerProc != NULL);
-				scalerProc((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
+				runScaler(scalerProc, scale1, (byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
 					(byte *)_hwscreen->pixels + rx1 * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h);
+
+				_frameDirtyRectStats.scaledPixels += r->w * dst_h;
 			}
 
 			r->x = rx1;
@@ -1186,6 +1340,19 @@ void SdlGraphicsManager::internUpdateScreen() {
 		SDL_UpdateRects(_hwscreen, _numDirtyRects, _dirtyRectList);
 	}
 
+	if (_frameDirtyRectStats.frames) {
+		debug(9, "SdlGraphicsManager: %d dirty rects submitted, %d merged, %d pixels scaled%s",
+		      _frameDirtyRectStats.submitted, _frameDirtyRectStats.merged,
+		      _frameDirtyRectStats.scaledPixels, _frameDirtyRectStats.forceFull ? ", full redraw" : "");
+
+		_totalDirtyRectStats.frames++;
+		_totalDirtyRectStats.submitted += _frameDirtyRectStats.submitted;
+		_totalDirtyRectStats.merged += _frameDirtyRectStats.merged;
+		_totalDirtyRectStats.scaledPixels += _frameDirtyRectStats.scaledPixels;
+		_totalDirtyRectStats.forceFull += _frameDirtyRectStats.forceFull;
+	}
+	memset(&_frameDirtyRectStats, 0, sizeof(_frameDirtyRectStats));
+
 	_numDirtyRects = 0;
 	_forceFull = false;
 	_mouseNeedsRedraw = false;
@@ -1323,15 +1490,130 @@ void SdlGraphicsManager::fillScreen(uint32 col) {
 	unlockScreen();
 }
 
-void SdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool realCoordinates) {
-	if (_forceFull)
+static inline int rectArea(const SDL_Rect &r) {
+	return r.w * r.h;
+}
+
+// Checks whether the rects overlap or share an edge
+static inline bool rectsTouch(const SDL_Rect &a, const SDL_Rect &b) {
+	return a.x <= b.x + b.w && b.x <= a.x + a.w &&
+	       a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+static inline bool rectContains(const SDL_Rect &outer, const SDL_Rect &inner) {
+	return outer.x <= inner.x && inner.x + inner.w <= outer.x + outer.w &&
+	       outer.y <= inner.y && inner.y + inner.h <= outer.y + outer.h;
+}
+
+static SDL_Rect rectUnion(const SDL_Rect &a, const SDL_Rect &b) {
+	SDL_Rect r;
+	r.x = MIN(a.x, b.x);
+	r.y = MIN(a.y, b.y);
+	r.w = MAX(a.x + a.w, b.x + b.w) - r.x;
+	r.h = MAX(a.y + a.h, b.y + b.h) - r.y;
+	return r;
+}
+
+// Cuts off the part of rect covered by other, if the remaining part is
+// still a rect. other must not contain rect completely.
+static void trimRect(SDL_Rect &rect, const SDL_Rect &other) {
+	const int rectRight = rect.x + rect.w, rectBottom = rect.y + rect.h;
+	const int otherRight = other.x + other.w, otherBottom = other.y + other.h;
+
+	if (other.x >= rectRight || otherRight <= rect.x || other.y >= rectBottom || otherBottom <= rect.y)
 		return;
 
+	if (other.y <= rect.y && otherBottom >= rectBottom) {
+		// other covers the whole height of rect, cut off the left or right part
+		if (other.x <= rect.x) {
+			rect.w = rectRight - otherRight;
+			rect.x = otherRight;
+		} else if (otherRight >= rectRight) {
+			rect.w = other.x - rect.x;
+		}
+	} else if (other.x <= rect.x && otherRight >= rectRight) {
+		// other covers the whole width of rect, cut off the top or bottom part
+		if (other.y <= rect.y) {
+			rect.h = rectBottom - otherBottom;
+			rect.y = otherBottom;
+		} else if (otherBottom >= rectBottom) {
+			rect.h = other.y - rect.y;
+		}
+	}
+}
+
+// This does not use Common::addDirtyRect(). That one merges all
+// overlapping rects into their bounding rect, and falls back to a single
+// bounding rect once it holds kMaxDirtyRects rects. That suits the engines,
+// which only redraw a few rects per frame. Here every pixel of every rect
+// is run through the scaler, so rects are only merged if that does not add
+// pixels, and overlaps are cut off instead. When the list is full, the new
+// rect is merged with the one that grows the least. The list is also kept
+// in _dirtyRectList, which is passed to SDL_UpdateRects() directly.
+void SdlGraphicsManager::mergeDirtyRect(SDL_Rect rect) {
+	int i = 0;
+	while (i < _numDirtyRects) {
+		const SDL_Rect &cur = _dirtyRectList[i];
+
+		if (!rectsTouch(cur, rect)) {
+			i++;
+			continue;
+		}
+
+		if (rectContains(cur, rect)) {
+			_frameDirtyRectStats.merged++;
+			return;
+		}
+
+		// Merging pays off if the union is not larger than the two rects,
+		// i.e. if they overlap at least as much as the union adds. This
+		// includes rects contained in the new one, and neighbours sharing
+		// a whole edge with it.
+		const SDL_Rect merged = rectUnion(cur, rect);
+		if (rectArea(merged) <= rectArea(cur) + rectArea(rect)) {
+			_dirtyRectList[i] = _dirtyRectList[--_numDirtyRects];
+			_frameDirtyRectStats.merged++;
+
+			// The union may touch rects which were checked already
+			rect = merged;
+			i = 0;
+			continue;
+		}
+
+		trimRect(rect, cur);
+		i++;
+	}
+
 	if (_numDirtyRects == NUM_DIRTY_RECT) {
-		_forceFull = true;
+		// Instead of redrawing the whole screen, merge the new rect with the
+		// rect which grows the least by it
+		int best = 0;
+		int bestGrowth = 0;
+		for (i = 0; i < _numDirtyRects; i++) {
+			const int growth = rectArea(rectUnion(_dirtyRectList[i], rect)) - rectArea(_dirtyRectList[i]);
+			if (i == 0 || growth < bestGrowth) {
+				best = i;
+				bestGrowth = growth;
+			}
+		}
+
+		rect = rectUnion(_dirtyRectList[best], rect);
+		_dirtyRectList[best] = _dirtyRectList[--_numDirtyRects];
+		_frameDirtyRectStats.merged++;
+
+		mergeDirtyRect(rect);
 		return;
 	}
 
+	_dirtyRectList[_numDirtyRects++] = rect;
+}
+
+void SdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool realCoordinates) {
+	_frameDirtyRectStats.submitted++;
+
+	if (_forceFull)
+		return;
+
 	int height, width;
 
 	if (!_overlayVisible && !realCoordinates) {
@@ -1370,6 +1652,26 @@ void SdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool realCoord
 		h = height - y;
 	}
 
+	if (w <= 0 || h <= 0)
+		return;
+
+	// Align the rect to the tile grid, so that it can be merged with its
+	// neighbours. Real coordinates are only used for rects added after
+	// scaling, which merely need to be updated on the screen.
+	if (!realCoordinates) {
+		const int tileWidth = DIRTY_TILE_SIZE;
+		int tileHeight = DIRTY_TILE_SIZE;
+		if (_videoMode.aspectRatioCorrection && !_overlayVisible)
+			tileHeight = DIRTY_TILE_HEIGHT_ASPECT;
+
+		const int right = MIN((x + w + tileWidth - 1) / tileWidth * tileWidth, width);
+		const int bottom = MIN((y + h + tileHeight - 1) / tileHeight * tileHeight, height);
+		x -= x % tileWidth;
+		y -= y % tileHeight;
+		w = right - x;
+		h = bottom - y;
+	}
+
 #ifdef USE_SCALERS
 	if (_videoMode.aspectRatioCorrection && !_overlayVisible && !realCoordinates) {
 		makeRectStretchable(x, y, w, h);
@@ -1381,14 +1683,16 @@ void SdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool realCoord
 		return;
 	}
 
-	if (w > 0 && h > 0) {
-		SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
+	SDL_Rect r;
+	r.x = x;
+	r.y = y;
+	r.w = w;
+	r.h = h;
+	mergeDirtyRect(r);
 
-		r->x = x;
-		r->y = y;
-		r->w = w;
-		r->h = h;
-	}
+	// The merged rects might cover the whole screen by now
+	if (_numDirtyRects == 1 && _dirtyRectList[0].w == width && _dirtyRectList[0].h == height)
+		_forceFull = true;
 }
 
 int16 SdlGraphicsManager::getHeight() {
@@ -235,13 +235,117 @@ protected:
 
 	enum {
 		NUM_DIRTY_RECT = 100,
-		MAX_SCALING = 3
+		MAX_SCALING = 3,
+
+		/**
+		 * Dirty rects are aligned to a grid of tiles of this size, so that
+		 * neighbouring rects share their edges and can be merged.
+		 */
+		DIRTY_TILE_SIZE = 4,
+
+		/**
+		 * Tile height used with aspect ratio correction. Rows which are a
+		 * multiple of 5 are not changed by the stretching, so rects aligned
+		 * to them stay stretchable when they are merged or trimmed.
+		 */
+		DIRTY_TILE_HEIGHT_ASPECT = 5
 	};
 
 	// Dirty rect management
 	SDL_Rect _dirtyRectList[NUM_DIRTY_RECT];
 	int _numDirtyRects;
 
+	struct DirtyRectStats {
+		uint32 frames;			///< Frames which were redrawn
+		uint32 submitted;		///< Rects passed to addDirtyRect()
+		uint32 merged;			///< Rects merged into or dropped in favor of other rects
+		uint32 scaledPixels;	///< Pixels passed to the scaler
+		uint32 forceFull;		///< Frames which were redrawn completely
+	};
+
+	/** Dirty rect statistics of the current frame, and of all frames */
+	DirtyRectStats _frameDirtyRectStats, _totalDirtyRectStats;
+
+	enum {
+		kMaxScalerThreads = 8,
+
+		/**
+		 * Rects are only split into bands of at least this many rows, so
+		 * that small rects are not slowed down by the synchronization.
+		 * Bands always have an even height: some scalers process two rows
+		 * at once, or use the parity of the row.
+		 */
+		kMinScalerBandHeight = 16
+	};
+
+	struct ScalerBand {
+		const uint8 *srcPtr;
+		uint8 *dstPtr;
+		int height;
+	};
+
+	/** Worker threads scaling bands of the dirty rects */
+	SDL_Thread *_scalerThreads[kMaxScalerThreads];
+	uint _numScalerThreads;
+	SDL_mutex *_scalerMutex;
+	SDL_cond *_scalerWorkCond;
+	SDL_cond *_scalerDoneCond;
+	bool _scalerThreadsShouldQuit;
+
+	/** The rect being scaled, and its bands */
+	ScalerProc *_bandScalerProc;
+	uint32 _bandSrcPitch, _bandDstPitch;
+	int _bandWidth;
+	ScalerBand _scalerBands[kMaxScalerThreads + 1];
+	uint _numScalerBands;
+	uint _nextScalerBand;
+	uint _scalerBandsLeft;
+
+	/**
+	 * Starts the scaler worker threads, if enabled by the "scaler_threads"
+	 * config key
+	 */
+	void startScalerThreads();
+
+	/**
+	 * Stops the scaler worker threads and waits for them to finish
+	 */
+	void stopScalerThreads();
+
+	/**
+	 * Main loop of a scaler worker thread
+	 */
+	void scalerThread();
+
+	static int SDLCALL scalerThreadEntry(void *arg);
+
+	/**
+	 * Scales the next band of the current rect which nobody scales yet.
+	 * Must be called with _scalerMutex locked, which is unlocked while
+	 * scaling.
+	 *
+	 * @return false if there was no band left to scale
+	 */
+	bool scaleNextBand();
+
+	/**
+	 * Scales a rect like calling the scaler directly would. If there are
+	 * scaler threads, the rect is split into horizontal bands which are
+	 * scaled in parallel by them and the calling thread. Every band reads
+	 * the rows around it from the source surface, just like the scaler
+	 * does at the edges of a rect, so the result is identical.
+	 */
+	void runScaler(ScalerProc *scalerProc, int scaleFactor, const uint8 *srcPtr, uint32 srcPitch,
+	               uint8 *dstPtr, uint32 dstPitch, int width, int height);
+
+	/**
+	 * Add a clipped rect to the dirty rect list. Rects it overlaps are
+	 * merged with it when that does not increase the area to redraw, and
+	 * the part covered by another rect is cut off when possible. If the list
+	 * is full, the rect is merged with the rect that grows the least.
+	 */
+	void mergeDirtyRect(SDL_Rect rect);
+
 	struct MousePos {
 		// The mouse position, using either virtual (game) or real
 		// (overlay) coordinates.
@@ -29,6 +29,7 @@
 #include "common/system.h"
 #include "common/config-manager.h"
 #include "common/textconsole.h"
+#include "common/util.h"
 
 #ifdef GP2X
 #define SAMPLES_PER_SEC 11025
@@ -40,15 +41,23 @@
 SdlMixerManager::SdlMixerManager()
 	:
 	_mixer(0),
-	_audioSuspended(false) {
+	_audioSuspended(false),
+	_numDecodeThreads(0),
+	_decodeMutex(0),
+	_decodeCond(0),
+	_decodeThreadsShouldQuit(false) {
 
 }
 
 SdlMixerManager::~SdlMixerManager() {
 	_mixer->setReady(false);
 
+	// Close the audio device first, so that the callback is not running
+	// anymore when the decoding threads and their condition are gone.
 	SDL_CloseAudio();
 
+	stopDecodeThreads();
+
 	delete _mixer;
 }
 
@@ -73,12 +82,89 @@ void SdlMixerManager::init() {
 
 		_mixer = new Audio::MixerImpl(g_system, _obtainedRate.freq);
 		assert(_mixer); 
+		startDecodeThreads();
 		_mixer->setReady(true);
 
 		startAudio();
 	}
 }
 
+void SdlMixerManager::startDecodeThreads() {
+	const int threads = ConfMan.getInt("audio_decode_threads");
+	if (threads <= 0)
+		return;
+
+	_decodeMutex = SDL_CreateMutex();
+	_decodeCond = SDL_CreateCond();
+	_decodeThreadsShouldQuit = false;
+
+	_numDecodeThreads = 0;
+	for (int i = 0; i < MIN<int>(threads, kMaxDecodeThreads); ++i) {
+		_decodeThreads[_numDecodeThreads] = SDL_CreateThread(decodeThreadEntry, this);
+		if (!_decodeThreads[_numDecodeThreads]) {
+			warning("Could not create audio decoding thread: %s", SDL_GetError());
+			break;
+		}
+		_numDecodeThreads++;
+	}
+
+	// Without any thread to refill the ring buffers, mix inline as usual
+	if (_numDecodeThreads == 0) {
+		stopDecodeThreads();
+		return;
+	}
+
+	// The ring buffers need to hold at least one callback worth of samples
+	const uint frames = MAX<uint>(_obtainedRate.freq * ConfMan.getInt("audio_decode_ahead") / 1000, _obtainedRate.samples);
+	debug(1, "Decoding audio ahead in %d threads, %d samples per channel", _numDecodeThreads, frames);
+	_mixer->setDecodeAhead(frames);
+}
+
+void SdlMixerManager::stopDecodeThreads() {
+	if (!_decodeMutex)
+		return;
+
+	// Signal the worker threads to end, and wait for them to actually finish.
+	SDL_LockMutex(_decodeMutex);
+	_decodeThreadsShouldQuit = true;
+	SDL_CondBroadcast(_decodeCond);
+	SDL_UnlockMutex(_decodeMutex);
+
+	for (uint i = 0; i < _numDecodeThreads; ++i)
+		SDL_WaitThread(_decodeThreads[i], NULL);
+	_numDecodeThreads = 0;
+
+	SDL_DestroyMutex(_decodeMutex);
+	SDL_DestroyCond(_decodeCond);
+	_decodeMutex = 0;
+	_decodeCond = 0;
+}
+
+void SdlMixerManager::decodeThread() {
+	SDL_LockMutex(_decodeMutex);
+	while (!_decodeThreadsShouldQuit) {
+		SDL_UnlockMutex(_decodeMutex);
+
+		// Refill all channels which are running low
+		while (_mixer->decodeAhead())
+			;
+
+		// Wait for the next mixer callback, which consumes the decoded data.
+		// The timeout takes care of channels started in between.
+		SDL_LockMutex(_decodeMutex);
+		if (!_decodeThreadsShouldQuit)
+			SDL_CondWaitTimeout(_decodeCond, _decodeMutex, 10);
+	}
+	SDL_UnlockMutex(_decodeMutex);
+}
+
+int SDLCALL SdlMixerManager::decodeThreadEntry(void *arg) {
+	SdlMixerManager *manager = (SdlMixerManager *)arg;
+	assert(manager);
+	manager->decodeThread();
+	return 0;
+}
+
 SDL_AudioSpec SdlMixerManager::getAudioSpec(uint32 outputRate) {
 	SDL_AudioSpec desired;
 
@@ -116,6 +202,10 @@ void SdlMixerManager::startAudio() {
 void SdlMixerManager::callbackHandler(byte *samples, int len) {
 	assert(_mixer);
 	_mixer->mixCallback(samples, len);
+
+	// Wake up the decoding threads to refill the consumed data
+	if (_decodeCond)
+		SDL_CondBroadcast(_decodeCond);
 }
 
 void SdlMixerManager::sdlCallback(void *this_, byte *samples, int len) {
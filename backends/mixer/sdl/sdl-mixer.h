@@ -72,6 +72,38 @@ protected:
 	/** State of the audio system */
 	bool _audioSuspended;
 
+	enum {
+		kMaxDecodeThreads = 8
+	};
+
+	/** Worker threads decoding the mixer channels ahead of time */
+	SDL_Thread *_decodeThreads[kMaxDecodeThreads];
+	uint _numDecodeThreads;
+	SDL_mutex *_decodeMutex;
+	SDL_cond *_decodeCond;
+	bool _decodeThreadsShouldQuit;
+
+	/**
+	 * Starts the decoding worker threads, if enabled by the
+	 * "audio_decode_threads" config key
+	 */
+	void startDecodeThreads();
+
+	/**
+	 * Stops the decoding worker threads and waits for them to finish
+	 */
+	void stopDecodeThreads();
+
+	/**
+	 * Main loop of a decoding worker thread
+	 */
+	void decodeThread();
+
+	/**
+	 * Entry point of the decoding worker threads
+	 */
+	static int SDLCALL decodeThreadEntry(void *arg);
+
 	/**
 	 * Returns the desired audio specification 
 	 */
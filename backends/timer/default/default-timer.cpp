@@ -21,6 +21,7 @@
 
 #include "common/scummsys.h"
 #include "backends/timer/default/default-timer.h"
+#include "common/debug.h"
 #include "common/util.h"
 #include "common/system.h"
 
@@ -33,49 +34,115 @@ struct TimerSlot {
 	uint32 nextFireTime;	// in milliseconds
 	uint32 nextFireTimeMicro;	// microseconds part of nextFire
 
-	TimerSlot *next;
-};
+	Common::TimerManager::TimerHandle handle;
+	uint32 sequence;	// insertion order, for timers with the same fire time
+	uint heapIndex;	// position in the heap
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
+	// Statistics
+	uint32 calls;
+	uint32 totalRunTime;	// in milliseconds
+	uint32 maxRunTime;	// in milliseconds
+	uint32 totalLateness;	// in milliseconds
+	uint32 maxLateness;	// in milliseconds
+};
 
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = 0;
+static void printSlotStats(const TimerSlot *slot, const char *state) {
+	if (!slot->calls)
+		return;
 
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == 0 || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
-	}
+	debug(2, "Timer %d (interval %d us, %s): %d calls, run time avg %d ms max %d ms, lateness avg %d ms max %d ms",
+	      slot->handle, slot->interval, state, slot->calls,
+	      slot->totalRunTime / slot->calls, slot->maxRunTime,
+	      slot->totalLateness / slot->calls, slot->maxLateness);
 }
 
 
 DefaultTimerManager::DefaultTimerManager() :
 	_timerHandler(0),
-	_head(0) {
-
-	_head = new TimerSlot();
-	memset(_head, 0, sizeof(TimerSlot));
+	_nextHandle(1),
+	_sequence(0) {
 }
 
 DefaultTimerManager::~DefaultTimerManager() {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+	printStats();
+
+	for (uint i = 0; i < _heap.size(); ++i)
+		delete _heap[i];
+	_heap.clear();
+	_slots.clear();
+}
+
+bool DefaultTimerManager::isBefore(const TimerSlot *a, const TimerSlot *b) const {
+	if (a->nextFireTime != b->nextFireTime)
+		return a->nextFireTime < b->nextFireTime;
+	return (int32)(a->sequence - b->sequence) < 0;
+}
+
+void DefaultTimerManager::placeSlot(TimerSlot *slot, uint index) {
+	_heap[index] = slot;
+	slot->heapIndex = index;
+}
+
+void DefaultTimerManager::siftUp(uint index) {
+	TimerSlot *slot = _heap[index];
+
+	while (index > 0) {
+		const uint parent = (index - 1) / 2;
+		if (!isBefore(slot, _heap[parent]))
+			break;
+		placeSlot(_heap[parent], index);
+		index = parent;
 	}
-	_head = 0;
+
+	placeSlot(slot, index);
+}
+
+void DefaultTimerManager::siftDown(uint index) {
+	TimerSlot *slot = _heap[index];
+	const uint size = _heap.size();
+
+	while (true) {
+		uint child = index * 2 + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && isBefore(_heap[child + 1], _heap[child]))
+			child++;
+		if (!isBefore(_heap[child], slot))
+			break;
+		placeSlot(_heap[child], index);
+		index = child;
+	}
+
+	placeSlot(slot, index);
+}
+
+void DefaultTimerManager::insertSlot(TimerSlot *slot) {
+	slot->sequence = _sequence++;
+	_heap.push_back(slot);
+	siftUp(_heap.size() - 1);
+}
+
+void DefaultTimerManager::removeSlot(TimerSlot *slot) {
+	const uint index = slot->heapIndex;
+	TimerSlot *last = _heap.back();
+	_heap.pop_back();
+
+	if (last != slot) {
+		// Move the last slot into the gap and restore the heap order
+		placeSlot(last, index);
+		if (index > 0 && isBefore(last, _heap[(index - 1) / 2]))
+			siftUp(index);
+		else
+			siftDown(index);
+	}
+
+	// Log the statistics now, since they are gone with the slot
+	printSlotStats(slot, "removed");
+
+	_slots.erase(slot->handle);
+	delete slot;
 }
 
 void DefaultTimerManager::handler() {
@@ -84,13 +151,13 @@ void DefaultTimerManager::handler() {
 	const uint32 curTime = g_system->getMillis();
 
 	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
+	while (!_heap.empty() && _heap[0]->nextFireTime < curTime) {
+		TimerSlot *slot = _heap[0];
+		const TimerHandle handle = slot->handle;
+		const uint32 lateness = curTime - slot->nextFireTime;
 
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
+		// Update the fire time and move the TimerSlot to its new position
+		// in the heap.
 		assert(slot->interval > 0);
 		slot->nextFireTime += (slot->interval / 1000);
 		slot->nextFireTimeMicro += (slot->interval % 1000);
@@ -98,36 +165,49 @@ void DefaultTimerManager::handler() {
 			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
 			slot->nextFireTimeMicro %= 1000;
 		}
-		insertPrioQueue(_head, slot);
+		slot->sequence = _sequence++;
+		siftDown(0);
+
+		slot->calls++;
+		slot->totalLateness += lateness;
+		slot->maxLateness = MAX(slot->maxLateness, lateness);
 
 		// Invoke the timer callback
 		assert(slot->callback);
+		const uint32 startTime = g_system->getMillis();
 		slot->callback(slot->refCon);
+		const uint32 runTime = g_system->getMillis() - startTime;
 
-		// Look at the next scheduled timer
-		slot = _head->next;
+		// The callback might have removed its own timer
+		TimerSlotMap::iterator it = _slots.find(handle);
+		if (it != _slots.end()) {
+			it->_value->totalRunTime += runTime;
+			it->_value->maxRunTime = MAX(it->_value->maxRunTime, runTime);
+		}
 	}
 }
 
-bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, void *refCon) {
+bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, void *refCon, TimerHandle *handle) {
 	assert(interval > 0);
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = new TimerSlot;
+	TimerSlot *slot = new TimerSlot();
 	slot->callback = callback;
 	slot->refCon = refCon;
 	slot->interval = interval;
 	slot->nextFireTime = g_system->getMillis() + interval / 1000;
 	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = 0;
 
-	// FIXME: It seems we do allow the client to add one callback multiple times over here,
-	// but "removeTimerProc" will remove *all* added instances. We should either prevent
-	// multiple additions of a timer proc OR we should change removeTimerProc to only remove
-	// a specific timer proc entry.
-	// Probably we can safely just allow a single addition of a specific function once
-	// and just update our Timer documentation accordingly.
-	insertPrioQueue(_head, slot);
+	// Handles are never 0, and never reused while the old one is installed
+	do {
+		slot->handle = _nextHandle++;
+	} while (slot->handle == 0 || _slots.contains(slot->handle));
+
+	_slots[slot->handle] = slot;
+	insertSlot(slot);
+
+	if (handle)
+		*handle = slot->handle;
 
 	return true;
 }
@@ -135,15 +215,29 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
-		} else {
-			slot = slot->next;
-		}
+	// Removes all instances of the callback. Use removeTimerHandle() to
+	// remove a specific one.
+	Common::Array<TimerSlot *> matches;
+	for (uint i = 0; i < _heap.size(); ++i) {
+		if (_heap[i]->callback == callback)
+			matches.push_back(_heap[i]);
 	}
+
+	for (uint i = 0; i < matches.size(); ++i)
+		removeSlot(matches[i]);
+}
+
+void DefaultTimerManager::removeTimerHandle(TimerHandle handle) {
+	Common::StackLock lock(_mutex);
+
+	TimerSlotMap::iterator it = _slots.find(handle);
+	if (it != _slots.end())
+		removeSlot(it->_value);
+}
+
+void DefaultTimerManager::printStats() {
+	Common::StackLock lock(_mutex);
+
+	for (uint i = 0; i < _heap.size(); ++i)
+		printSlotStats(_heap[i], "installed");
 }
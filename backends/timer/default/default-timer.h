@@ -23,26 +23,60 @@
 #define BACKENDS_TIMER_DEFAULT_H
 
 #include "common/timer.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/mutex.h"
 
 struct TimerSlot;
 
+/**
+ * Timer manager which keeps the installed timers in a binary min-heap,
+ * ordered by their next fire time. Firing a timer and rescheduling it thus
+ * takes O(log n), as does installing a timer or removing it by its handle.
+ */
 class DefaultTimerManager : public Common::TimerManager {
 private:
+	typedef Common::HashMap<TimerHandle, TimerSlot *> TimerSlotMap;
+
 	Common::Mutex _mutex;
 	void *_timerHandler;
-	TimerSlot *_head;
+
+	/** The scheduled timers, as a binary min-heap */
+	Common::Array<TimerSlot *> _heap;
+
+	/** All installed timers, by their handle */
+	TimerSlotMap _slots;
+
+	TimerHandle _nextHandle;
+
+	/** Used to keep the firing order of timers with the same fire time stable */
+	uint32 _sequence;
+
+	bool isBefore(const TimerSlot *a, const TimerSlot *b) const;
+	void placeSlot(TimerSlot *slot, uint index);
+	void siftUp(uint index);
+	void siftDown(uint index);
+	void insertSlot(TimerSlot *slot);
+	void removeSlot(TimerSlot *slot);
 
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
-	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon);
+	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon, TimerHandle *handle = 0);
 	virtual void removeTimerProc(TimerProc proc);
+	virtual void removeTimerHandle(TimerHandle handle);
 
 	/**
 	 * Timer callback, to be invoked at regular time intervals by the backend.
 	 */
 	void handler();
+
+	/**
+	 * Prints the number of calls, the run time and the lateness of all
+	 * installed timer callbacks to the debug output. The statistics of a
+	 * timer are also printed when it is removed.
+	 */
+	void printStats();
 };
 
 #endif
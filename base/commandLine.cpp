@@ -164,6 +164,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("gfx_mode", "normal");
 	ConfMan.registerDefault("render_mode", "default");
 	ConfMan.registerDefault("desired_screen_aspect_ratio", "auto");
+	ConfMan.registerDefault("scaler_threads", 0);
 
 	// Sound & Music
 	ConfMan.registerDefault("music_volume", 192);
@@ -179,6 +180,9 @@ void registerDefaults() {
 	ConfMan.registerDefault("native_mt32", false);
 	ConfMan.registerDefault("enable_gs", false);
 	ConfMan.registerDefault("midi_gain", 100);
+	ConfMan.registerDefault("resampling_quality", 0);
+	ConfMan.registerDefault("audio_decode_threads", 0);
+	ConfMan.registerDefault("audio_decode_ahead", 100);
 //	ConfMan.registerDefault("music_driver", ???);
 
 	ConfMan.registerDefault("mt32_device", "null");
@@ -208,6 +212,7 @@ void registerDefaults() {
 #endif
 #ifdef ENABLE_SCUMM
 	ConfMan.registerDefault("tempo", 0);
+	ConfMan.registerDefault("resource_budget", 0);
 #ifdef ENABLE_SCUMM_7_8
 	ConfMan.registerDefault("dimuse_tempo", 10);
 #endif
@@ -0,0 +1,72 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_CPUDETECT_H
+#define COMMON_CPUDETECT_H
+
+#include "common/scummsys.h"
+
+/**
+ * @file
+ * Compile time and run time detection of SIMD instruction set extensions.
+ *
+ * Code using SIMD intrinsics should check the SCUMMVM_* defines below to
+ * decide which code paths to compile, and Common::hasCPUFeature() to decide
+ * at run time which of those paths may actually be used on the host CPU.
+ */
+
+// SSE2 is part of the x86-64 base instruction set. On 32 bit x86 it is only
+// used when the compiler was told that it may use it.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCUMMVM_SSE2
+#endif
+
+// AVX2 code is compiled via function target attributes, so that it can be
+// built without raising the baseline of the whole binary.
+#if defined(SCUMMVM_SSE2) && (defined(__x86_64__) || defined(__i386__)) && \
+	(defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define SCUMMVM_AVX2
+#define SCUMMVM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// NEON is mandatory on AArch64. On 32 bit ARM we rely on the compiler flags.
+#if defined(__ARM_NEON__) || defined(__ARM_NEON) || defined(__aarch64__)
+#define SCUMMVM_NEON
+#endif
+
+namespace Common {
+
+enum CPUFeature {
+	kCPUFeatureSSE2 = 1 << 0,
+	kCPUFeatureAVX2 = 1 << 1,
+	kCPUFeatureNEON = 1 << 2
+};
+
+/**
+ * Checks whether the host CPU supports the given instruction set extension
+ * and whether support for it was compiled in.
+ */
+bool hasCPUFeature(CPUFeature feature);
+
+} // End of namespace Common
+
+#endif
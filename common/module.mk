@@ -4,6 +4,7 @@ MODULE_OBJS := \
 	archive.o \
 	config-file.o \
 	config-manager.o \
+	cpudetect.o \
 	dcl.o \
 	debug.o \
 	error.o \
@@ -20,6 +21,7 @@ MODULE_OBJS := \
 	quicktime.o \
 	random.o \
 	rational.o \
+	rect.o \
 	str.o \
 	stream.o \
 	system.o \
@@ -0,0 +1,59 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "common/rect.h"
+#include "common/array.h"
+
+namespace Common {
+
+void addDirtyRect(Array<Rect> &rects, const Rect &rect, const Rect &clip) {
+	if (!rect.isValidRect())
+		return;
+
+	Rect newRect = rect;
+	newRect.clip(clip);
+	if (newRect.isEmpty())
+		return;
+
+	// Merge with all overlapping rects. Merging can create new overlaps, so
+	// start over after each one.
+	uint i = 0;
+	while (i < rects.size()) {
+		if (rects[i].intersects(newRect)) {
+			newRect.extend(rects[i]);
+			rects.remove_at(i);
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+
+	// Too many separate rects cost more to process than they save in pixels
+	if (rects.size() >= kMaxDirtyRects) {
+		for (i = 0; i < rects.size(); ++i)
+			newRect.extend(rects[i]);
+		rects.clear();
+	}
+
+	rects.push_back(newRect);
+}
+
+}	// End of namespace Common
@@ -29,6 +29,8 @@
 
 namespace Common {
 
+template<class T> class Array;
+
 /**
  * Simple class for handling both 2D position and size.
  */
@@ -252,6 +254,18 @@ struct Rect {
 	}
 };
 
+enum {
+	/** Number of dirty rects addDirtyRect() keeps apart at most */
+	kMaxDirtyRects = 16
+};
+
+/**
+ * Add a rect to a list of dirty rects, after clipping it to the given clip
+ * rect. Rects overlapping it are merged into one. Once the list holds
+ * kMaxDirtyRects rects, all of them are merged into their bounding rect.
+ */
+void addDirtyRect(Array<Rect> &rects, const Rect &rect, const Rect &clip);
+
 }	// End of namespace Common
 
 #endif
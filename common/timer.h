@@ -31,6 +31,12 @@ class TimerManager : NonCopyable {
 public:
 	typedef void (*TimerProc)(void *refCon);
 
+	/**
+	 * Identifies a single installed instance of a timer callback. A value
+	 * of 0 never refers to an installed timer.
+	 */
+	typedef uint32 TimerHandle;
+
 	virtual ~TimerManager() {}
 
 	/**
@@ -43,15 +49,27 @@ public:
 	 * @param proc		the callback
 	 * @param interval	the interval in which the timer shall be invoked (in microseconds)
 	 * @param refCon	an arbitrary void pointer; will be passed to the timer callback
+	 * @param handle	if not 0, receives a handle which identifies this instance of
+	 *                  the callback, see removeTimerHandle()
 	 * @return	true if the timer was installed successfully, false otherwise
 	 */
-	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon) = 0;
+	virtual bool installTimerProc(TimerProc proc, int32 interval, void *refCon, TimerHandle *handle = 0) = 0;
 
 	/**
 	 * Remove the given timer callback. It will not be invoked anymore,
 	 * and no instance of this callback will be running anymore.
+	 *
+	 * @note This removes all instances of the callback, regardless of
+	 *       their refCon. Use removeTimerHandle() to remove a single one.
 	 */
 	virtual void removeTimerProc(TimerProc proc) = 0;
+
+	/**
+	 * Remove the timer callback instance identified by the given handle.
+	 * It will not be invoked anymore, and will not be running anymore.
+	 * Handles of timers which were already removed are ignored.
+	 */
+	virtual void removeTimerHandle(TimerHandle handle) = 0;
 };
 
 } // End of namespace Common
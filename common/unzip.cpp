@@ -108,6 +108,9 @@ typedef struct {
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/list.h"
+#include "common/ptr.h"
+#include "common/substream.h"
 
 #if defined(STRICTUNZIP) || defined(STRICTZIPUNZIP)
 /* like the STRICT of WIN32, we define a pointer that cannot be converted
@@ -379,6 +382,8 @@ typedef Common::HashMap<Common::String, cached_file_in_zip, Common::IgnoreCase_H
 */
 typedef struct {
 	Common::SeekableReadStream *_stream;				/* io structore of the zipfile */
+	Common::SharedPtr<Common::SeekableReadStream> _sharedStream;	/* owns _stream, shared with
+													streams of stored files */
 	unz_global_info gi;				/* public global information */
 	uLong byte_before_the_zipfile;	/* byte before the zipfile, (>0 for sfx)*/
 	uLong num_file;					/* number of the current file in the zipfile*/
@@ -394,9 +399,45 @@ typedef struct {
 	unz_file_info_internal cur_file_info_internal;	/* private info about it*/
 	file_in_zip_read_info_s* pfile_in_zip_read;		/* structure about the current
 													file if we are decompressing it */
-	ZipHash _hash;
+	Common::SharedPtr<ZipHash> _hash;	/* index of the central dir, may be shared
+										with the zip index cache */
 } unz_s;
 
+/* ZipStoredFileStream reads a stored file directly from the zipfile. It
+   shares the zipfile stream, so it stays usable after the zipfile is closed.
+*/
+class ZipStoredFileStream : public Common::SafeSubReadStream {
+	Common::SharedPtr<Common::SeekableReadStream> _zipStream;
+
+public:
+	ZipStoredFileStream(const Common::SharedPtr<Common::SeekableReadStream> &zipStream, uint32 begin, uint32 end) :
+		Common::SafeSubReadStream(zipStream.get(), begin, end),
+		_zipStream(zipStream) {
+	}
+};
+
+/* zip_index_cache_entry remembers the central dir index of a zipfile, so that
+   opening it again doesn't need to walk the whole central dir. The index is
+   only reused if the end of central dir record still matches.
+*/
+typedef struct {
+	Common::String key;				/* name of the zipfile */
+	uLong size_file;				/* size of the zipfile */
+	uLong central_pos;				/* position of the end of central dir record */
+	uLong size_central_dir;			/* size of the central directory */
+	uLong offset_central_dir;		/* offset of start of central directory */
+	uLong number_entry;				/* total number of entries in the central dir */
+	Common::SharedPtr<ZipHash> index;
+} zip_index_cache_entry;
+
+typedef Common::List<zip_index_cache_entry> ZipIndexCache;
+
+/* number of zipfile indices kept after their zipfile was closed */
+#define ZIP_INDEX_CACHE_SIZE 4
+
+/* most recently used first */
+static ZipIndexCache s_zipIndexCache;
+
 /* ===========================================================================
      Read a byte from a gz_stream; update next_in and avail_in. Return EOF
    for end of file.
@@ -514,6 +555,68 @@ static uLong unzlocal_SearchCentralDir(Common::SeekableReadStream &fin) {
 	return uPosFound;
 }
 
+/*
+  Look for a cached index of the zipfile in us, and use it if it still
+    matches the end of central dir record.
+  return 1 if a cached index was found, 0 otherwise
+*/
+static int unzlocal_FindCachedIndex(unz_s *us, const Common::String &key) {
+	const uLong size_file = us->_stream->size();
+
+	for (ZipIndexCache::iterator i = s_zipIndexCache.begin(); i != s_zipIndexCache.end(); ++i) {
+		if (i->key != key)
+			continue;
+
+		if (i->size_file != size_file ||
+		    i->central_pos != us->central_pos ||
+		    i->size_central_dir != us->size_central_dir ||
+		    i->offset_central_dir != us->offset_central_dir ||
+		    i->number_entry != us->gi.number_entry) {
+			// The zipfile changed, the index is stale
+			s_zipIndexCache.erase(i);
+			return 0;
+		}
+
+		us->_hash = i->index;
+
+		// Move the entry to the front
+		if (i != s_zipIndexCache.begin()) {
+			zip_index_cache_entry entry = *i;
+			s_zipIndexCache.erase(i);
+			s_zipIndexCache.push_front(entry);
+		}
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+  Remember the index of the zipfile in us, dropping the least recently
+    used index if the cache is full.
+*/
+static void unzlocal_CacheIndex(unz_s *us, const Common::String &key) {
+	for (ZipIndexCache::iterator i = s_zipIndexCache.begin(); i != s_zipIndexCache.end(); ++i) {
+		if (i->key == key) {
+			s_zipIndexCache.erase(i);
+			break;
+		}
+	}
+
+	zip_index_cache_entry entry;
+	entry.key = key;
+	entry.size_file = us->_stream->size();
+	entry.central_pos = us->central_pos;
+	entry.size_central_dir = us->size_central_dir;
+	entry.offset_central_dir = us->offset_central_dir;
+	entry.number_entry = us->gi.number_entry;
+	entry.index = us->_hash;
+	s_zipIndexCache.push_front(entry);
+
+	if (s_zipIndexCache.size() > ZIP_INDEX_CACHE_SIZE)
+		s_zipIndexCache.pop_back();
+}
+
 /*
   Open a Zip file. path contain the full pathname (by example,
      on a Windows NT computer "c:\\test\\zlib109.zip" or on an Unix computer
@@ -522,8 +625,11 @@ static uLong unzlocal_SearchCentralDir(Common::SeekableReadStream &fin) {
 	   return value is NULL.
      Else, the return value is a unzFile Handle, usable with other function
 	   of this unzip package.
+	 If indexKey is not empty, the index of the central dir is cached under
+	   that name, and reused when a zipfile with the same name and the same
+	   end of central dir record is opened again.
 */
-unzFile unzOpen(Common::SeekableReadStream *stream) {
+unzFile unzOpen(Common::SeekableReadStream *stream, const Common::String &indexKey) {
 	if (!stream)
 		return NULL;
 
@@ -541,6 +647,7 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 	int err=UNZ_OK;
 
 	us->_stream = stream;
+	us->_sharedStream = Common::SharedPtr<Common::SeekableReadStream>(stream);
 
 	central_pos = unzlocal_SearchCentralDir(*us->_stream);
 	if (central_pos==0)
@@ -592,7 +699,6 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 		err=UNZ_BADZIPFILE;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
 		delete us;
 		return NULL;
 	}
@@ -604,6 +710,11 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 
 	err = unzGoToFirstFile((unzFile)us);
 
+	if (!indexKey.empty() && unzlocal_FindCachedIndex(us, indexKey))
+		return (unzFile)us;
+
+	us->_hash = Common::SharedPtr<ZipHash>(new ZipHash());
+
 	while (err == UNZ_OK) {
 		// Get the file details
 		char szCurrentFileName[UNZ_MAXFILENAMEINZIP+1];
@@ -618,11 +729,15 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 		fe.cur_file_info = us->cur_file_info;
 		fe.cur_file_info_internal = us->cur_file_info_internal;
 
-		us->_hash[Common::String(szCurrentFileName)] = fe;
+		(*us->_hash)[Common::String(szCurrentFileName)] = fe;
 
 		// Move to the next file
 		err = unzGoToNextFile((unzFile)us);
 	}
+
+	if (!indexKey.empty())
+		unzlocal_CacheIndex(us, indexKey);
+
 	return (unzFile)us;
 }
 
@@ -641,7 +756,7 @@ int unzClose(unzFile file) {
 	if (s->pfile_in_zip_read != NULL)
 		unzCloseCurrentFile(file);
 
-	delete s->_stream;
+	// Streams of stored files may still use the zipfile
 	delete s;
 	return UNZ_OK;
 }
@@ -925,8 +1040,8 @@ int unzLocateFile(unzFile file, const char *szFileName, int iCaseSensitivity) {
 		return UNZ_END_OF_LIST_OF_FILE;
 
 	// Check to see if the entry exists
-	ZipHash::iterator i = s->_hash.find(Common::String(szFileName));
-	if (i == s->_hash.end())
+	ZipHash::iterator i = s->_hash->find(Common::String(szFileName));
+	if (i == s->_hash->end())
 		return UNZ_END_OF_LIST_OF_FILE;
 
 	// Found it, so reset the details in the main structure
@@ -1122,6 +1237,33 @@ int unzOpenCurrentFile (unzFile file) {
 }
 
 
+/*
+  Create a stream reading the current file directly from the zipfile, which
+    is kept open as long as the stream exists.
+  Only files which are stored without compression can be read this way.
+  unzOpenCurrentFile must have been called before.
+  return NULL if the current file is compressed
+*/
+static Common::SeekableReadStream *unzOpenCurrentFileStream(unzFile file) {
+	unz_s* s;
+	file_in_zip_read_info_s* pfile_in_zip_read_info;
+	if (file==NULL)
+		return NULL;
+	s=(unz_s*)file;
+	pfile_in_zip_read_info=s->pfile_in_zip_read;
+
+	if (pfile_in_zip_read_info==NULL)
+		return NULL;
+	if (pfile_in_zip_read_info->compression_method!=0)
+		return NULL;
+
+	const uLong begin = pfile_in_zip_read_info->pos_in_zipfile +
+	                    pfile_in_zip_read_info->byte_before_the_zipfile;
+	return new ZipStoredFileStream(s->_sharedStream, begin,
+	                               begin + s->cur_file_info.uncompressed_size);
+}
+
+
 /*
   Read bytes from the current file.
   buf contain buffer where data must be copied
@@ -1464,18 +1606,13 @@ bool ZipArchive::hasFile(const Common::String &name) {
 
 int ZipArchive::listMembers(Common::ArchiveMemberList &list) {
 	int matches = 0;
-	int err = unzGoToFirstFile(_zipFile);
-
-	while (err == UNZ_OK) {
-		char szCurrentFileName[UNZ_MAXFILENAMEINZIP+1];
-		if (unzGetCurrentFileInfo(_zipFile, NULL,
-		                          szCurrentFileName, sizeof(szCurrentFileName)-1,
-		                          NULL, 0, NULL, 0) == UNZ_OK) {
-			list.push_back(ArchiveMemberList::value_type(new GenericArchiveMember(szCurrentFileName, this)));
-			matches++;
-		}
 
-		err = unzGoToNextFile(_zipFile);
+	// The index already holds the names of all files, so there is no need to
+	// walk the central directory again
+	const ZipHash &hash = *((unz_s *)_zipFile)->_hash;
+	for (ZipHash::const_iterator i = hash.begin(); i != hash.end(); ++i) {
+		list.push_back(ArchiveMemberList::value_type(new GenericArchiveMember(i->_key, this)));
+		matches++;
 	}
 
 	return matches;
@@ -1499,6 +1636,13 @@ Common::SeekableReadStream *ZipArchive::createReadStreamForMember(const Common::
 	if (unzGetCurrentFileInfo(_zipFile, &fileInfo, NULL, 0, NULL, 0, NULL, 0) != UNZ_OK)
 		return 0;
 
+	// Stored files are read directly from the archive, without copying them
+	SeekableReadStream *stream = unzOpenCurrentFileStream(_zipFile);
+	if (stream) {
+		unzCloseCurrentFile(_zipFile);
+		return stream;
+	}
+
 	byte *buffer = (byte *)malloc(fileInfo.uncompressed_size);
 	assert(buffer);
 
@@ -1515,23 +1659,14 @@ Common::SeekableReadStream *ZipArchive::createReadStreamForMember(const Common::
 	return new Common::MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
 
 	// FIXME: instead of reading all into a memory stream, we could
-	// instead create a new ZipStream class. But then we have to be
-	// careful to handle the case where the client code opens multiple
-	// files in the archive and tries to use them independently.
-}
-
-Archive *makeZipArchive(const String &name) {
-	return makeZipArchive(SearchMan.createReadStreamForMember(name));
+	// instead create a new ZipStream class which inflates on the fly,
+	// like ZipStoredFileStream does for stored files.
 }
 
-Archive *makeZipArchive(const FSNode &node) {
-	return makeZipArchive(node.createReadStream());
-}
-
-Archive *makeZipArchive(SeekableReadStream *stream) {
+Archive *makeZipArchive(SeekableReadStream *stream, const String &indexKey) {
 	if (!stream)
 		return 0;
-	unzFile zipFile = unzOpen(stream);
+	unzFile zipFile = unzOpen(stream, indexKey);
 	if (!zipFile) {
 		// stream gets deleted by unzOpen() call if something
 		// goes wrong.
@@ -1540,4 +1675,16 @@ Archive *makeZipArchive(SeekableReadStream *stream) {
 	return new ZipArchive(zipFile);
 }
 
+Archive *makeZipArchive(const String &name) {
+	return makeZipArchive(SearchMan.createReadStreamForMember(name), name);
+}
+
+Archive *makeZipArchive(const FSNode &node) {
+	return makeZipArchive(node.createReadStream(), node.getPath());
+}
+
+Archive *makeZipArchive(SeekableReadStream *stream) {
+	return makeZipArchive(stream, String());
+}
+
 }	// End of namespace Common
@@ -50,12 +50,23 @@ Archive *makeZipArchive(const FSNode &node);
  * This factory method creates an Archive instance corresponding to the content
  * of the given ZIP compressed datastream.
  * This takes ownership of the stream,  in particular, it is deleted when the
- * ZipArchive is deleted.
+ * ZipArchive is deleted. Files stored without compression are read directly
+ * from the stream, so it is only deleted once their streams are deleted, too.
  *
  * May return 0 in case of a failure. In this case stream will still be deleted.
  */
 Archive *makeZipArchive(SeekableReadStream *stream);
 
+/**
+ * Same as above, but the index of the ZIP file's central directory is kept
+ * under the given name after the archive is deleted. Opening a ZIP file
+ * with the same name and the same end of central directory record again
+ * reuses it instead of reading the central directory.
+ *
+ * May return 0 in case of a failure. In this case stream will still be deleted.
+ */
+Archive *makeZipArchive(SeekableReadStream *stream, const String &indexKey);
+
 }	// End of namespace Common
 
 #endif
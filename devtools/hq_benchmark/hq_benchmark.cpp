@@ -0,0 +1,158 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * This is a benchmark for the HQ2x and HQ3x scalers. It compares their frame
+ * times with those of the original per pixel code using the RGBtoYUV lookup
+ * table (see hq2x_reference.cpp and hq3x_reference.cpp), and verifies that
+ * both produce the same output.
+ */
+
+// Allow use of stuff in <time.h>
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+#include "graphics/scaler.h"
+#include "graphics/colormasks.h"
+#include "common/util.h"
+
+DECLARE_SCALER(HQ2x_reference);
+DECLARE_SCALER(HQ3x_reference);
+
+enum {
+	kWidth = 320,
+	kHeight = 200,
+	// The scalers read one pixel beyond each edge of the source
+	kSrcPitch = kWidth + 2,
+	kFrames = 100
+};
+
+/**
+ * Fill the source with something resembling game graphics: smooth gradients
+ * and flat areas, with some noise and hard edges.
+ */
+static void fillSource(uint16 *src, uint32 bitFormat) {
+	uint32 seed = 1;
+	for (int y = 0; y < kHeight + 2; ++y) {
+		for (int x = 0; x < kSrcPitch; ++x) {
+			seed = seed * 1103515245 + 12345;
+			int r = (x * 31) / kSrcPitch;
+			int g = ((y / 8) * 8 * 31) / (kHeight + 2);
+			int b = ((x / 16 + y / 16) & 1) ? 24 : 4;
+			if (((seed >> 16) & 7) == 0) {
+				r = (seed >> 20) & 31;
+				g = (seed >> 25) & 31;
+			}
+
+			if (bitFormat == 565)
+				src[y * kSrcPitch + x] = (r << 11) | (g << 6) | b;
+			else
+				src[y * kSrcPitch + x] = (r << 10) | (g << 5) | b;
+		}
+	}
+}
+
+/** The RGBtoYUV table used by the reference scalers. */
+uint32 *referenceRGBtoYUV = 0;
+
+/** Fill referenceRGBtoYUV the same way InitLUT() fills RGBtoYUV. */
+static void initReferenceLUT(const Graphics::PixelFormat &format) {
+	uint8 r, g, b;
+
+	for (int color = 0; color < 65536; ++color) {
+		format.colorToRGB(color, r, g, b);
+		const int Y = (r + g + b) >> 2;
+		const int u = 128 + ((r - b) >> 2);
+		const int v = 128 + ((-r + 2 * g - b) >> 3);
+		referenceRGBtoYUV[color] = (Y << 16) | (u << 8) | v;
+	}
+}
+
+static double runScaler(ScalerProc *scaler, int factor, const uint16 *src, uint16 *dst) {
+	const uint8 *srcPtr = (const uint8 *)(src + kSrcPitch + 1);
+	const uint32 srcPitch = kSrcPitch * sizeof(uint16);
+	const uint32 dstPitch = kWidth * factor * sizeof(uint16);
+
+	const clock_t start = clock();
+	for (int i = 0; i < kFrames; ++i)
+		scaler(srcPtr, srcPitch, (uint8 *)dst, dstPitch, kWidth, kHeight);
+	const clock_t end = clock();
+
+	return (double)(end - start) * 1000.0 / CLOCKS_PER_SEC / kFrames;
+}
+
+int main(int argc, char *argv[]) {
+	static const uint32 bitFormats[] = { 565, 555 };
+	static const struct {
+		const char *name;
+		ScalerProc *proc;
+		ScalerProc *reference;
+		int factor;
+	} scalers[] = {
+		{ "HQ2x", HQ2x, HQ2x_reference, 2 },
+		{ "HQ3x", HQ3x, HQ3x_reference, 3 }
+	};
+
+	uint16 *src = new uint16[kSrcPitch * (kHeight + 2)];
+	referenceRGBtoYUV = new uint32[65536];
+	uint16 *refDst = new uint16[kWidth * kHeight * 9];
+	uint16 *dst = new uint16[kWidth * kHeight * 9];
+
+	printf("Scaling %dx%d frames, average over %d frames\n\n", kWidth, kHeight, kFrames);
+	printf("%-6s %6s %12s %12s %10s %10s\n", "scaler", "format", "orig (ms)", "new (ms)", "speedup", "identical");
+
+	bool allIdentical = true;
+	for (int f = 0; f < ARRAYSIZE(bitFormats); ++f) {
+		fillSource(src, bitFormats[f]);
+		initReferenceLUT(bitFormats[f] == 565 ? Graphics::createPixelFormat<565>() : Graphics::createPixelFormat<555>());
+		InitScalers(bitFormats[f]);
+
+		for (int s = 0; s < ARRAYSIZE(scalers); ++s) {
+			const int dstSize = kWidth * kHeight * scalers[s].factor * scalers[s].factor * sizeof(uint16);
+
+			const double ref = runScaler(scalers[s].reference, scalers[s].factor, src, refDst);
+			const double time = runScaler(scalers[s].proc, scalers[s].factor, src, dst);
+
+			const bool identical = !memcmp(refDst, dst, dstSize);
+			allIdentical = allIdentical && identical;
+
+			const double speedup = time > 0 ? ref / time : 0.0;
+			printf("%-6s %6d %12.3f %12.3f %9.2fx %10s\n", scalers[s].name, bitFormats[f], ref, time, speedup, identical ? "yes" : "NO");
+		}
+
+		DestroyScalers();
+	}
+
+	delete[] src;
+	delete[] referenceRGBtoYUV;
+	delete[] refDst;
+	delete[] dst;
+
+	return allIdentical ? 0 : 1;
+}
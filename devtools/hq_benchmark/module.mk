@@ -0,0 +1,15 @@
+MODULE := devtools/hq_benchmark
+
+MODULE_OBJS := \
+	hq_benchmark.o \
+	hq2x_reference.o \
+	hq3x_reference.o
+
+# Set the name of the executable
+TOOL_EXECUTABLE := hq_benchmark
+
+# The benchmark links against the actual scaler code
+TOOL_DEPS := graphics/libgraphics.a common/libcommon.a
+
+# Include common rules
+include $(srcdir)/rules.mk
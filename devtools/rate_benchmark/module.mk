@@ -0,0 +1,13 @@
+MODULE := devtools/rate_benchmark
+
+MODULE_OBJS := \
+	rate_benchmark.o
+
+# Set the name of the executable
+TOOL_EXECUTABLE := rate_benchmark
+
+# The benchmark links against the actual audio code
+TOOL_DEPS := audio/libaudio.a common/libcommon.a
+
+# Include common rules
+include $(srcdir)/rules.mk
@@ -0,0 +1,108 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * This is a micro benchmark for the mixing kernels used by the audio rate
+ * converters. It compares the SIMD kernels supported by the host CPU with
+ * the scalar code on long buffers and verifies that they produce identical
+ * output.
+ */
+
+// Allow use of stuff in <time.h>
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+#include "audio/rate.h"
+#include "audio/rate_kernels.h"
+
+enum {
+	kFrames = 1 << 20,
+	kIterations = 50
+};
+
+static void fillSamples(int16 *buffer, int len) {
+	uint32 seed = 1;
+	for (int i = 0; i < len; ++i) {
+		seed = seed * 1103515245 + 12345;
+		buffer[i] = (int16)(seed >> 16);
+	}
+}
+
+static double runKernel(Audio::MixFramesProc proc, int16 *out, const int16 *in) {
+	memset(out, 0, kFrames * 2 * sizeof(int16));
+
+	const clock_t start = clock();
+	for (int i = 0; i < kIterations; ++i)
+		proc(out, in, kFrames, 200, 180);
+	const clock_t end = clock();
+
+	return (double)(end - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char *argv[]) {
+	int16 *in = new int16[kFrames * 2];
+	int16 *out = new int16[kFrames * 2];
+
+	fillSamples(in, kFrames * 2);
+
+	const Audio::MixKernels &scalar = *Audio::getMixKernels(Audio::kMixKernelScalar);
+
+	printf("Mixing %d frames %d times, best kernel: %s\n\n", kFrames, kIterations, Audio::getBestMixKernels().name);
+	printf("%-8s %12s %12s %10s %10s\n", "kernel", "stereo (ms)", "mono (ms)", "speedup", "identical");
+
+	int16 *referenceStereo = new int16[kFrames * 2];
+	int16 *referenceMono = new int16[kFrames * 2];
+	const double scalarStereo = runKernel(scalar.mixStereo, referenceStereo, in);
+	const double scalarMono = runKernel(scalar.mixMono, referenceMono, in);
+
+	bool allIdentical = true;
+	for (int type = 0; type < Audio::kMixKernelCount; ++type) {
+		const Audio::MixKernels *kernels = Audio::getMixKernels((Audio::MixKernelType)type);
+		if (!kernels)
+			continue;
+
+		const double stereo = runKernel(kernels->mixStereo, out, in);
+		bool identical = !memcmp(referenceStereo, out, kFrames * 2 * sizeof(int16));
+
+		const double mono = runKernel(kernels->mixMono, out, in);
+		identical = identical && !memcmp(referenceMono, out, kFrames * 2 * sizeof(int16));
+
+		allIdentical = allIdentical && identical;
+
+		const double speedup = (stereo + mono) > 0 ? (scalarStereo + scalarMono) / (stereo + mono) : 0.0;
+		printf("%-8s %12.1f %12.1f %9.2fx %10s\n", kernels->name, stereo, mono, speedup, identical ? "yes" : "NO");
+	}
+
+	delete[] referenceStereo;
+	delete[] referenceMono;
+	delete[] in;
+	delete[] out;
+
+	return allIdentical ? 0 : 1;
+}
@@ -26,11 +26,20 @@
 #include "common/stream.h"
 #include "common/util.h"
 #include "common/frac.h"
+#include "common/cpudetect.h"
 
 #include "graphics/primitives.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+#if defined(SCUMMVM_SSE2)
+#define GOB_SURFACE_SSE2
+#include <emmintrin.h>
+#elif defined(SCUMMVM_NEON)
+#define GOB_SURFACE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Gob {
 
 LBMLoader::LBMLoader(Common::SeekableReadStream &stream) : _parser(&stream),
@@ -400,6 +409,124 @@ bool Surface::clipBlitRect(int16 &left, int16 &top, int16 &right, int16 &bottom,
 	return true;
 }
 
+#pragma mark -
+#pragma mark --- Blit kernels ---
+#pragma mark -
+
+// The blit kernels are templated on the pixel type, uint8 or uint16, so
+// that the color depth doesn't need to be checked for every pixel.
+
+#if defined(GOB_SURFACE_SSE2)
+
+static inline bool hasSIMD() {
+	return Common::hasCPUFeature(Common::kCPUFeatureSSE2);
+}
+
+static inline void blitVectorTransparent(uint8 *dst, const uint8 *src, uint8 transp) {
+	const __m128i s    = _mm_loadu_si128((const __m128i *) src);
+	const __m128i mask = _mm_cmpeq_epi8(s, _mm_set1_epi8((char) transp));
+	const __m128i d    = _mm_loadu_si128((const __m128i *) dst);
+
+	_mm_storeu_si128((__m128i *) dst, _mm_or_si128(_mm_and_si128(mask, d), _mm_andnot_si128(mask, s)));
+}
+
+static inline void blitVectorTransparent(uint16 *dst, const uint16 *src, uint16 transp) {
+	const __m128i s    = _mm_loadu_si128((const __m128i *) src);
+	const __m128i mask = _mm_cmpeq_epi16(s, _mm_set1_epi16((short) transp));
+	const __m128i d    = _mm_loadu_si128((const __m128i *) dst);
+
+	_mm_storeu_si128((__m128i *) dst, _mm_or_si128(_mm_and_si128(mask, d), _mm_andnot_si128(mask, s)));
+}
+
+#elif defined(GOB_SURFACE_NEON)
+
+static inline bool hasSIMD() {
+	return Common::hasCPUFeature(Common::kCPUFeatureNEON);
+}
+
+static inline void blitVectorTransparent(uint8 *dst, const uint8 *src, uint8 transp) {
+	const uint8x16_t s = vld1q_u8(src);
+
+	vst1q_u8(dst, vbslq_u8(vceqq_u8(s, vdupq_n_u8(transp)), vld1q_u8(dst), s));
+}
+
+static inline void blitVectorTransparent(uint16 *dst, const uint16 *src, uint16 transp) {
+	const uint16x8_t s = vld1q_u16(src);
+
+	vst1q_u16(dst, vbslq_u16(vceqq_u16(s, vdupq_n_u16(transp)), vld1q_u16(dst), s));
+}
+
+#else
+
+static inline bool hasSIMD() {
+	return false;
+}
+
+template<typename T>
+static inline void blitVectorTransparent(T *dst, const T *src, T transp) {
+}
+
+#endif
+
+/** Copy a row of pixels, leaving out the ones with the transparent color. */
+template<typename T>
+static void blitRowTransparent(T *dst, const T *src, uint16 width, T transp, bool simd) {
+	// The SIMD path handles 16 bytes at once, so it can only be used when
+	// the rows don't overlap. Otherwise, we have to go from left to right.
+	const uint16 vectorWidth = 16 / sizeof(T);
+	if (simd && ((dst + width <= src) || (src + width <= dst))) {
+		for (; width >= vectorWidth; width -= vectorWidth, dst += vectorWidth, src += vectorWidth)
+			blitVectorTransparent(dst, src, transp);
+	}
+
+	for (; width > 0; width--, dst++, src++)
+		if (*src != transp)
+			*dst = *src;
+}
+
+template<typename T>
+static void blitTransparent(byte *dst, const byte *src, uint16 dstWidth, uint16 srcWidth,
+		uint16 width, uint16 height, T transp) {
+
+	const bool simd = hasSIMD();
+
+	while (height-- > 0) {
+		blitRowTransparent<T>((T *) dst, (const T *) src, width, transp, simd);
+
+		dst += dstWidth * sizeof(T);
+		src += srcWidth * sizeof(T);
+	}
+}
+
+template<typename T, bool transparent>
+static void blitScaledRect(byte *dst, const byte *src, uint16 dstWidth, uint16 srcWidth,
+		uint16 width, uint16 height, frac_t step, T transp) {
+
+	frac_t posH = 0;
+	while (height-- > 0) {
+		      T *dstRow = (T *) dst;
+		const T *srcRow = (const T *) src;
+
+		frac_t posW = 0;
+		for (uint16 i = 0; i < width; i++, dstRow++) {
+			if (!transparent || (*srcRow != transp))
+				*dstRow = *srcRow;
+
+			posW   += step;
+			srcRow += posW >> FRAC_BITS;
+			posW   &= FRAC_LO_MASK;
+		}
+
+		posH += step;
+		src  += (posH >> FRAC_BITS) * srcWidth * sizeof(T);
+		posH &= FRAC_LO_MASK;
+
+		dst += dstWidth * sizeof(T);
+	}
+}
+
+#pragma mark -
+
 void Surface::blit(const Surface &from, int16 left, int16 top, int16 right, int16 bottom,
 		int16 x, int16 y, int32 transp) {
 
@@ -418,7 +545,10 @@ void Surface::blit(const Surface &from, int16 left, int16 top, int16 right, int1
 		// Nothing to do
 		return;
 
-	if ((left == 0) && (_width == from._width) && (_width == width) && (transp == -1)) {
+	// A transparent color that can't occur in the source means no transparency
+	const bool noTransp = (transp < 0) || (transp > ((_bpp == 1) ? 0xFF : 0xFFFF));
+
+	if ((left == 0) && (_width == from._width) && (_width == width) && noTransp) {
 		// If these conditions are met, we can directly use memmove
 
 		// Pointers to the blit destination and source start points
@@ -429,7 +559,7 @@ void Surface::blit(const Surface &from, int16 left, int16 top, int16 right, int1
 		return;
 	}
 
-	if (transp == -1) {
+	if (noTransp) {
 		// We don't have to look for transparency => we can use memmove line-wise
 
 		// Pointers to the blit destination and source start points
@@ -446,23 +576,16 @@ void Surface::blit(const Surface &from, int16 left, int16 top, int16 right, int1
 		return;
 	}
 
-	// Otherwise, we have to copy by pixel
+	// Otherwise, we have to copy by pixel, leaving out the transparent ones
 
 	// Pointers to the blit destination and source start points
-	     Pixel dst =      get(x   , y);
-	ConstPixel src = from.get(left, top);
-
-	while (height-- > 0) {
-		     Pixel dstRow = dst;
-		ConstPixel srcRow = src;
-
-		for (uint16 i = 0; i < width; i++, dstRow++, srcRow++)
-			if (srcRow.get() != ((uint32) transp))
-				dstRow.set(srcRow.get());
+	      byte *dst =      getData(x   , y);
+	const byte *src = from.getData(left, top);
 
-		dst +=      _width;
-		src += from._width;
-	}
+	if (_bpp == 1)
+		blitTransparent<uint8>(dst, src, _width, from._width, width, height, transp);
+	else
+		blitTransparent<uint16>(dst, src, _width, from._width, width, height, transp);
 }
 
 void Surface::blit(const Surface &from, int16 x, int16 y, int32 transp) {
@@ -512,32 +635,17 @@ void Surface::blitScaled(const Surface &from, int16 left, int16 top, int16 right
 
 	frac_t step = scale.getInverse().toFrac();
 
-	frac_t posW = 0, posH = 0;
-	while (height-- > 0) {
-		      byte *dstRow = dst;
-		const byte *srcRow = src;
-
-		posW = 0;
-
-		for (uint16 i = 0; i < width; i++, dstRow += _bpp) {
-			memmove(dstRow, srcRow, _bpp);
-
-			posW += step;
-			while (posW >= ((frac_t) FRAC_ONE)) {
-				srcRow += from._bpp;
-				posW   -= FRAC_ONE;
-			}
-		}
-
-		posH += step;
-		while (posH >= ((frac_t) FRAC_ONE)) {
-			src  += from._width * from._bpp;
-			posH -= FRAC_ONE;
-		}
-
-		dst += _width * _bpp;
+	if (_bpp == 1) {
+		if ((transp < 0) || (transp > 0xFF))
+			blitScaledRect<uint8, false>(dst, src, _width, from._width, width, height, step, 0);
+		else
+			blitScaledRect<uint8, true >(dst, src, _width, from._width, width, height, step, transp);
+	} else {
+		if ((transp < 0) || (transp > 0xFFFF))
+			blitScaledRect<uint16, false>(dst, src, _width, from._width, width, height, step, 0);
+		else
+			blitScaledRect<uint16, true >(dst, src, _width, from._width, width, height, step, transp);
 	}
-
 }
 
 void Surface::blitScaled(const Surface &from, int16 x, int16 y, Common::Rational scale, int32 transp) {
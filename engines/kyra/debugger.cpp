@@ -26,6 +26,7 @@
 #include "kyra/timer.h"
 #include "kyra/resource.h"
 #include "kyra/lol.h"
+#include "kyra/screen_lol.h"
 
 #include "common/system.h"
 
@@ -450,6 +451,69 @@ bool Debugger_HoF::cmd_passcodes(int argc, const char **argv) {
 
 #ifdef ENABLE_LOL
 Debugger_LoL::Debugger_LoL(LoLEngine *vm) : Debugger(vm), _vm(vm) {
+	DCmd_Register("shape_bench",		WRAP_METHOD(Debugger_LoL, cmd_shapeBenchmark));
+}
+
+bool Debugger_LoL::cmd_shapeBenchmark(int argc, const char **argv) {
+	if (!_vm->_currentLevel) {
+		DebugPrintf("This command only works in the dungeon.\n");
+		return true;
+	}
+
+	const int iterations = (argc > 1) ? MAX(atoi(argv[1]), 1) : 100;
+	const int page = _vm->_sceneDrawPage1;
+	Screen *screen = _vm->_screen;
+
+	uint8 *backup = new uint8[320 * 200];
+	uint8 *background = new uint8[320 * 200];
+	uint8 *result = new uint8[320 * 200];
+	screen->copyRegionToBuffer(page, 0, 0, 320, 200, backup);
+
+	// Record the shapes drawn for the current dungeon frame
+	_vm->generateBlockDrawingBuffer();
+	_vm->drawVcnBlocks();
+	screen->copyRegionToBuffer(page, 0, 0, 320, 200, background);
+
+	screen->startShapeRecording();
+	_vm->drawSceneShapes();
+	screen->stopShapeRecording();
+
+	DebugPrintf("Replaying %d shapes %d times\n", screen->getNumRecordedShapes(), iterations);
+
+	// Replay them with the generic and the specialized line functions, and
+	// check that both draw the same frame
+	bool identical = true;
+	for (int specialized = 0; specialized < 2; ++specialized) {
+		screen->setShapeLineSpecialization(specialized != 0);
+
+		screen->copyBlockToPage(page, 0, 0, 320, 200, background);
+		screen->replayShapeRecording();
+
+		if (!specialized) {
+			screen->copyRegionToBuffer(page, 0, 0, 320, 200, result);
+		} else {
+			screen->copyRegionToBuffer(page, 0, 0, 320, 200, background);
+			identical = !memcmp(result, background, 320 * 200);
+		}
+
+		const uint32 startTime = g_system->getMillis();
+		for (int i = 0; i < iterations; ++i)
+			screen->replayShapeRecording();
+		const uint32 time = g_system->getMillis() - startTime;
+
+		DebugPrintf("%s line functions: %d ms (%d us per frame)\n", specialized ? "Specialized" : "Generic",
+		            time, time * 1000 / iterations);
+	}
+
+	DebugPrintf("Output of both is %s\n", identical ? "identical" : "DIFFERENT");
+
+	screen->setShapeLineSpecialization(true);
+	screen->copyBlockToPage(page, 0, 0, 320, 200, backup);
+
+	delete[] backup;
+	delete[] background;
+	delete[] result;
+	return true;
 }
 #endif // ENABLE_LOL
 
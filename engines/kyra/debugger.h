@@ -100,6 +100,8 @@ public:
 
 protected:
 	LoLEngine *_vm;
+
+	bool cmd_shapeBenchmark(int argc, const char **argv);
 };
 #endif // ENABLE_LOL
 
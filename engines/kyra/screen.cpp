@@ -46,6 +46,8 @@ Screen::Screen(KyraEngine_v1 *vm, OSystem *system)
 	_drawShapeVar3 = 1;
 	_drawShapeVar4 = 0;
 	_drawShapeVar5 = 0;
+	_dsSpecializedLines = true;
+	_dsRecord = false;
 
 	memset(_fonts, 0, sizeof(_fonts));
 
@@ -1298,6 +1300,35 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 	if ((flags & 0x2000) && _vm->game() != GI_KYRA1)
 		_dsTable5 = va_arg(args, uint8 *);
 
+	va_end(args);
+
+	if (_dsRecord) {
+		DsRecordedShape shape;
+		shape.pageNum = pageNum;
+		shape.shapeData = shapeData;
+		shape.x = x;
+		shape.y = y;
+		shape.sd = sd;
+		shape.flags = flags;
+		shape.table = _dsTable;
+		shape.tableLoopCount = _dsTableLoopCount;
+		shape.table2 = _dsTable2;
+		shape.table3 = _dsTable3;
+		shape.table4 = _dsTable4;
+		shape.table5 = _dsTable5;
+		shape.drawLayer = _dsDrawLayer;
+		shape.scaleW = _dsScaleW;
+		shape.scaleH = _dsScaleH;
+		shape.var3 = _drawShapeVar3;
+		shape.var4 = _drawShapeVar4;
+		shape.var5 = _drawShapeVar5;
+		_dsRecording.push_back(shape);
+	}
+
+	drawShapeIntern(pageNum, shapeData, x, y, sd, flags);
+}
+
+void Screen::drawShapeIntern(uint8 pageNum, const uint8 *shapeData, int x, int y, int sd, int flags) {
 	static const DsMarginSkipFunc dsMarginFunc[] = {
 		&Screen::drawShapeMarginNoScaleUpwind,
 		&Screen::drawShapeMarginNoScaleDownwind,
@@ -1320,17 +1351,6 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 		&Screen::drawShapeSkipScaleDownwind
 	};
 
-	static const DsLineFunc dsLineFunc[] = {
-		&Screen::drawShapeProcessLineNoScaleUpwind,
-		&Screen::drawShapeProcessLineNoScaleDownwind,
-		&Screen::drawShapeProcessLineNoScaleUpwind,
-		&Screen::drawShapeProcessLineNoScaleDownwind,
-		&Screen::drawShapeProcessLineScaleUpwind,
-		&Screen::drawShapeProcessLineScaleDownwind,
-		&Screen::drawShapeProcessLineScaleUpwind,
-		&Screen::drawShapeProcessLineScaleDownwind
-	};
-
 	static const DsPlotFunc dsPlotFunc[] = {
 		&Screen::drawShapePlotType0,		// used by Kyra 1 + 2
 		&Screen::drawShapePlotType1,		// used by Kyra 3
@@ -1370,7 +1390,6 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 	const int drawFunc = flags & 0x0f;
 	_dsProcessMargin = dsMarginFunc[drawFunc];
 	_dsScaleSkip = dsSkipFunc[drawFunc];
-	_dsProcessLine = dsLineFunc[drawFunc];
 
 	const int ppc = (flags >> 8) & 0x3F;
 	_dsPlot = dsPlotFunc[ppc];
@@ -1383,10 +1402,13 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 			warning("Missing drawShape plotting method type %d", ppc);
 		if (dsPlot3 != dsPlot2 && !dsPlot3)
 			warning("Missing drawShape plotting method type %d", (((flags >> 8) & 0xF7) & 0x3F));
-		va_end(args);
 		return;
 	}
 
+	DsLineFunc dsLine2 = getDrawShapeLineFunc(ppc, drawFunc), dsLine3 = dsLine2;
+	if (flags & 0x800)
+		dsLine3 = getDrawShapeLineFunc(((flags >> 8) & 0xF7) & 0x3F, drawFunc);
+
 	int curY = y;
 	const uint8 *src = shapeData;
 	uint8 *dst = _dsDstPage = getPagePtr(pageNum);
@@ -1417,7 +1439,6 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 		shpWidthScaled1 = shpWidthScaled2 = (shapeWidth * _dsScaleW) >> 8;
 
 		if (!shapeHeight || !shpWidthScaled1) {
-			va_end(args);
 			return;
 		}
 	}
@@ -1449,7 +1470,6 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 	if (t < 0) {
 		shapeHeight += t;
 		if (shapeHeight <= 0) {
-			va_end(args);
 			return;
 		}
 
@@ -1484,7 +1504,6 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 
 	t = (flags & 2) ? y + shapeHeight - y1 : y2 - y;
 	if (t <= 0) {
-		va_end(args);
 		return;
 	}
 
@@ -1499,7 +1518,6 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 		shpWidthScaled1 += x;
 		_dsOffscreenLeft = -x;
 		if (_dsOffscreenLeft >= shpWidthScaled2) {
-			va_end(args);
 			return;
 		}
 		x = 0;
@@ -1509,7 +1527,6 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 	t = x2 - x;
 
 	if (t <= 0) {
-		va_end(args);
 		return;
 	}
 
@@ -1575,6 +1592,7 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 					if (flags & 0x800)
 						normalPlot = (curY > _maskMinY && curY < _maskMaxY);
 					_dsPlot = normalPlot ? dsPlot2 : dsPlot3;
+					_dsProcessLine = normalPlot ? dsLine2 : dsLine3;
 					(this->*_dsProcessLine)(d, src, cnt, scaleState);
 				}
 				cnt += _dsOffscreenRight;
@@ -1591,8 +1609,36 @@ void Screen::drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int
 			scaleCounterV -= 0x100;
 		} while (scaleCounterV & 0xFF00);
 	}
+}
 
-	va_end(args);
+void Screen::startShapeRecording() {
+	_dsRecording.clear();
+	_dsRecord = true;
+}
+
+void Screen::stopShapeRecording() {
+	_dsRecord = false;
+}
+
+void Screen::replayShapeRecording() {
+	for (uint i = 0; i < _dsRecording.size(); ++i) {
+		const DsRecordedShape &shape = _dsRecording[i];
+
+		_dsTable = shape.table;
+		_dsTableLoopCount = shape.tableLoopCount;
+		_dsTable2 = shape.table2;
+		_dsTable3 = shape.table3;
+		_dsTable4 = shape.table4;
+		_dsTable5 = shape.table5;
+		_dsDrawLayer = shape.drawLayer;
+		_dsScaleW = shape.scaleW;
+		_dsScaleH = shape.scaleH;
+		_drawShapeVar3 = shape.var3;
+		_drawShapeVar4 = shape.var4;
+		_drawShapeVar5 = shape.var5;
+
+		drawShapeIntern(shape.pageNum, shape.shapeData, shape.x, shape.y, shape.sd, shape.flags);
+	}
 }
 
 int Screen::drawShapeMarginNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt) {
@@ -1705,12 +1751,13 @@ int Screen::drawShapeSkipScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt)
 	return found ? 0 : _dsOffscreenScaleVal1;
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
 	do {
 		uint8 c = *src++;
 		if (c) {
 			uint8 *d = dst++;
-			(this->*_dsPlot)(d, c);
+			(this->*plot)(d, c);
 			cnt--;
 		} else {
 			c = *src++;
@@ -1720,12 +1767,13 @@ void Screen::drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, i
 	} while (cnt > 0);
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
 	do {
 		uint8 c = *src++;
 		if (c) {
 			uint8 *d = dst--;
-			(this->*_dsPlot)(d, c);
+			(this->*plot)(d, c);
 			cnt--;
 		} else {
 			c = *src++;
@@ -1735,6 +1783,7 @@ void Screen::drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src,
 	} while (cnt > 0);
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState) {
 	int c = 0;
 
@@ -1754,7 +1803,7 @@ void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int
 				scaleState = r & 0xff;
 			}
 		} else if (scaleState) {
-			(this->*_dsPlot)(dst++, c);
+			(this->*plot)(dst++, c);
 			scaleState -= 0x100;
 			cnt--;
 		}
@@ -1763,6 +1812,7 @@ void Screen::drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int
 	cnt = -1;
 }
 
+template<Screen::DsPlotFunc plot>
 void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState) {
 	int c = 0;
 
@@ -1782,7 +1832,7 @@ void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, i
 				scaleState = r & 0xff;
 			}
 		} else {
-			(this->*_dsPlot)(dst--, c);
+			(this->*plot)(dst--, c);
 			scaleState -= 0x100;
 			cnt--;
 		}
@@ -1791,6 +1841,60 @@ void Screen::drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, i
 	cnt = -1;
 }
 
+Screen::DsLineFunc Screen::getDrawShapeLineFunc(int plotType, int drawFunc) {
+	static const DsLineFunc dsLineFunc[] = {
+		&Screen::drawShapeProcessLineNoScaleUpwind<&Screen::drawShapePlotDynamic>,
+		&Screen::drawShapeProcessLineNoScaleDownwind<&Screen::drawShapePlotDynamic>,
+		&Screen::drawShapeProcessLineNoScaleUpwind<&Screen::drawShapePlotDynamic>,
+		&Screen::drawShapeProcessLineNoScaleDownwind<&Screen::drawShapePlotDynamic>,
+		&Screen::drawShapeProcessLineScaleUpwind<&Screen::drawShapePlotDynamic>,
+		&Screen::drawShapeProcessLineScaleDownwind<&Screen::drawShapePlotDynamic>,
+		&Screen::drawShapeProcessLineScaleUpwind<&Screen::drawShapePlotDynamic>,
+		&Screen::drawShapeProcessLineScaleDownwind<&Screen::drawShapePlotDynamic>
+	};
+
+#define DS_LINE_FUNCS(type, plot) \
+	{ type, { \
+		&Screen::drawShapeProcessLineNoScaleUpwind<&Screen::plot>, \
+		&Screen::drawShapeProcessLineNoScaleDownwind<&Screen::plot>, \
+		&Screen::drawShapeProcessLineScaleUpwind<&Screen::plot>, \
+		&Screen::drawShapeProcessLineScaleDownwind<&Screen::plot> \
+	} }
+
+	static const struct {
+		int plotType;
+		DsLineFunc funcs[4];
+	} dsSpecializedLineFunc[] = {
+		DS_LINE_FUNCS(0, drawShapePlotType0),
+		DS_LINE_FUNCS(1, drawShapePlotType1),
+		DS_LINE_FUNCS(4, drawShapePlotType4),
+		DS_LINE_FUNCS(8, drawShapePlotType8),
+		DS_LINE_FUNCS(9, drawShapePlotType9),
+		DS_LINE_FUNCS(12, drawShapePlotType12),
+		DS_LINE_FUNCS(33, drawShapePlotType33),
+		DS_LINE_FUNCS(37, drawShapePlotType37),
+		DS_LINE_FUNCS(48, drawShapePlotType48),
+		DS_LINE_FUNCS(52, drawShapePlotType52)
+	};
+
+#undef DS_LINE_FUNCS
+
+	// Use a tight loop for the plot type if there is one, the dynamic
+	// dispatch otherwise
+	if (_dsSpecializedLines) {
+		for (int i = 0; i < ARRAYSIZE(dsSpecializedLineFunc); ++i) {
+			if (dsSpecializedLineFunc[i].plotType == plotType)
+				return dsSpecializedLineFunc[i].funcs[((drawFunc >> 1) & 2) | (drawFunc & 1)];
+		}
+	}
+
+	return dsLineFunc[drawFunc];
+}
+
+void Screen::drawShapePlotDynamic(uint8 *dst, uint8 cmd) {
+	(this->*_dsPlot)(dst, cmd);
+}
+
 void Screen::drawShapePlotType0(uint8 *dst, uint8 cmd) {
 	*dst = cmd;
 }
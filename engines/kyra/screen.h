@@ -432,6 +432,13 @@ public:
 
 	void drawShape(uint8 pageNum, const uint8 *shapeData, int x, int y, int sd, int flags, ...);
 
+	// shape drawing benchmark
+	void startShapeRecording();
+	void stopShapeRecording();
+	uint getNumRecordedShapes() const { return _dsRecording.size(); }
+	void replayShapeRecording();
+	void setShapeLineSpecialization(bool enable) { _dsSpecializedLines = enable; }
+
 	// mouse handling
 	void hideMouse();
 	void showMouse();
@@ -546,16 +553,29 @@ protected:
 	KyraEngine_v1 *_vm;
 
 	// shape
+	typedef int (Screen::*DsMarginSkipFunc)(uint8 *&dst, const uint8 *&src, int &cnt);
+	typedef void (Screen::*DsLineFunc)(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	typedef void (Screen::*DsPlotFunc)(uint8 *dst, uint8 cmd);
+
+	void drawShapeIntern(uint8 pageNum, const uint8 *shapeData, int x, int y, int sd, int flags);
+
 	int drawShapeMarginNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeMarginNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeMarginScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeMarginScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeSkipScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt);
 	int drawShapeSkipScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt);
-	void drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
-	void drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
-	void drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
-	void drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+
+	// The line functions are instantiated for the most common plot types,
+	// so that the plotting can be inlined. drawShapePlotDynamic is used for
+	// all other plot types; it calls the plot function in _dsPlot.
+	template<DsPlotFunc plot> void drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	template<DsPlotFunc plot> void drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	template<DsPlotFunc plot> void drawShapeProcessLineScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	template<DsPlotFunc plot> void drawShapeProcessLineScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
+	DsLineFunc getDrawShapeLineFunc(int plotType, int drawFunc);
+
+	void drawShapePlotDynamic(uint8 *dst, uint8 cmd);
 
 	void drawShapePlotType0(uint8 *dst, uint8 cmd);
 	void drawShapePlotType1(uint8 *dst, uint8 cmd);
@@ -577,10 +597,6 @@ protected:
 	void drawShapePlotType48(uint8 *dst, uint8 cmd);
 	void drawShapePlotType52(uint8 *dst, uint8 cmd);
 
-	typedef int (Screen::*DsMarginSkipFunc)(uint8 *&dst, const uint8 *&src, int &cnt);
-	typedef void (Screen::*DsLineFunc)(uint8 *&dst, const uint8 *&src, int &cnt, int16 scaleState);
-	typedef void (Screen::*DsPlotFunc)(uint8 *dst, uint8 cmd);
-
 	DsMarginSkipFunc _dsProcessMargin;
 	DsMarginSkipFunc _dsScaleSkip;
 	DsLineFunc _dsProcessLine;
@@ -605,6 +621,23 @@ protected:
 	int _drawShapeVar3;
 	int _drawShapeVar4;
 	int _drawShapeVar5;
+	bool _dsSpecializedLines;
+
+	// The state set up by the arguments of a drawShape() call
+	struct DsRecordedShape {
+		uint8 pageNum;
+		const uint8 *shapeData;
+		int x, y, sd, flags;
+		const uint8 *table;
+		int tableLoopCount;
+		const uint8 *table2, *table3, *table4, *table5;
+		int drawLayer;
+		int scaleW, scaleH;
+		int var3, var4, var5;
+	};
+
+	Common::Array<DsRecordedShape> _dsRecording;
+	bool _dsRecord;
 
 	// AMIGA version
 	bool _interfacePaletteEnabled;
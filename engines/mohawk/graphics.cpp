@@ -100,7 +100,22 @@ void MohawkSurface::convertToTrueColor() {
 	_surface = surface;
 }
 
-GraphicsManager::GraphicsManager() {
+// Default memory budget for the image cache. This holds a few dozen
+// full screen Riven images.
+static const uint32 kDefaultCacheBudget = 32 * 1024 * 1024;
+
+static uint32 getSurfaceMemorySize(const MohawkSurface *surface) {
+	uint32 size = sizeof(MohawkSurface);
+
+	if (surface->getSurface())
+		size += surface->getSurface()->pitch * surface->getSurface()->h;
+	if (surface->getPalette())
+		size += 256 * 3;
+
+	return size;
+}
+
+GraphicsManager::GraphicsManager() : _cacheSize(0), _cacheBudget(kDefaultCacheBudget), _cacheUseCounter(0), _cardFirstUse(1) {
 }
 
 GraphicsManager::~GraphicsManager() {
@@ -108,8 +123,8 @@ GraphicsManager::~GraphicsManager() {
 }
 
 void GraphicsManager::clearCache() {
-	for (Common::HashMap<uint16, MohawkSurface*>::iterator it = _cache.begin(); it != _cache.end(); it++)
-		delete it->_value;
+	for (ImageCache::iterator it = _cache.begin(); it != _cache.end(); it++)
+		delete it->_value.surface;
 	for (Common::HashMap<uint16, Common::Array<MohawkSurface*> >::iterator it = _subImageCache.begin(); it != _subImageCache.end(); it++) {
 		Common::Array<MohawkSurface *> &array = it->_value;
 		for (uint i = 0; i < array.size(); i++)
@@ -117,19 +132,135 @@ void GraphicsManager::clearCache() {
 	}
 
 	_cache.clear();
+	_cacheSize = 0;
 	_subImageCache.clear();
+	_prefetchQueue.clear();
+}
+
+void GraphicsManager::setCacheBudget(uint32 bytes) {
+	_cacheBudget = bytes;
+	trimCache(-1);
 }
 
 MohawkSurface *GraphicsManager::findImage(uint16 id) {
-	if (!_cache.contains(id))
-		_cache[id] = decodeImage(id);
+	ImageCache::iterator it = _cache.find(id);
+
+	if (it != _cache.end()) {
+		it->_value.lastUse = ++_cacheUseCounter;
+		return it->_value.surface;
+	}
+
+	MohawkSurface *surface = decodeImage(id);
+	insertImage(id, surface, false, ++_cacheUseCounter);
+
+	// Make room for the new image. The image itself is kept even if it
+	// is larger than the budget, as the caller is about to use it.
+	trimCache(id);
+
+	return surface;
+}
+
+void GraphicsManager::insertImage(uint16 id, MohawkSurface *surface, bool pinned, uint32 lastUse) {
+	CacheEntry entry;
+	entry.surface = surface;
+	entry.size = getSurfaceMemorySize(surface);
+	entry.lastUse = lastUse;
+	entry.pinned = pinned;
+
+	_cache[id] = entry;
+	_cacheSize += entry.size;
+}
+
+void GraphicsManager::trimCache(int keep) {
+	while (_cacheSize > _cacheBudget && evictImage(keep, 0xFFFFFFFF))
+		;
+}
+
+bool GraphicsManager::evictImage(int keep, uint32 usedBefore) {
+	// Find the least recently used image
+	ImageCache::iterator victim = _cache.end();
+	for (ImageCache::iterator it = _cache.begin(); it != _cache.end(); it++) {
+		if (it->_value.pinned || it->_key == keep || it->_value.lastUse >= usedBefore)
+			continue;
+
+		if (victim == _cache.end() || it->_value.lastUse < victim->_value.lastUse)
+			victim = it;
+	}
+
+	if (victim == _cache.end())
+		return false;
+
+	debug(3, "Evicting image %d from the cache", victim->_key);
+	_cacheSize -= victim->_value.size;
+	delete victim->_value.surface;
+	_cache.erase(victim);
+	return true;
+}
+
+bool GraphicsManager::makeRoomForPrefetch(uint32 size) {
+	// Images used on the current card are likely to be drawn again,
+	// so only the ones used before may be freed for a prefetched image
+	uint32 freeable = 0;
+	for (ImageCache::iterator it = _cache.begin(); it != _cache.end(); it++)
+		if (!it->_value.pinned && it->_value.lastUse < _cardFirstUse)
+			freeable += it->_value.size;
+
+	if (_cacheSize - freeable + size > _cacheBudget)
+		return false;
+
+	while (_cacheSize + size > _cacheBudget)
+		evictImage(-1, _cardFirstUse);
+
+	return true;
+}
+
+void GraphicsManager::prefetchImage(uint16 image) {
+	if (!_cache.contains(image))
+		_prefetchQueue.push_back(image);
+}
+
+void GraphicsManager::clearPrefetchQueue() {
+	_prefetchQueue.clear();
+}
+
+void GraphicsManager::beginCard() {
+	_prefetchQueue.clear();
+	_cardFirstUse = _cacheUseCounter + 1;
+}
+
+void GraphicsManager::runPrefetch(uint32 maxMillis) {
+	uint32 startTime = getVM()->_system->getMillis();
+
+	while (!_prefetchQueue.empty()) {
+		uint16 id = _prefetchQueue.front();
+		_prefetchQueue.pop_front();
+
+		if (_cache.contains(id) || !hasImage(id))
+			continue;
 
-	// TODO: Probably would be nice to limit the size of the cache
-	// Currently, this can't get large because it is freed on every
-	// card/stack change in Myst/Riven so I'm not worried about it.
-	// Doesn't mean this shouldn't be done in the future.
+		// Check the budget before spending the time to decode the image
+		if (!makeRoomForPrefetch(getImageMemorySize(id))) {
+			_prefetchQueue.clear();
+			break;
+		}
+
+		MohawkSurface *surface = decodeImage(id);
+
+		// The estimate may have been too low
+		if (!makeRoomForPrefetch(getSurfaceMemorySize(surface))) {
+			delete surface;
+			_prefetchQueue.clear();
+			break;
+		}
 
-	return _cache[id];
+		debug(3, "Prefetched image %d", id);
+		// Count the image as used on the current card, so prefetching
+		// the card's other images doesn't push it out again
+		insertImage(id, surface, false, _cardFirstUse);
+
+		if (getVM()->_system->getMillis() - startTime >= maxMillis)
+			break;
+	}
 }
 
 Common::Array<MohawkSurface *> GraphicsManager::decodeImages(uint16 id) {
@@ -259,7 +390,7 @@ void GraphicsManager::addImageToCache(uint16 id, MohawkSurface *surface) {
 	if (_cache.contains(id))
 		error("Image %d already in cache", id);
 
-	_cache[id] = surface;
+	insertImage(id, surface, true, ++_cacheUseCounter);
 }
 
 #ifdef ENABLE_MYST
@@ -410,6 +541,37 @@ MohawkSurface *MystGraphics::decodeImage(uint16 id) {
 	return mhkSurface;
 }
 
+bool MystGraphics::hasImage(uint16 id) {
+	if (_vm->getFeatures() & GF_ME && _vm->getPlatform() == Common::kPlatformMacintosh && _pictureFile.picFile.isOpen()) {
+		for (uint32 i = 0; i < _pictureFile.pictureCount; i++)
+			if (_pictureFile.entries[i].id == id)
+				return true;
+	}
+
+	if (_vm->getFeatures() & GF_ME && _vm->hasResource(ID_PICT, id))
+		return true;
+
+	return _vm->hasResource(ID_WDIB, id);
+}
+
+uint32 MystGraphics::getImageMemorySize(uint16 id) {
+	uint16 width = 544;
+	uint16 height = 333;
+
+	// The WDIB images are compressed, so assume they fill the card area,
+	// unless the external picture file tells the size
+	if (_vm->getFeatures() & GF_ME && _vm->getPlatform() == Common::kPlatformMacintosh && _pictureFile.picFile.isOpen()) {
+		for (uint32 i = 0; i < _pictureFile.pictureCount; i++)
+			if (_pictureFile.entries[i].id == id) {
+				width = _pictureFile.entries[i].width;
+				height = _pictureFile.entries[i].height;
+				break;
+			}
+	}
+
+	return sizeof(MohawkSurface) + width * height * _pixelFormat.bytesPerPixel;
+}
+
 void MystGraphics::copyImageSectionToScreen(uint16 image, Common::Rect src, Common::Rect dest) {
 	Graphics::Surface *surface = findImage(image)->getSurface();
 
@@ -712,15 +874,32 @@ MohawkSurface *RivenGraphics::decodeImage(uint16 id) {
 	return surface;
 }
 
+bool RivenGraphics::hasImage(uint16 id) {
+	return _vm->hasResource(ID_TBMP, id);
+}
+
+uint32 RivenGraphics::getImageMemorySize(uint16 id) {
+	// The size is at the start of the bitmap header, see MohawkBitmap
+	Common::SeekableReadStream *stream = _vm->getResource(ID_TBMP, id);
+	uint16 width = stream->readUint16BE() & 0x3FFF;
+	uint16 height = stream->readUint16BE() & 0x3FFF;
+	delete stream;
+
+	// The images are converted to the screen format when decoding them
+	return sizeof(MohawkSurface) + width * height * _pixelFormat.bytesPerPixel;
+}
+
 void RivenGraphics::copyImageToScreen(uint16 image, uint32 left, uint32 top, uint32 right, uint32 bottom) {
 	Graphics::Surface *surface = findImage(image)->getSurface();
 
 	// Clip the width to fit on the screen. Fixes some images.
-	if (left + surface->w > 608)
-		surface->w = 608 - left;
+	// The cached surface is left alone, as it may be drawn elsewhere later.
+	uint16 width = surface->w;
+	if (left + width > 608)
+		width = 608 - left;
 
 	for (uint16 i = 0; i < surface->h; i++)
-		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), surface->w * surface->format.bytesPerPixel);
+		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), width * surface->format.bytesPerPixel);
 
 	_dirtyScreen = true;
 }
@@ -753,6 +932,20 @@ void RivenGraphics::drawPLST(uint16 x) {
 	delete plst;
 }
 
+void RivenGraphics::prefetchPLST() {
+	// Queue the images the card and hotspot scripts may activate later on
+	Common::SeekableReadStream* plst = _vm->getResource(ID_PLST, _vm->getCurCard());
+	uint16 recordCount = plst->readUint16BE();
+
+	for (uint16 i = 0; i < recordCount; i++) {
+		plst->readUint16BE(); // index
+		prefetchImage(plst->readUint16BE());
+		plst->skip(4 * 2); // left, top, right, bottom
+	}
+
+	delete plst;
+}
+
 void RivenGraphics::updateScreen(Common::Rect updateRect) {
 	if (_updatesEnabled) {
 		_vm->runUpdateScreenScript();
@@ -27,6 +27,7 @@
 
 #include "common/file.h"
 #include "common/hashmap.h"
+#include "common/list.h"
 #include "graphics/pict.h"
 
 namespace Graphics {
@@ -75,7 +76,25 @@ public:
 	// Free all surfaces in the cache
 	void clearCache();
 
+	// Limit the memory used by the cached images. Once the limit is
+	// exceeded, the least recently used images are freed.
+	void setCacheBudget(uint32 bytes);
+
 	void preloadImage(uint16 image);
+
+	// Queue an image to be decoded ahead of time by runPrefetch()
+	void prefetchImage(uint16 image);
+	void clearPrefetchQueue();
+
+	// Called when a new card is entered. Clears the prefetch queue, and
+	// lets prefetching free the images used before.
+	void beginCard();
+
+	// Decode queued images until maxMillis have passed. At least one
+	// image is decoded per call. Prefetched images only push out images
+	// which were not used since the current card was entered.
+	void runPrefetch(uint32 maxMillis);
+
 	virtual void setPalette(uint16 id);
 	void copyAnimImageToScreen(uint16 image, int left = 0, int top = 0);
 	void copyAnimImageSectionToScreen(uint16 image, Common::Rect src, Common::Rect dest);
@@ -94,13 +113,45 @@ protected:
 	virtual MohawkSurface *decodeImage(uint16 id) = 0;
 	virtual Common::Array<MohawkSurface *> decodeImages(uint16 id);
 
+	// hasImage tells whether decodeImage can decode the image. Images
+	// are only prefetched when this returns true.
+	virtual bool hasImage(uint16 id) { return false; }
+
+	// getImageMemorySize estimates the memory an image takes once it is
+	// decoded, without decoding it. Only called if hasImage returns true.
+	virtual uint32 getImageMemorySize(uint16 id) { return 0; }
+
 	virtual MohawkEngine *getVM() = 0;
+
+	// Images added this way are never freed before clearCache() is called
 	void addImageToCache(uint16 id, MohawkSurface *surface);
 
 private:
-	// An image cache that stores images until clearCache() is called
-	Common::HashMap<uint16, MohawkSurface*> _cache;
+	struct CacheEntry {
+		MohawkSurface *surface;
+		uint32 size;
+		uint32 lastUse;		// Prefetched images count as used when the card was entered
+		bool pinned;
+	};
+
+	typedef Common::HashMap<uint16, CacheEntry> ImageCache;
+
+	// An image cache that stores images until clearCache() is called,
+	// or until they are evicted to stay within the budget
+	ImageCache _cache;
+	uint32 _cacheSize;
+	uint32 _cacheBudget;
+	uint32 _cacheUseCounter;
+	uint32 _cardFirstUse;	// The value of _cacheUseCounter for the first image used on the current card
+
+	Common::List<uint16> _prefetchQueue;
+
 	Common::HashMap<uint16, Common::Array<MohawkSurface*> > _subImageCache;
+
+	void insertImage(uint16 id, MohawkSurface *surface, bool pinned, uint32 lastUse);
+	void trimCache(int keep);
+	bool evictImage(int keep, uint32 usedBefore);
+	bool makeRoomForPrefetch(uint32 size);
 };
 
 #ifdef ENABLE_MYST
@@ -132,6 +183,8 @@ public:
 
 protected:
 	MohawkSurface *decodeImage(uint16 id);
+	bool hasImage(uint16 id);
+	uint32 getImageMemorySize(uint16 id);
 	MohawkEngine *getVM() { return (MohawkEngine *)_vm; }
 	void simulatePreviousDrawDelay(const Common::Rect &dest);
 
@@ -181,6 +234,7 @@ public:
 	bool _updatesEnabled;
 	Common::Array<uint16> _activatedPLSTs;
 	void drawPLST(uint16 x);
+	void prefetchPLST();
 	void drawRect(Common::Rect rect, bool active);
 	void drawImageRect(uint16 id, Common::Rect srcRect, Common::Rect dstRect);
 	void drawExtrasImage(uint16 id, Common::Rect dstRect);
@@ -206,6 +260,8 @@ public:
 
 protected:
 	MohawkSurface *decodeImage(uint16 id);
+	bool hasImage(uint16 id);
+	uint32 getImageMemorySize(uint16 id);
 	MohawkEngine *getVM() { return (MohawkEngine *)_vm; }
 
 private:
@@ -370,6 +370,9 @@ Common::Error MohawkEngine_Myst::run() {
 			_needsUpdate = false;
 		}
 
+		// Decode the images of the cards the player may go to next
+		_gfx->runPrefetch(5);
+
 		// Cut down on CPU usage
 		_system->delayMillis(10);
 	}
@@ -568,6 +571,42 @@ uint16 MohawkEngine_Myst::getCardBackgroundId() {
 	return imageToDraw;
 }
 
+void MohawkEngine_Myst::prefetchAdjacentCards() {
+	for (uint16 i = 0; i < _resources.size(); i++) {
+		uint16 dest = _resources[i]->getDest();
+		if (dest == 0 || dest == _curCard || !hasResource(ID_VIEW, dest))
+			continue;
+
+		// Read the image block of the destination card, and queue
+		// the background the card would show now (see getCardBackgroundId)
+		Common::SeekableReadStream *viewStream = getResource(ID_VIEW, dest);
+		viewStream->readUint16LE(); // flags
+
+		uint16 imageToDraw = 0;
+		uint16 conditionalImageCount = viewStream->readUint16LE();
+		if (conditionalImageCount == 0)
+			imageToDraw = viewStream->readUint16LE();
+		else {
+			for (uint16 j = 0; j < conditionalImageCount; j++) {
+				uint16 var = viewStream->readUint16LE();
+				uint16 numStates = viewStream->readUint16LE();
+				uint16 varValue = _scriptParser->getVar(var);
+
+				for (uint16 k = 0; k < numStates; k++) {
+					uint16 value = viewStream->readUint16LE();
+					if (k == varValue)
+						imageToDraw = value;
+				}
+			}
+		}
+
+		delete viewStream;
+
+		if (imageToDraw)
+			_gfx->prefetchImage(imageToDraw);
+	}
+}
+
 void MohawkEngine_Myst::drawCardBackground() {
 	_gfx->copyImageToBackBuffer(getCardBackgroundId(), Common::Rect(0, 0, 544, 332));
 }
@@ -587,9 +626,10 @@ void MohawkEngine_Myst::changeToCard(uint16 card, bool updateScreen) {
 
 	unloadCard();
 
-	// Clear the resource cache and image cache
+	// Clear the resource cache. The image cache is only cleared on
+	// stack changes, so images are kept when going back to a card.
 	_cache.clear();
-	_gfx->clearCache();
+	_gfx->beginCard();
 
 	_curCard = card;
 
@@ -659,6 +699,9 @@ void MohawkEngine_Myst::changeToCard(uint16 card, bool updateScreen) {
 	_curResource = -1;
 	checkCurrentResource();
 
+	// Get the next cards' images ready
+	prefetchAdjacentCards();
+
 	// Debug: Show resource rects
 	if (_showResourceRects)
 		drawResourceRects();
@@ -213,6 +213,7 @@ private:
 
 	void loadCard();
 	void unloadCard();
+	void prefetchAdjacentCards();
 	void runInitScript();
 	void runExitScript();
 
@@ -279,6 +279,9 @@ void MohawkEngine_Riven::handleEvents() {
 	if (needsUpdate)
 		_system->updateScreen();
 
+	// Decode the images the card's scripts may draw later on
+	_gfx->runPrefetch(5);
+
 	// Cut down on CPU usage
 	_system->delayMillis(10);
 }
@@ -358,9 +361,9 @@ void MohawkEngine_Riven::changeToCard(uint16 dest) {
 	_curCard = dest;
 	debug (1, "Changing to card %d", _curCard);
 
-	// Clear the graphics cache (images typically aren't used
-	// on different cards).
-	_gfx->clearCache();
+	// The graphics cache is kept across cards, as the player often
+	// returns to cards visited before. It is bounded by its budget.
+	_gfx->beginCard();
 
 	if (!(getFeatures() & GF_DEMO)) {
 		for (byte i = 0; i < 13; i++)
@@ -394,6 +397,10 @@ void MohawkEngine_Riven::refreshCard() {
 	_gfx->updateScreen();
 	runCardScript(kCardOpenScript);
 
+	// Queue the card's other images to be decoded while idle
+	_gfx->clearPrefetchQueue();
+	_gfx->prefetchPLST();
+
 	// Activate the first sound list if none have been activated
 	if (!_activatedSLST)
 		_sound->playSLST(1, _curCard);
@@ -53,6 +53,7 @@
 #include "video/avi_decoder.h"
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
+#include "sci/graphics/frameout.h"
 #include "video/coktel_decoder.h"
 #include "sci/video/robot_decoder.h"
 #endif
@@ -80,6 +81,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	// Variables
 	DVar_Register("sleeptime_factor",	&g_debug_sleeptime_factor, DVAR_INT, 0);
 	DVar_Register("gc_interval",		&engine->_gamestate->scriptGCInterval, DVAR_INT, 0);
+	DVar_Register("gc_slice",			&engine->_gamestate->scriptGCSlice, DVAR_INT, 0);
 	DVar_Register("simulated_key",		&g_debug_simulated_key, DVAR_INT, 0);
 	DVar_Register("track_mouse_clicks",	&g_debug_track_mouse_clicks, DVAR_BOOL, 0);
 	DVar_Register("script_abort_flag",	&_engine->_gamestate->abortScriptProcessing, DVAR_INT, 0);
@@ -108,6 +110,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("resource_id",		WRAP_METHOD(Console, cmdResourceId));
 	DCmd_Register("resource_info",		WRAP_METHOD(Console, cmdResourceInfo));
 	DCmd_Register("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
+	DCmd_Register("resource_stats",		WRAP_METHOD(Console, cmdResourceStats));
 	DCmd_Register("list",				WRAP_METHOD(Console, cmdList));
 	DCmd_Register("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	DCmd_Register("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
@@ -122,6 +125,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	// Graphics
 	DCmd_Register("show_map",			WRAP_METHOD(Console, cmdShowMap));
 	DCmd_Register("set_palette",		WRAP_METHOD(Console, cmdSetPalette));
+	DCmd_Register("palvary_bench",		WRAP_METHOD(Console, cmdPalVaryBenchmark));
+	DCmd_Register("frameout_damage",	WRAP_METHOD(Console, cmdFrameoutDamage));
 	DCmd_Register("draw_pic",			WRAP_METHOD(Console, cmdDrawPic));
 	DCmd_Register("draw_cel",			WRAP_METHOD(Console, cmdDrawCel));
 	DCmd_Register("undither",           WRAP_METHOD(Console, cmdUndither));
@@ -144,6 +149,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	DCmd_Register("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	DCmd_Register("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	DCmd_Register("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	DCmd_Register("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	DCmd_Register("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -199,6 +205,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	DCmd_Register("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	DCmd_Register("vm_profile",			WRAP_METHOD(Console, cmdVMProfile));
 	DCmd_Register("vm_varlist",			WRAP_METHOD(Console, cmdVMVarlist));
 	DCmd_Register("vmvarlist",			WRAP_METHOD(Console, cmdVMVarlist));				// alias
 	DCmd_Register("vl",					WRAP_METHOD(Console, cmdVMVarlist));				// alias
@@ -223,6 +230,9 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	_debugState.breakpointWasHit = false;
 	_debugState._breakpoints.clear(); // No breakpoints defined
 	_debugState._activeBreakpointTypes = 0;
+	_debugState._opcodeProfiling = false;
+	memset(_debugState._opcodeCounts, 0, sizeof(_debugState._opcodeCounts));
+	_debugState._profileStartTime = 0;
 }
 
 Console::~Console() {
@@ -233,6 +243,7 @@ void Console::preEnter() {
 }
 
 extern void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState);
+extern const char *opcodeNames[]; // from scriptdebug.cpp
 
 void Console::postEnter() {
 	if (!_videoFile.empty()) {
@@ -306,6 +317,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf("---------\n");
 	DebugPrintf("sleeptime_factor: Factor to multiply with wait times in kWait()\n");
 	DebugPrintf("gc_interval: Number of kernel calls in between garbage collections\n");
+	DebugPrintf("gc_slice: Number of references marked per kernel call by incremental garbage collections, 0 to stop the world\n");
 	DebugPrintf("simulated_key: Add a key with the specified scan code to the event list\n");
 	DebugPrintf("track_mouse_clicks: Toggles mouse click tracking to the console\n");
 	DebugPrintf("weak_validations: Turns some validation errors into warnings\n");
@@ -342,6 +354,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" resource_id - Identifies a resource number by splitting it up in resource type and resource number\n");
 	DebugPrintf(" resource_info - Shows info about a resource\n");
 	DebugPrintf(" resource_types - Shows the valid resource types\n");
+	DebugPrintf(" resource_stats - Shows statistics of the resource cache\n");
 	DebugPrintf(" list - Lists all the resources of a given type\n");
 	DebugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	DebugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
@@ -358,6 +371,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf("Graphics:\n");
 	DebugPrintf(" show_map - Switches to visual, priority, control or display screen\n");
 	DebugPrintf(" set_palette - Sets a palette resource\n");
+	DebugPrintf(" palvary_bench - Times the color matching during a PalVary transition\n");
+	DebugPrintf(" frameout_damage - Shows statistics about and outlines the regions redrawn by kFrameout (SCI32)\n");
 	DebugPrintf(" draw_pic - Draws a pic resource\n");
 	DebugPrintf(" draw_cel - Draws a cel from a view resource\n");
 	DebugPrintf(" pic_visualize - Enables visualization of the drawing process of EGA pictures\n");
@@ -376,6 +391,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	DebugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	DebugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	DebugPrintf(" gc_stats - Shows pause times and reclaimed entities of the garbage collections\n");
 	DebugPrintf("\n");
 	DebugPrintf("Music/SFX:\n");
 	DebugPrintf(" songlib - Shows the song library\n");
@@ -417,6 +433,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf("\n");
 	DebugPrintf("VM:\n");
 	DebugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	DebugPrintf(" vm_profile - Counts the executed opcodes and shows the selector cache statistics\n");
 	DebugPrintf(" vm_varlist / vmvarlist / vl - Shows the addresses of variables in the VM\n");
 	DebugPrintf(" vm_vars / vmvars / vv - Displays or changes variables in the VM\n");
 	DebugPrintf(" stack - Lists the specified number of stack elements\n");
@@ -781,6 +798,78 @@ bool Console::cmdResourceTypes(int argc, const char **argv) {
 	return true;
 }
 
+static const char *const s_compressionNames[] = {
+	"None", "LZW", "Huffman", "LZW1", "LZW1View", "LZW1Pic",
+#ifdef ENABLE_SCI32
+	"STACpack",
+#endif
+	"DCL"
+};
+
+bool Console::cmdResourceStats(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			resMan->resetStats();
+			if (_engine->_gfxCache)
+				_engine->_gfxCache->resetStats();
+			DebugPrintf("Resource statistics reset\n");
+		} else {
+			DebugPrintf("Shows statistics of the resource cache\n");
+			DebugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	DebugPrintf("Unlocked resources: %d of %d bytes, locked resources: %d bytes\n",
+	            resMan->getLRUMemory(), resMan->getMaxMemory(), resMan->getLockedMemory());
+	DebugPrintf("Compressed cache: %d resources, %d of %d bytes\n",
+	            resMan->getPackedCount(), resMan->getPackedMemory(), resMan->getMaxPackedMemory());
+
+	DebugPrintf("\n%-14s %8s %8s %8s %8s %9s %9s\n", "Type", "Hits", "Misses", "Packed", "Evicted", "Hit rate", "Memory");
+	uint32 hits = 0, misses = 0;
+	for (int i = 0; i < kResourceTypeInvalid; i++) {
+		const ResourceType type = (ResourceType)i;
+		const ResourceManager::TypeStats &stats = resMan->getTypeStats(type);
+		if (!stats.hits && !stats.misses && !resMan->getLRUMemory(type))
+			continue;
+
+		hits += stats.hits;
+		misses += stats.misses;
+		const uint32 total = stats.hits + stats.misses;
+		DebugPrintf("%-14s %8d %8d %8d %8d %8d%% %9d\n", getResourceTypeName(type),
+		            stats.hits, stats.misses, stats.packedHits, stats.evictions,
+		            total ? stats.hits * 100 / total : 0, resMan->getLRUMemory(type));
+	}
+	if (hits + misses)
+		DebugPrintf("Total hit rate: %d%%\n", hits * 100 / (hits + misses));
+
+	DebugPrintf("\n%-14s %8s %10s %10s\n", "Compression", "Count", "Packed", "Unpacked");
+	uint32 unpackedBytes = 0;
+	for (int i = 0; i < ResourceManager::kCompressionMethods; i++) {
+		const ResourceManager::CompressionStats &stats = resMan->getCompressionStats((ResourceCompression)i);
+		if (!stats.resources)
+			continue;
+
+		unpackedBytes += stats.unpackedBytes;
+		DebugPrintf("%-14s %8d %10d %10d\n", s_compressionNames[i],
+		            stats.resources, stats.packedBytes, stats.unpackedBytes);
+	}
+	DebugPrintf("Total: %d bytes decompressed\n", unpackedBytes);
+
+	if (_engine->_gfxCache) {
+		const GfxCache::Stats &stats = _engine->_gfxCache->getStats();
+		DebugPrintf("\nView cache: %d hits, %d misses (%d with decoded cels), %d evictions\n",
+		            stats.viewHits, stats.viewMisses, stats.celBitmapHits, stats.viewEvictions);
+		DebugPrintf("View cache memory: %d bytes, decoded cels of removed views: %d bytes\n",
+		            _engine->_gfxCache->getViewMemory(), _engine->_gfxCache->getCelBitmapMemory());
+		DebugPrintf("Font cache: %d hits, %d misses\n", stats.fontHits, stats.fontMisses);
+	}
+
+	return true;
+}
+
 bool Console::cmdHexgrep(int argc, const char **argv) {
 	if (argc < 4) {
 		DebugPrintf("Searches some resources for a particular sequence of bytes, represented as decimal or hexadecimal numbers.\n");
@@ -1486,6 +1575,116 @@ bool Console::cmdSetPalette(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdPalVaryBenchmark(int argc, const char **argv) {
+	if (argc < 2) {
+		DebugPrintf("Replays a PalVary transition from the current palette to a palette resource,\n");
+		DebugPrintf("and times the color matching of the palette merges during the transition,\n");
+		DebugPrintf("with and without the color match cache. The screen is not changed.\n");
+		DebugPrintf("Usage: %s <resourceId> [rounds]\n", argv[0]);
+		return true;
+	}
+
+	GfxPalette *palette = _engine->_gfxPalette;
+	Resource *palResource = _engine->getResMan()->findResource(ResourceId(kResourceTypePalette, atoi(argv[1])), false);
+	if (!palResource) {
+		DebugPrintf("Palette resource %s not found\n", argv[1]);
+		return true;
+	}
+	const int rounds = (argc > 2) ? MAX(atoi(argv[2]), 1) : 10;
+
+	Palette origin, target;
+	palette->getSys(&origin);
+	palette->createFromData(palResource->data, palResource->size, &target);
+
+	uint32 time[2], checksum[2];
+	int matches = 0;
+	for (int pass = 0; pass < 2; pass++) {
+		const uint32 startTime = g_system->getMillis();
+		checksum[pass] = 0;
+		matches = 0;
+
+		for (int round = 0; round < rounds; round++) {
+			for (int step = 1; step <= 64; step++) {
+				// Set up the in-between palette, like palVaryProcess() does
+				for (int colorNr = 1; colorNr < 255; colorNr++) {
+					const Color &from = origin.colors[colorNr];
+					const Color &to = target.colors[colorNr];
+					Color &color = palette->_sysPalette.colors[colorNr];
+					color.r = ((to.r - from.r) * step) / 64 + from.r;
+					color.g = ((to.g - from.g) * step) / 64 + from.g;
+					color.b = ((to.b - from.b) * step) / 64 + from.b;
+				}
+				palette->invalidateColorMatches();
+
+				// Merge the origin and target palettes twice each, as if they
+				// were used by several views drawn during this step
+				for (int merge = 0; merge < 4; merge++) {
+					const Palette &mergePalette = (merge & 1) ? target : origin;
+					for (int colorNr = 1; colorNr < 255; colorNr++) {
+						const Color &color = mergePalette.colors[colorNr];
+						if (!color.used)
+							continue;
+						const uint16 result = pass ? palette->matchColorUncached(color.r, color.g, color.b)
+						                           : palette->matchColor(color.r, color.g, color.b);
+						checksum[pass] = checksum[pass] * 31 + result;
+						matches++;
+					}
+				}
+			}
+		}
+
+		time[pass] = g_system->getMillis() - startTime;
+	}
+
+	// Restore the system palette
+	memcpy(&palette->_sysPalette, &origin, sizeof(Palette));
+	palette->invalidateColorMatches();
+
+	DebugPrintf("%d color matches in %d steps\n", matches, rounds * 64);
+	DebugPrintf("Cached: %d ms, uncached: %d ms\n", time[0], time[1]);
+	if (checksum[0] != checksum[1])
+		DebugPrintf("Warning: cached and uncached results differ\n");
+
+	return true;
+}
+
+bool Console::cmdFrameoutDamage(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	GfxFrameout *frameout = _engine->_gfxFrameout;
+	if (!frameout) {
+		DebugPrintf("This game doesn't use kFrameout\n");
+		return true;
+	}
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "on")) {
+			frameout->setShowDamage(true);
+		} else if (!scumm_stricmp(argv[1], "off")) {
+			frameout->setShowDamage(false);
+		} else if (!scumm_stricmp(argv[1], "reset")) {
+			frameout->resetStats();
+		} else {
+			DebugPrintf("Shows how much of the screen kFrameout redraws, and outlines the\n");
+			DebugPrintf("redrawn regions on the screen while enabled.\n");
+			DebugPrintf("Usage: %s [on | off | reset]\n", argv[0]);
+			return true;
+		}
+	}
+
+	const FrameoutStats &stats = frameout->getStats();
+	const uint32 redrawnFrames = stats.partialFrames + stats.fullFrames;
+	DebugPrintf("Frames: %d, unchanged: %d, partially redrawn: %d, fully redrawn: %d\n",
+				stats.frames, stats.skippedFrames, stats.partialFrames, stats.fullFrames);
+	if (redrawnFrames)
+		DebugPrintf("Average redrawn area: %d of %d pixels\n", stats.redrawnPixels / redrawnFrames,
+					_engine->_gfxScreen->getDisplayWidth() * _engine->_gfxScreen->getDisplayHeight());
+	DebugPrintf("Outlining of redrawn regions is %s\n", frameout->getShowDamage() ? "on" : "off");
+#else
+	DebugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdDrawPic(int argc, const char **argv) {
 	if (argc < 2) {
 		DebugPrintf("Draws a pic resource\n");
@@ -2099,6 +2298,40 @@ bool Console::cmdGCNormalize(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCStats(int argc, const char **argv) {
+	EngineState *s = _engine->_gamestate;
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			if (s->_gc)
+				memset(&s->_gc->_stats, 0, sizeof(s->_gc->_stats));
+			DebugPrintf("Garbage collection statistics reset\n");
+		} else {
+			DebugPrintf("Shows statistics of the garbage collector\n");
+			DebugPrintf("Usage: %s [reset]\n", argv[0]);
+		}
+		return true;
+	}
+
+	DebugPrintf("Mode: %s", s->scriptGCSlice > 0 ? "incremental" : "stop-the-world");
+	if (s->scriptGCSlice > 0)
+		DebugPrintf(", %d references per step%s", s->scriptGCSlice, s->_segMan->isGCMarking() ? ", marking" : "");
+	DebugPrintf("\n");
+
+	if (!s->_gc || !s->_gc->_stats.runs) {
+		DebugPrintf("No garbage collection has been completed yet\n");
+		return true;
+	}
+
+	const GCStats &stats = s->_gc->_stats;
+	DebugPrintf("Collections: %d, %d of them incremental in %d steps\n", stats.runs, stats.incrementalRuns, stats.steps);
+	DebugPrintf("Pause: last %d ms, max %d ms, total time %d ms\n", stats.lastPause, stats.maxPause, stats.totalTime);
+	DebugPrintf("Last collection: %d references marked, %d entities freed\n", stats.lastMarked, stats.lastReclaimed);
+	DebugPrintf("Entities freed: %d in total, %d per collection\n", stats.totalReclaimed, stats.totalReclaimed / stats.runs);
+
+	return true;
+}
+
 bool Console::cmdVMVarlist(int argc, const char **argv) {
 	EngineState *s = _engine->_gamestate;
 	const char *varnames[] = {"global", "local", "temp", "param"};
@@ -2467,6 +2700,57 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdVMProfile(int argc, const char **argv) {
+	SegManager *segMan = _engine->_gamestate->_segMan;
+	SegManager::SelectorCacheStats &cacheStats = segMan->getSelectorCacheStats();
+
+	if (argc > 1) {
+		if (!scumm_stricmp(argv[1], "on") || !scumm_stricmp(argv[1], "reset")) {
+			if (!scumm_stricmp(argv[1], "on"))
+				_debugState._opcodeProfiling = true;
+			memset(_debugState._opcodeCounts, 0, sizeof(_debugState._opcodeCounts));
+			memset(&cacheStats, 0, sizeof(cacheStats));
+			_debugState._profileStartTime = g_system->getMillis();
+		} else if (!scumm_stricmp(argv[1], "off")) {
+			_debugState._opcodeProfiling = false;
+		} else if (!scumm_stricmp(argv[1], "cache") && argc > 2) {
+			segMan->setSelectorCacheEnabled(!scumm_stricmp(argv[2], "on"));
+			DebugPrintf("Selector cache %s\n", segMan->isSelectorCacheEnabled() ? "enabled" : "disabled");
+		} else {
+			DebugPrintf("Counts the executed opcodes and shows the selector cache statistics\n");
+			DebugPrintf("Usage: %s [on | off | reset | cache <on | off>]\n", argv[0]);
+		}
+		return true;
+	}
+
+	uint32 total = 0;
+	for (uint i = 0; i < ARRAYSIZE(_debugState._opcodeCounts); i++)
+		total += _debugState._opcodeCounts[i];
+
+	if (total) {
+		DebugPrintf("Opcode profile (%s):\n", _debugState._opcodeProfiling ? "running" : "stopped");
+		for (uint i = 0; i < ARRAYSIZE(_debugState._opcodeCounts); i++) {
+			const uint32 count = _debugState._opcodeCounts[i];
+			if (count)
+				DebugPrintf(" %02x %-10s %10d %3d%%\n", i, opcodeNames[i], count, (int)((double)count * 100 / total));
+		}
+
+		const uint32 elapsed = g_system->getMillis() - _debugState._profileStartTime;
+		DebugPrintf("Total: %d opcodes in %d ms\n", total, elapsed);
+	} else {
+		DebugPrintf("No opcodes counted, use '%s on' to start counting\n", argv[0]);
+	}
+
+	const uint32 lookups = cacheStats.hits + cacheStats.misses;
+	DebugPrintf("Selector cache %s: %d hits, %d misses (%d%% hits), %d invalidations\n",
+	            segMan->isSelectorCacheEnabled() ? "enabled" : "disabled",
+	            cacheStats.hits, cacheStats.misses,
+	            lookups ? (int)((double)cacheStats.hits * 100 / lookups) : 0,
+	            cacheStats.invalidations);
+
+	return true;
+}
+
 bool Console::cmdBacktrace(int argc, const char **argv) {
 	DebugPrintf("Call stack (current base: 0x%x):\n", _engine->_gamestate->executionStackBase);
 	Common::List<ExecStack>::const_iterator iter;
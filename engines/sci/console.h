@@ -72,6 +72,7 @@ private:
 	bool cmdResourceId(int argc, const char **argv);
 	bool cmdResourceInfo(int argc, const char **argv);
 	bool cmdResourceTypes(int argc, const char **argv);
+	bool cmdResourceStats(int argc, const char **argv);
 	bool cmdList(int argc, const char **argv);
 	bool cmdHexgrep(int argc, const char **argv);
 	bool cmdVerifyScripts(int argc, const char **argv);
@@ -87,6 +88,8 @@ private:
 	bool cmdShowMap(int argc, const char **argv);
 	// Graphics
 	bool cmdSetPalette(int argc, const char **argv);
+	bool cmdPalVaryBenchmark(int argc, const char **argv);
+	bool cmdFrameoutDamage(int argc, const char **argv);
 	bool cmdDrawPic(int argc, const char **argv);
 	bool cmdDrawCel(int argc, const char **argv);
 	bool cmdUndither(int argc, const char **argv);
@@ -104,6 +107,7 @@ private:
 	bool cmdGCShowReachable(int argc, const char **argv);
 	bool cmdGCShowFreeable(int argc, const char **argv);
 	bool cmdGCNormalize(int argc, const char **argv);
+	bool cmdGCStats(int argc, const char **argv);
 	// Music/SFX
 	bool cmdSongLib(int argc, const char **argv);
 	bool cmdSongInfo(int argc, const char **argv);
@@ -142,6 +146,7 @@ private:
 	bool cmdBreakpointFunction(int argc, const char **argv);
 	// VM
 	bool cmdScriptSteps(int argc, const char **argv);
+	bool cmdVMProfile(int argc, const char **argv);
 	bool cmdVMVarlist(int argc, const char **argv);
 	bool cmdVMVars(int argc, const char **argv);
 	bool cmdStack(int argc, const char **argv);
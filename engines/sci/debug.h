@@ -72,6 +72,9 @@ struct DebugState {
 	StackPtr old_sp;
 	Common::List<Breakpoint> _breakpoints;   //< List of breakpoints
 	int _activeBreakpointTypes;  //< Bit mask specifying which types of breakpoints are active
+	bool _opcodeProfiling;		//< Count the executed opcodes
+	uint32 _opcodeCounts[128];	//< Number of executions of each opcode
+	uint32 _profileStartTime;	//< Time at which the opcode counts were reset
 };
 
 // Various global variables used for debugging are declared here
@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 namespace Sci {
@@ -80,25 +81,53 @@ static AddrSet *normalizeAddresses(SegManager *segMan, const AddrSet &nonnormal_
 	return normal_map;
 }
 
-static void processWorkList(SegManager *segMan, WorklistManager &wm, const Common::Array<SegmentObj *> &heap) {
+/**
+ * Marks the references on the worklist and everything reachable from them.
+ * @param budget Maximum number of references to scan, 0 for no limit
+ * @param skipFreed Skip references to entities which have been freed after
+ *                  they were pushed, as an incremental collection may do
+ * @return true if the worklist has been emptied
+ */
+static bool processWorkList(SegManager *segMan, WorklistManager &wm, const Common::Array<SegmentObj *> &heap, uint budget = 0, bool skipFreed = false) {
 	SegmentId stackSegment = segMan->findSegmentByType(SEG_TYPE_STACK);
+	uint scanned = 0;
 	while (!wm._worklist.empty()) {
+		if (budget && scanned++ == budget)
+			return false;
+
 		reg_t reg = wm._worklist.back();
 		wm._worklist.pop_back();
 		if (reg.segment != stackSegment) { // No need to repeat this one
 			debugC(kDebugLevelGC, "[GC] Checking %04x:%04x", PRINT_REG(reg));
 			if (reg.segment < heap.size() && heap[reg.segment]) {
+				if (skipFreed && !heap[reg.segment]->isValidOffset(reg.offset))
+					continue;
 				// Valid heap object? Find its outgoing references!
 				wm.pushArray(heap[reg.segment]->listAllOutgoingReferences(reg));
 			}
 		}
 	}
+	return true;
 }
 
-AddrSet *findAllActiveReferences(EngineState *s) {
-	assert(!s->_executionStack.empty());
+/**
+ * Marks the given entity and scans it for outgoing references, even if it
+ * has been scanned before.
+ */
+static void rescan(SegManager *segMan, WorklistManager &wm, const Common::Array<SegmentObj *> &heap, reg_t reg) {
+	if (!reg.segment || reg.segment >= heap.size() || !heap[reg.segment])
+		return;
 
-	WorklistManager wm;
+	SegmentObj *mobj = heap[reg.segment];
+	if (mobj->getType() == SEG_TYPE_STACK || !mobj->isValidOffset(reg.offset))
+		return;
+
+	wm._map.setVal(reg, true);
+	wm.pushArray(mobj->listAllOutgoingReferences(reg));
+}
+
+static void pushRootSet(EngineState *s, WorklistManager &wm) {
+	assert(!s->_executionStack.empty());
 
 	// Initialize registers
 	wm.push(s->r_acc);
@@ -151,8 +180,14 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	}
 
 	debugC(kDebugLevelGC, "[GC] -- Finished explicitly loaded scripts, done with root set");
+}
+
+AddrSet *findAllActiveReferences(EngineState *s) {
+	WorklistManager wm;
 
-	processWorkList(s->_segMan, wm, heap);
+	pushRootSet(s, wm);
+
+	processWorkList(s->_segMan, wm, s->_segMan->getSegments());
 
 	if (g_sci->_gfxPorts)
 		g_sci->_gfxPorts->processEngineHunkList(wm);
@@ -160,11 +195,12 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
-void run_gc(EngineState *s) {
-	SegManager *segMan = s->_segMan;
-
-	// Some debug stuff
-	debugC(kDebugLevelGC, "[GC] Running...");
+/**
+ * Frees everything which is not in the given set of active references.
+ * @return the number of freed entities
+ */
+static uint sweep(SegManager *segMan, const AddrSet &activeRefs) {
+	uint reclaimed = 0;
 #ifdef GC_DEBUG_CODE
 	const char *segnames[SEG_TYPE_MAX + 1];
 	int segcount[SEG_TYPE_MAX + 1];
@@ -172,9 +208,6 @@ void run_gc(EngineState *s) {
 	memset(segcount, 0, sizeof(segcount));
 #endif
 
-	// Compute the set of all segments references currently in use.
-	AddrSet *activeRefs = findAllActiveReferences(s);
-
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
 	const Common::Array<SegmentObj *> &heap = segMan->getSegments();
@@ -192,10 +225,11 @@ void run_gc(EngineState *s) {
 			const Common::Array<reg_t> tmp = mobj->listAllDeallocatable(seg);
 			for (Common::Array<reg_t>::const_iterator it = tmp.begin(); it != tmp.end(); ++it) {
 				const reg_t addr = *it;
-				if (!activeRefs->contains(addr)) {
+				if (!activeRefs.contains(addr)) {
 					// Not found -> we can free it
 					mobj->freeAtAddress(segMan, addr);
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					reclaimed++;
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
 #endif
@@ -205,8 +239,6 @@ void run_gc(EngineState *s) {
 		}
 	}
 
-	delete activeRefs;
-
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
@@ -214,6 +246,135 @@ void run_gc(EngineState *s) {
 		if (segcount[i])
 			debugC(kDebugLevelGC, "\t%d\t* %s", segcount[i], segnames[i]);
 #endif
+
+	return reclaimed;
+}
+
+GCState::GCState() : _steps(0), _pause(0) {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+void freeGCState(GCState *gc) {
+	delete gc;
+}
+
+static GCState *getGCState(EngineState *s) {
+	if (!s->_gc)
+		s->_gc = new GCState();
+	return s->_gc;
+}
+
+static void resetIncrementalState(SegManager *segMan, GCState *gc) {
+	segMan->setGCMarking(false);
+	segMan->getGCDirtyList().clear();
+	gc->_wm._worklist.clear();
+	gc->_wm._map.clear();
+	gc->_frameObjects.clear();
+	gc->_steps = 0;
+	gc->_pause = 0;
+}
+
+static void updateStats(GCState *gc, uint32 pause, uint32 time, uint marked, uint reclaimed) {
+	GCStats &stats = gc->_stats;
+	stats.runs++;
+	stats.lastPause = pause;
+	stats.maxPause = MAX(stats.maxPause, pause);
+	stats.totalTime += time;
+	stats.lastMarked = marked;
+	stats.lastReclaimed = reclaimed;
+	stats.totalReclaimed += reclaimed;
+
+	debugC(kDebugLevelGC, "[GC] Marked %d references, freed %d entities, paused for %d ms", marked, reclaimed, pause);
+}
+
+void run_gc(EngineState *s) {
+	SegManager *segMan = s->_segMan;
+	GCState *gc = getGCState(s);
+	const uint32 startTime = g_system->getMillis();
+
+	// Some debug stuff
+	debugC(kDebugLevelGC, "[GC] Running...");
+
+	// This supersedes an incremental collection in progress
+	resetIncrementalState(segMan, gc);
+
+	// Compute the set of all segments references currently in use.
+	AddrSet *activeRefs = findAllActiveReferences(s);
+
+	const uint reclaimed = sweep(segMan, *activeRefs);
+
+	const uint32 time = g_system->getMillis() - startTime;
+	updateStats(gc, time, time, activeRefs->size(), reclaimed);
+
+	delete activeRefs;
+}
+
+bool run_gc_slice(EngineState *s, uint sliceSize) {
+	SegManager *segMan = s->_segMan;
+	GCState *gc = getGCState(s);
+	const Common::Array<SegmentObj *> &heap = segMan->getSegments();
+	const uint32 startTime = g_system->getMillis();
+
+	// The segment manager stops recording when it is reset, which aborts
+	// the collection in progress as well
+	if (!segMan->isGCMarking()) {
+		debugC(kDebugLevelGC, "[GC] Starting incremental collection...");
+		resetIncrementalState(segMan, gc);
+		pushRootSet(s, gc->_wm);
+		segMan->setGCMarking(true);
+	}
+
+	// The VM caches a pointer to the object of each execution stack frame,
+	// so these objects may change without going through the write barrier.
+	// Remember them until marking is complete.
+	Common::List<ExecStack>::const_iterator iter;
+	for (iter = s->_executionStack.begin(); iter != s->_executionStack.end(); ++iter) {
+		if (iter->type != EXEC_STACK_TYPE_KERNEL)
+			gc->_frameObjects.setVal(iter->objp, true);
+	}
+
+	// Scan everything the VM has accessed since the last step again. Any
+	// later change requires another access, which is recorded again.
+	Common::Array<reg_t> &dirty = segMan->getGCDirtyList();
+	for (uint i = 0; i < dirty.size(); i++)
+		rescan(segMan, gc->_wm, heap, dirty[i]);
+	dirty.clear();
+
+	gc->_steps++;
+
+	if (processWorkList(segMan, gc->_wm, heap, sliceSize, true)) {
+		// Marking is done. Stop recording, scan the root set and the frame
+		// objects once more and sweep.
+		segMan->setGCMarking(false);
+
+		pushRootSet(s, gc->_wm);
+		for (AddrSet::const_iterator i = gc->_frameObjects.begin(); i != gc->_frameObjects.end(); ++i)
+			rescan(segMan, gc->_wm, heap, i->_key);
+		processWorkList(segMan, gc->_wm, heap, 0, true);
+
+		if (g_sci->_gfxPorts)
+			g_sci->_gfxPorts->processEngineHunkList(gc->_wm);
+
+		AddrSet *activeRefs = normalizeAddresses(segMan, gc->_wm._map);
+		const uint reclaimed = sweep(segMan, *activeRefs);
+
+		const uint32 pause = g_system->getMillis() - startTime;
+		gc->_pause = MAX(gc->_pause, pause);
+		gc->_stats.totalTime += pause;
+		gc->_stats.steps += gc->_steps;
+		gc->_stats.incrementalRuns++;
+		debugC(kDebugLevelGC, "[GC] Completed incremental collection in %d steps", gc->_steps);
+		updateStats(gc, gc->_pause, 0, activeRefs->size(), reclaimed);
+
+		delete activeRefs;
+		resetIncrementalState(segMan, gc);
+		return true;
+	}
+
+	const uint32 pause = g_system->getMillis() - startTime;
+	gc->_pause = MAX(gc->_pause, pause);
+	gc->_stats.totalTime += pause;
+	return false;
 }
 
 } // End of namespace Sci
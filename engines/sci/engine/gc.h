@@ -55,6 +55,17 @@ AddrSet *findAllActiveReferences(EngineState *s);
  */
 void run_gc(EngineState *s);
 
+/**
+ * Runs one step of an incremental garbage collection, starting a new one if
+ * none is in progress. At most sliceSize references are marked; once there
+ * are none left, the collection is completed in a final stop-the-world step,
+ * which marks everything the VM has accessed meanwhile again and sweeps.
+ * @param s The state in which we should gc
+ * @param sliceSize Number of references to mark in this step
+ * @return true if the collection has been completed
+ */
+bool run_gc_slice(EngineState *s, uint sliceSize);
+
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
 	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
@@ -63,6 +74,31 @@ struct WorklistManager {
 	void pushArray(const Common::Array<reg_t> &tmp);
 };
 
+/**
+ * Statistics about the garbage collections run so far
+ */
+struct GCStats {
+	uint32 runs;			///< Completed collections
+	uint32 incrementalRuns;	///< Completed collections which were run incrementally
+	uint32 steps;			///< Steps of all incremental collections
+	uint32 lastPause;		///< Longest pause of the last collection, in milliseconds
+	uint32 maxPause;		///< Longest pause of all collections, in milliseconds
+	uint32 totalTime;		///< Time spent in all collections, in milliseconds
+	uint32 lastMarked;		///< Reachable references found by the last collection
+	uint32 lastReclaimed;	///< Entities freed by the last collection
+	uint32 totalReclaimed;	///< Entities freed by all collections
+};
+
+struct GCState {
+	WorklistManager _wm;	///< Marking state of the incremental collection in progress
+	AddrSet _frameObjects;	///< Objects of all execution stack frames seen during marking
+	uint32 _steps;			///< Steps of the incremental collection in progress
+	uint32 _pause;			///< Longest step of the incremental collection in progress
+	GCStats _stats;
+
+	GCState();
+};
+
 
 } // End of namespace Sci
 
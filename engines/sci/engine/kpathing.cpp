@@ -67,6 +67,16 @@ enum {
 	PF_FATAL = -2
 };
 
+// A* vertex states
+enum {
+	ASTAR_UNVISITED = 0,
+	ASTAR_OPEN = 1,
+	ASTAR_CLOSED = 2
+};
+
+// Maximum number of polygon sets to keep visibility graphs for
+#define VISIBILITY_GRAPH_CACHE_SIZE 4
+
 // Floating point struct
 struct FloatPoint {
 	FloatPoint() : x(0), y(0) {}
@@ -94,23 +104,27 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Position in PathfindingState::vertex_index
+	int index;
+
+	// A* state of the vertex, its position in the open set, and the order
+	// in which it was added to the open set
+	int astarState;
+	uint heapIndex;
+	uint openSequence;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		index = -1;
+		astarState = ASTAR_UNVISITED;
+		heapIndex = 0;
+		openSequence = 0;
 	}
 };
 
-class VertexList: public Common::List<Vertex *> {
-public:
-	bool contains(Vertex *v) {
-		for (iterator it = begin(); it != end(); ++it) {
-			if (v == *it)
-				return true;
-		}
-		return false;
-	}
-};
+typedef Common::Array<Vertex *> VertexArray;
 
 /* Circular list definitions. */
 
@@ -214,6 +228,33 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+// Visibility graph of the vertices of a polygon set. The start and end
+// points merged into the set by kAvoidPath are not part of it.
+struct VisibilityGraph {
+	// The polygon set: for each polygon its type, its number of vertices and
+	// the coordinates of the vertices
+	Common::Array<int16> key;
+
+	// For each vertex, the indices of the vertices visible from it, in
+	// descending order. Rows are computed on demand.
+	Common::Array<Common::Array<uint16> > rows;
+	Common::Array<bool> rowKnown;
+};
+
+// Visibility graphs of the most recently used polygon sets, most recent first
+struct AvoidPathCache {
+	Common::List<VisibilityGraph *> graphs;
+
+	~AvoidPathCache() {
+		for (Common::List<VisibilityGraph *>::iterator it = graphs.begin(); it != graphs.end(); ++it)
+			delete *it;
+	}
+};
+
+void freeAvoidPathCache(AvoidPathCache *cache) {
+	delete cache;
+}
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -235,6 +276,15 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Cached visibility graph of the polygon set, or NULL. It covers all
+	// vertices except for the first _dynamicVertices ones in vertex_index,
+	// which were added by merging the start and end points.
+	VisibilityGraph *_visibilityGraph;
+	int _dynamicVertices;
+
+	// Set when merging the start or end point split up a polygon edge
+	bool _edgeSplit;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = NULL;
 		vertex_end = NULL;
@@ -242,6 +292,9 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		_visibilityGraph = NULL;
+		_dynamicVertices = 0;
+		_edgeSplit = false;
 	}
 
 	~PathfindingState() {
@@ -638,45 +691,78 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 }
 
 /**
- * Returns a list of all vertices that are visible from a particular vertex.
+ * Determines whether or not a vertex is visible from another vertex.
  * @param s				the pathfinding state
- * @param vertex_cur	the vertex
- * @return list of vertices that are visible from vert
+ * @param vertex_cur	the first vertex
+ * @param vertex		the second vertex
+ * @return true if the vertices can see each other, false otherwise
  */
-static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
-	VertexList *visVerts = new VertexList();
+static bool is_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
 
-	for (int i = 0; i < s->vertices; i++) {
-		Vertex *vertex = s->vertex_index[i];
+	// Check for intersecting edges
+	for (int j = 0; j < s->vertices; j++) {
+		Vertex *edge = s->vertex_index[j];
+		if (VERTEX_HAS_EDGES(edge)) {
+			if (between(vertex_cur->v, vertex->v, edge->v)) {
+				// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+				if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+					return false;
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
-			continue;
+				// This edge won't properly intersect, so we continue
+				continue;
+			}
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
+			if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+				return false;
+		}
+	}
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
+	return true;
+}
+
+/**
+ * Returns all vertices that are visible from a particular vertex, in
+ * descending order of their position in the vertex index. Uses and fills
+ * the cached visibility graph of the polygon set, if there is one.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the vertex
+ * @param visVerts		receives the vertices that are visible from vertex_cur
+ */
+static void visible_vertices(PathfindingState *s, Vertex *vertex_cur, VertexArray &visVerts) {
+	VisibilityGraph *graph = s->_visibilityGraph;
+	const int dynamicVertices = s->_dynamicVertices;
+	const int row = vertex_cur->index - dynamicVertices;
+
+	visVerts.clear();
+
+	if (graph && row >= 0 && graph->rowKnown[row]) {
+		// Visibility is symmetric, so only the start and end points have
+		// to be checked against vertex_cur
+		const Common::Array<uint16> &visible = graph->rows[row];
+		for (uint i = 0; i < visible.size(); i++)
+			visVerts.push_back(s->vertex_index[visible[i] + dynamicVertices]);
+
+		for (int i = dynamicVertices - 1; i >= 0; i--) {
+			if (is_visible(s, vertex_cur, s->vertex_index[i]))
+				visVerts.push_back(s->vertex_index[i]);
 		}
+		return;
+	}
 
-		if (j == s->vertices)
-			visVerts->push_front(vertex);
+	for (int i = s->vertices - 1; i >= 0; i--) {
+		if (is_visible(s, vertex_cur, s->vertex_index[i]))
+			visVerts.push_back(s->vertex_index[i]);
 	}
 
-	return visVerts;
+	if (graph && row >= 0) {
+		Common::Array<uint16> &visible = graph->rows[row];
+		for (uint i = 0; i < visVerts.size() && visVerts[i]->index >= dynamicVertices; i++)
+			visible.push_back(visVerts[i]->index - dynamicVertices);
+		graph->rowKnown[row] = true;
+	}
 }
 
 /**
@@ -1061,6 +1147,7 @@ static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
 				if (between(vertex->v, next->v, v)) {
 					// Split edge by adding vertex
 					polygon->vertices.insertAfter(vertex, v_new);
+					s->_edgeSplit = true;
 					return v_new;
 				}
 			}
@@ -1071,6 +1158,7 @@ static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
 	polygon = new Polygon(POLY_BARRED_ACCESS);
 	polygon->vertices.insertHead(v_new);
 	s->polygons.push_front(polygon);
+	s->_dynamicVertices++;
 
 	return v_new;
 }
@@ -1163,6 +1251,72 @@ static void change_polygons_opt_0(PathfindingState *s) {
 	}
 }
 
+/**
+ * Describes the polygon set of a pathfinding state, for looking up its
+ * visibility graph
+ * Parameters: (PathfindingState *) s: The pathfinding state
+ *             (Common::Array<int16> &) key: Receives the description
+ * Returns   : (int) The number of vertices in the polygon set
+ */
+static int visibility_graph_key(PathfindingState *s, Common::Array<int16> &key) {
+	int count = 0;
+
+	for (PolygonList::iterator it = s->polygons.begin(); it != s->polygons.end(); ++it) {
+		Polygon *polygon = *it;
+		Vertex *vertex;
+
+		key.push_back(polygon->type);
+		key.push_back(polygon->vertices.size());
+
+		CLIST_FOREACH(vertex, &polygon->vertices) {
+			key.push_back(vertex->v.x);
+			key.push_back(vertex->v.y);
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * Returns the cached visibility graph of a polygon set. If the polygon set
+ * is not in the cache, an empty graph is added for it, replacing the least
+ * recently used one if the cache is full.
+ * Parameters: (EngineState *) s: The game state
+ *             (const Common::Array<int16> &) key: The polygon set, see visibility_graph_key()
+ *             (int) vertices: The number of vertices in the polygon set
+ * Returns   : (VisibilityGraph *) The visibility graph
+ */
+static VisibilityGraph *get_visibility_graph(EngineState *s, const Common::Array<int16> &key, int vertices) {
+	if (!s->_avoidPathCache)
+		s->_avoidPathCache = new AvoidPathCache();
+
+	Common::List<VisibilityGraph *> &graphs = s->_avoidPathCache->graphs;
+
+	for (Common::List<VisibilityGraph *>::iterator it = graphs.begin(); it != graphs.end(); ++it) {
+		VisibilityGraph *graph = *it;
+		if (graph->key == key) {
+			graphs.erase(it);
+			graphs.push_front(graph);
+			debugC(kDebugLevelAvoidPath, "AvoidPath: reusing visibility graph of %d vertices", vertices);
+			return graph;
+		}
+	}
+
+	if (graphs.size() >= VISIBILITY_GRAPH_CACHE_SIZE) {
+		delete graphs.back();
+		graphs.pop_back();
+	}
+
+	VisibilityGraph *graph = new VisibilityGraph();
+	graph->key = key;
+	graph->rows.resize(vertices);
+	graph->rowKnown.resize(vertices);
+	graphs.push_front(graph);
+
+	return graph;
+}
+
 /**
  * Converts the SCI input data for pathfinding
  * Parameters: (EngineState *) s: The game state
@@ -1254,6 +1408,11 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	// The visibility graph of the polygon set does not depend on the start
+	// and end points, as long as they don't split up any edges
+	Common::Array<int16> key;
+	const int staticVertices = visibility_graph_key(pf_s, key);
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
@@ -1261,6 +1420,9 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	delete new_start;
 	delete new_end;
 
+	if (!pf_s->_edgeSplit)
+		pf_s->_visibilityGraph = get_visibility_graph(s, key, staticVertices);
+
 	// Allocate and build vertex index
 	pf_s->vertex_index = (Vertex**)malloc(sizeof(Vertex *) * (count + 2));
 
@@ -1271,6 +1433,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		Vertex *vertex;
 
 		CLIST_FOREACH(vertex, &polygon->vertices) {
+			vertex->index = count;
 			pf_s->vertex_index[count++] = vertex;
 		}
 	}
@@ -1280,6 +1443,68 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	return pf_s;
 }
 
+/**
+ * Determines which of two vertices in the A* open set is to be expanded
+ * first: the one with the lower F cost or, if both costs are equal, the one
+ * that was added to the open set last
+ * Parameters: (const Vertex *) a, b: The vertices
+ * Returns   : (bool) true if a is to be expanded before b, false otherwise
+ */
+static bool astar_before(const Vertex *a, const Vertex *b) {
+	if (a->costF != b->costF)
+		return a->costF < b->costF;
+	return a->openSequence > b->openSequence;
+}
+
+/**
+ * Moves a vertex of the A* open set towards the top of the heap, until the
+ * heap order is restored
+ * Parameters: (VertexArray &) openSet: The open set
+ *             (uint) index: The heap position of the vertex
+ */
+static void openset_sift_up(VertexArray &openSet, uint index) {
+	Vertex *vertex = openSet[index];
+
+	while (index > 0) {
+		const uint parent = (index - 1) / 2;
+		if (!astar_before(vertex, openSet[parent]))
+			break;
+		openSet[index] = openSet[parent];
+		openSet[index]->heapIndex = index;
+		index = parent;
+	}
+
+	openSet[index] = vertex;
+	vertex->heapIndex = index;
+}
+
+/**
+ * Moves a vertex of the A* open set towards the bottom of the heap, until
+ * the heap order is restored
+ * Parameters: (VertexArray &) openSet: The open set
+ *             (uint) index: The heap position of the vertex
+ */
+static void openset_sift_down(VertexArray &openSet, uint index) {
+	Vertex *vertex = openSet[index];
+	const uint size = openSet.size();
+
+	while (true) {
+		uint child = index * 2 + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && astar_before(openSet[child + 1], openSet[child]))
+			child++;
+		if (!astar_before(openSet[child], vertex))
+			break;
+		openSet[index] = openSet[child];
+		openSet[index]->heapIndex = index;
+		index = child;
+	}
+
+	openSet[index] = vertex;
+	vertex->heapIndex = index;
+}
+
 /**
  * Computes a shortest path from vertex_start to vertex_end. The caller can
  * construct the resulting path by following the path_prev links from
@@ -1288,53 +1513,46 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
  * Parameters: (PathfindingState *) s: The pathfinding state
  */
 static void AStar(PathfindingState *s) {
-	// Vertices of which the shortest path is known
-	VertexList closedSet;
+	// The remaining vertices, as a binary heap ordered by astar_before().
+	// Vertices of which the shortest path is known are marked ASTAR_CLOSED.
+	VertexArray openSet;
+	uint openSequence = 0;
 
-	// The remaining vertices
-	VertexList openSet;
+	VertexArray visVerts;
 
-	openSet.push_front(s->vertex_start);
 	s->vertex_start->costG = 0;
 	s->vertex_start->costF = (uint32)sqrt((float)s->vertex_start->v.sqrDist(s->vertex_end->v));
+	s->vertex_start->astarState = ASTAR_OPEN;
+	s->vertex_start->openSequence = openSequence++;
+	openSet.push_back(s->vertex_start);
+	openset_sift_up(openSet, 0);
 
 	while (!openSet.empty()) {
-		// Find vertex in open set with lowest F cost
-		VertexList::iterator vertex_min_it = openSet.end();
-		Vertex *vertex_min = 0;
-		uint32 min = HUGE_DISTANCE;
-
-		for (VertexList::iterator it = openSet.begin(); it != openSet.end(); ++it) {
-			Vertex *vertex = *it;
-			if (vertex->costF < min) {
-				vertex_min_it = it;
-				vertex_min = *vertex_min_it;
-				min = vertex->costF;
-			}
-		}
+		// The vertex in the open set with lowest F cost
+		Vertex *vertex_min = openSet[0];
 
-		assert(vertex_min != 0);	// the vertex cost should never be bigger than HUGE_DISTANCE
+		assert(vertex_min->costF < HUGE_DISTANCE);	// the vertex cost should never be bigger than HUGE_DISTANCE
 
 		// Check if we are done
 		if (vertex_min == s->vertex_end)
 			break;
 
 		// Move vertex from set open to set closed
-		closedSet.push_front(vertex_min);
-		openSet.erase(vertex_min_it);
+		vertex_min->astarState = ASTAR_CLOSED;
+		openSet[0] = openSet.back();
+		openSet.pop_back();
+		if (!openSet.empty())
+			openset_sift_down(openSet, 0);
 
-		VertexList *visVerts = visible_vertices(s, vertex_min);
+		visible_vertices(s, vertex_min, visVerts);
 
-		for (VertexList::iterator it = visVerts->begin(); it != visVerts->end(); ++it) {
+		for (VertexArray::iterator it = visVerts.begin(); it != visVerts.end(); ++it) {
 			uint32 new_dist;
 			Vertex *vertex = *it;
 
-			if (closedSet.contains(vertex))
+			if (vertex->astarState == ASTAR_CLOSED)
 				continue;
 
-			if (!openSet.contains(vertex))
-				openSet.push_front(vertex);
-
 			new_dist = vertex_min->costG + (uint32)sqrt((float)vertex_min->v.sqrDist(vertex->v));
 
 			// When travelling to a vertex on the screen edge, we
@@ -1352,9 +1570,17 @@ static void AStar(PathfindingState *s) {
 				vertex->costF = vertex->costG + (uint32)sqrt((float)vertex->v.sqrDist(s->vertex_end->v));
 				vertex->path_prev = vertex_min;
 			}
-		}
 
-		delete visVerts;
+			if (vertex->astarState == ASTAR_UNVISITED) {
+				vertex->astarState = ASTAR_OPEN;
+				vertex->openSequence = openSequence++;
+				vertex->heapIndex = openSet.size();
+				openSet.push_back(vertex);
+			}
+
+			// The F cost of a vertex in the open set can only decrease
+			openset_sift_up(openSet, vertex->heapIndex);
+		}
 	}
 
 	if (openSet.empty())
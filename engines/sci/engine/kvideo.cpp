@@ -38,6 +38,7 @@
 #include "video/qt_decoder.h"
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
+#include "sci/graphics/frameout.h"
 #include "video/coktel_decoder.h"
 #endif
 
@@ -119,6 +120,12 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 
 	delete[] scaleBuffer;
 	delete videoDecoder;
+
+#ifdef ENABLE_SCI32
+	// The video was drawn directly to the screen
+	if (g_sci->_gfxFrameout)
+		g_sci->_gfxFrameout->invalidateScreen();
+#endif
 }
 
 reg_t kShowMovie(EngineState *s, int argc, reg_t *argv) {
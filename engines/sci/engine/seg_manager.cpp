@@ -49,6 +49,13 @@ SegManager::SegManager(ResourceManager *resMan) {
 
 	_resMan = resMan;
 
+	memset(_selectorCache, 0, sizeof(_selectorCache));
+	memset(&_selectorCacheStats, 0, sizeof(_selectorCacheStats));
+	_selectorCacheGeneration = 1;
+	_selectorCacheEnabled = true;
+
+	_gcMarking = false;
+
 	createClassTable();
 }
 
@@ -81,6 +88,13 @@ void SegManager::resetSegMan() {
 	// Reinitialize class table
 	_classTable.clear();
 	createClassTable();
+
+	invalidateSelectorCache();
+
+	// Abort any incremental garbage collection, the entities it has seen so
+	// far don't exist anymore
+	_gcMarking = false;
+	_gcDirty.clear();
 }
 
 void SegManager::initSysStrings() {
@@ -154,6 +168,10 @@ void SegManager::deallocate(SegmentId seg) {
 
 	SegmentObj *mobj = _heap[seg];
 
+	// Objects (and classes) in this segment are going away
+	if (mobj->getType() == SEG_TYPE_SCRIPT || mobj->getType() == SEG_TYPE_CLONES)
+		invalidateSelectorCache();
+
 	if (mobj->getType() == SEG_TYPE_SCRIPT) {
 		Script *scr = (Script *)mobj;
 		_scriptSegMap.erase(scr->getScriptNumber());
@@ -223,6 +241,8 @@ Object *SegManager::getObject(reg_t pos) const {
 	SegmentObj *mobj = getSegmentObj(pos.segment);
 	Object *obj = NULL;
 
+	gcBarrier(pos);
+
 	if (mobj != NULL) {
 		if (mobj->getType() == SEG_TYPE_CLONES) {
 			CloneTable *ct = (CloneTable *)mobj;
@@ -422,6 +442,7 @@ reg_t SegManager::allocateHunkEntry(const char *hunk_type, int size) {
 	h->size = size;
 	h->type = hunk_type;
 
+	gcBarrier(addr);
 	return addr;
 }
 
@@ -448,6 +469,7 @@ Clone *SegManager::allocateClone(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_clonesSegId, offset);
+	gcBarrier(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -462,6 +484,7 @@ List *SegManager::allocateList(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_listsSegId, offset);
+	gcBarrier(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -476,6 +499,7 @@ Node *SegManager::allocateNode(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_nodesSegId, offset);
+	gcBarrier(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -502,6 +526,7 @@ List *SegManager::lookupList(reg_t addr) {
 		return NULL;
 	}
 
+	gcBarrier(addr);
 	return &(lt->_table[addr.offset]);
 }
 
@@ -526,6 +551,7 @@ Node *SegManager::lookupNode(reg_t addr, bool stopOnDiscarded) {
 		return NULL;
 	}
 
+	gcBarrier(addr);
 	return &(nt->_table[addr.offset]);
 }
 
@@ -539,6 +565,7 @@ SegmentRef SegManager::dereference(reg_t pointer) {
 	}
 
 	SegmentObj *mobj = _heap[pointer.segment];
+	gcBarrier(pointer);
 	return mobj->dereference(pointer);
 }
 
@@ -853,6 +880,7 @@ byte *SegManager::allocDynmem(int size, const char *descr, reg_t *addr) {
 
 	d._description = descr;
 
+	gcBarrier(*addr);
 	return (byte *)(d._buf);
 }
 
@@ -878,6 +906,7 @@ SciArray<reg_t> *SegManager::allocateArray(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_arraysSegId, offset);
+	gcBarrier(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -890,6 +919,7 @@ SciArray<reg_t> *SegManager::lookupArray(reg_t addr) {
 	if (!arrayTable->isValidEntry(addr.offset))
 		error("Attempt to use non-array %04x:%04x as array", PRINT_REG(addr));
 
+	gcBarrier(addr);
 	return &(arrayTable->_table[addr.offset]);
 }
 
@@ -918,6 +948,7 @@ SciString *SegManager::allocateString(reg_t *addr) {
 	offset = table->allocEntry();
 
 	*addr = make_reg(_stringSegId, offset);
+	gcBarrier(*addr);
 	return &(table->_table[offset]);
 }
 
@@ -930,6 +961,7 @@ SciString *SegManager::lookupString(reg_t addr) {
 	if (!stringTable->isValidEntry(addr.offset))
 		error("lookupString: Attempt to use non-string %04x:%04x as string", PRINT_REG(addr));
 
+	gcBarrier(addr);
 	return &(stringTable->_table[addr.offset]);
 }
 
@@ -441,6 +441,85 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	// 6. Selector lookup cache
+
+	/** A cached result of lookupSelector() */
+	struct SelectorCacheEntry {
+		reg_t obj;
+		Selector selector;
+		uint32 generation;	///< Entry is only valid if this matches the cache generation
+		SelectorType type;
+		int varIndex;	///< For kSelectorVariable
+		reg_t funcp;	///< For kSelectorMethod
+	};
+
+	struct SelectorCacheStats {
+		uint32 hits;
+		uint32 misses;
+		uint32 invalidations;
+	};
+
+	/**
+	 * Returns the selector cache slot for the given object and selector.
+	 * The slot may contain the result for another object/selector pair.
+	 */
+	SelectorCacheEntry &getSelectorCacheEntry(reg_t obj, Selector selector) {
+		return _selectorCache[(obj.segment * 31 + obj.offset * 7 + selector) & (kSelectorCacheSize - 1)];
+	}
+	uint32 getSelectorCacheGeneration() const { return _selectorCacheGeneration; }
+
+	/**
+	 * Invalidates all cached selector lookups. Must be called whenever an
+	 * object may be freed, as its address may be reused by another one.
+	 */
+	void invalidateSelectorCache() {
+		_selectorCacheGeneration++;
+		_selectorCacheStats.invalidations++;
+	}
+
+	SelectorCacheStats &getSelectorCacheStats() { return _selectorCacheStats; }
+
+	void setSelectorCacheEnabled(bool enabled) { _selectorCacheEnabled = enabled; invalidateSelectorCache(); }
+	bool isSelectorCacheEnabled() const { return _selectorCacheEnabled; }
+
+	// 7. Incremental garbage collection
+
+	/**
+	 * Records an access to the given heap entity while an incremental garbage
+	 * collection is marking. The VM can only store a reference into an entity
+	 * after looking it up through one of the accessors above, so recording
+	 * every lookup (and every allocation) serves as a conservative write
+	 * barrier: the collector scans all recorded entities again before it
+	 * sweeps.
+	 */
+	void gcBarrier(reg_t addr) const {
+		if (_gcMarking && addr.segment && (_gcDirty.empty() || _gcDirty.back() != addr))
+			_gcDirty.push_back(addr);
+	}
+
+	/**
+	 * Starts or stops recording accesses for the garbage collector. Stopping
+	 * keeps the entities recorded so far.
+	 */
+	void setGCMarking(bool marking) { _gcMarking = marking; }
+	bool isGCMarking() const { return _gcMarking; }
+
+	/** The entities recorded by gcBarrier(), to be cleared by the collector */
+	Common::Array<reg_t> &getGCDirtyList() { return _gcDirty; }
+
+private:
+	enum {
+		kSelectorCacheSize = 1024	///< Number of cache slots, must be a power of two
+	};
+
+	SelectorCacheEntry _selectorCache[kSelectorCacheSize];
+	uint32 _selectorCacheGeneration;
+	SelectorCacheStats _selectorCacheStats;
+	bool _selectorCacheEnabled;
+
+	bool _gcMarking;
+	mutable Common::Array<reg_t> _gcDirty;
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
@@ -125,6 +125,9 @@ void CloneTable::freeAtAddress(SegManager *segMan, reg_t addr) {
 #endif
 
 	freeEntry(addr.offset);
+
+	// The entry may now be reused by a new clone
+	segMan->invalidateSelectorCache();
 }
 
 
@@ -262,6 +262,23 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 				PRINT_REG(obj_location));
 	}
 
+	// Check the cache first. Cached results stay valid until an object or
+	// class gets freed, see SegManager::invalidateSelectorCache()
+	SegManager::SelectorCacheEntry &cached = segMan->getSelectorCacheEntry(obj_location, selectorId);
+	if (segMan->isSelectorCacheEnabled() && cached.generation == segMan->getSelectorCacheGeneration() && cached.obj == obj_location && cached.selector == selectorId) {
+		segMan->getSelectorCacheStats().hits++;
+		if (cached.type == kSelectorVariable) {
+			if (varp) {
+				varp->obj = obj_location;
+				varp->varindex = cached.varIndex;
+			}
+		} else if (fptr) {
+			*fptr = cached.funcp;
+		}
+		return cached.type;
+	}
+	segMan->getSelectorCacheStats().misses++;
+
 	index = obj->locateVarSelector(segMan, selectorId);
 
 	if (index >= 0) {
@@ -270,6 +287,12 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 			varp->obj = obj_location;
 			varp->varindex = index;
 		}
+
+		cached.obj = obj_location;
+		cached.selector = selectorId;
+		cached.generation = segMan->getSelectorCacheGeneration();
+		cached.type = kSelectorVariable;
+		cached.varIndex = index;
 		return kSelectorVariable;
 	} else {
 		// Check if it's a method, with recursive lookup in superclasses
@@ -279,6 +302,11 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 				if (fptr)
 					*fptr = obj->getFunction(index);
 
+				cached.obj = obj_location;
+				cached.selector = selectorId;
+				cached.generation = segMan->getSelectorCacheGeneration();
+				cached.type = kSelectorMethod;
+				cached.funcp = obj->getFunction(index);
 				return kSelectorMethod;
 			} else {
 				obj = segMan->getObject(obj->getSuperClassSelector());
@@ -68,13 +68,17 @@ static const uint16 s_halfWidthSJISMap[256] = {
 };
 
 EngineState::EngineState(SegManager *segMan)
-: _segMan(segMan), _dirseeker() {
+: _segMan(segMan), _dirseeker(), _avoidPathCache(0), _gc(0) {
+
+	scriptGCSlice = 0;
 
 	reset(false);
 }
 
 EngineState::~EngineState() {
 	delete _msgState;
+	freeAvoidPathCache(_avoidPathCache);
+	freeGCState(_gc);
 }
 
 void EngineState::reset(bool isRestoring) {
@@ -45,6 +45,18 @@ namespace Sci {
 class EventManager;
 class MessageState;
 class SoundCommandParser;
+struct AvoidPathCache;
+struct GCState;
+
+/**
+ * Frees the visibility graphs cached by kAvoidPath.
+ */
+void freeAvoidPathCache(AvoidPathCache *cache);
+
+/**
+ * Frees the state of the garbage collector.
+ */
+void freeGCState(GCState *gc);
 
 enum AbortGameState {
 	kAbortNone = 0,
@@ -200,6 +212,7 @@ public:
 
 	int scriptStepCounter; // Counts the number of steps executed
 	int scriptGCInterval; // Number of steps in between gcs
+	int scriptGCSlice; // Number of references marked per step of an incremental gc, 0 for stop-the-world gcs
 
 	uint16 currentRoomNumber() const;
 	void setRoomNumber(uint16 roomNumber);
@@ -216,9 +229,12 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	GCState *_gc; /**< Incremental gc in progress and gc statistics, see gc.h */
 
 	MessageState *_msgState;
 
+	AvoidPathCache *_avoidPathCache; /**< Visibility graphs of recently used polygon sets, see kAvoidPath */
+
 	// MemorySegment provides access to a 256-byte block of memory that remains
 	// intact across restarts and restores
 	enum {
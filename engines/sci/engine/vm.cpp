@@ -201,6 +201,11 @@ static void write_var(EngineState *s, int type, int index, reg_t value) {
 
 		s->variables[type][index] = value;
 
+		// The locals are accessed through cached pointers, so any write has
+		// to go through the write barrier of the garbage collector
+		if (type == VAR_GLOBAL || type == VAR_LOCAL)
+			s->_segMan->gcBarrier(make_reg(s->variablesSegment[type], 0));
+
 		// If the game is trying to change its speech/subtitle settings, apply the ScummVM audio
 		// options first, if they haven't been applied yet
 		if (type == VAR_GLOBAL && index == 90 && !g_sci->getEngineState()->_syncedAudioOptions) {
@@ -637,6 +642,8 @@ void run_vm(EngineState *s) {
 		byte extOpcode;
 		s->xs->addr.pc.offset += readPMachineInstruction(scr->getBuf() + s->xs->addr.pc.offset, extOpcode, opparams);
 		const byte opcode = extOpcode >> 1;
+		if (g_sci->_debugState._opcodeProfiling)
+			g_sci->_debugState._opcodeCounts[opcode]++;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
 #ifdef ABORT_ON_INFINITE_LOOP
@@ -845,10 +852,18 @@ void run_vm(EngineState *s) {
 		}
 
 		case op_callk: { // 0x21 (33)
-			// Run the garbage collector, if needed
-			if (s->gcCountDown-- <= 0) {
+			// Run the garbage collector, if needed. Incremental collections only
+			// run outside of kernel functions, which may hold pointers to heap
+			// entities that were obtained without a write barrier.
+			const bool incrementalGC = s->scriptGCSlice > 0 && !s->executionStackBase;
+			if (incrementalGC && s->_segMan->isGCMarking()) {
+				run_gc_slice(s, s->scriptGCSlice);
+			} else if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				if (incrementalGC)
+					run_gc_slice(s, s->scriptGCSlice);
+				else
+					run_gc(s);
 			}
 
 			// Call kernel function
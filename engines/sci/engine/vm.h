@@ -139,6 +139,11 @@ enum {
 	GC_INTERVAL = 0x8000
 };
 
+/** Number of references marked per kernel call by an incremental gc */
+enum {
+	GC_SLICE = 256
+};
+
 // Opcode formats
 enum opcode_format {
 	Script_Invalid = -1,
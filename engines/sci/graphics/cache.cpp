@@ -36,17 +36,21 @@ namespace Sci {
 
 GfxCache::GfxCache(ResourceManager *resMan, GfxScreen *screen, GfxPalette *palette)
 	: _resMan(resMan), _screen(screen), _palette(palette) {
+	_celBitmapMemory = 0;
+	_useCounter = 0;
+	resetStats();
 }
 
 GfxCache::~GfxCache() {
 	purgeFontCache();
 	purgeViewCache();
+	purgeCelBitmapCache();
 }
 
 void GfxCache::purgeFontCache() {
 	for (FontCache::iterator iter = _cachedFonts.begin(); iter != _cachedFonts.end(); ++iter) {
-		delete iter->_value;
-		iter->_value = 0;
+		delete iter->_value.font;
+		iter->_value.font = 0;
 	}
 
 	_cachedFonts.clear();
@@ -54,36 +58,147 @@ void GfxCache::purgeFontCache() {
 
 void GfxCache::purgeViewCache() {
 	for (ViewCache::iterator iter = _cachedViews.begin(); iter != _cachedViews.end(); ++iter) {
-		delete iter->_value;
-		iter->_value = 0;
+		delete iter->_value.view;
+		iter->_value.view = 0;
 	}
 
 	_cachedViews.clear();
 }
 
+void GfxCache::purgeCelBitmapCache() {
+	for (CelBitmapCache::iterator iter = _cachedCelBitmaps.begin(); iter != _cachedCelBitmaps.end(); ++iter) {
+		for (uint i = 0; i < iter->_value.bitmaps.size(); i++)
+			delete[] iter->_value.bitmaps[i];
+	}
+
+	_cachedCelBitmaps.clear();
+	_celBitmapMemory = 0;
+}
+
+void GfxCache::evictFont() {
+	FontCache::iterator oldest = _cachedFonts.begin();
+	for (FontCache::iterator iter = _cachedFonts.begin(); iter != _cachedFonts.end(); ++iter) {
+		if (iter->_value.lastUsed < oldest->_value.lastUsed)
+			oldest = iter;
+	}
+
+	delete oldest->_value.font;
+	_cachedFonts.erase(oldest);
+}
+
+uint32 GfxCache::evictView() {
+	ViewCache::iterator oldest = _cachedViews.begin();
+	for (ViewCache::iterator iter = _cachedViews.begin(); iter != _cachedViews.end(); ++iter) {
+		if (iter->_value.lastUsed < oldest->_value.lastUsed)
+			oldest = iter;
+	}
+
+	const int viewId = oldest->_key;
+	GfxView *view = oldest->_value.view;
+	const uint32 memory = view->getMemorySize();
+	_cachedViews.erase(oldest);
+	_stats.viewEvictions++;
+
+	// Keep the decoded cels around, parsing the view again is cheap compared
+	// to decoding them
+	CachedCelBitmaps cels;
+	cels.size = view->releaseBitmaps(cels.bitmaps);
+	cels.lastUsed = _useCounter;
+	delete view;
+
+	if (!cels.size || cels.size > MAX_CACHED_CEL_MEMORY) {
+		for (uint i = 0; i < cels.bitmaps.size(); i++)
+			delete[] cels.bitmaps[i];
+		return memory;
+	}
+
+	while (_celBitmapMemory + cels.size > MAX_CACHED_CEL_MEMORY)
+		evictCelBitmaps();
+
+	_cachedCelBitmaps[viewId] = cels;
+	_celBitmapMemory += cels.size;
+	return memory;
+}
+
+void GfxCache::evictCelBitmaps() {
+	CelBitmapCache::iterator oldest = _cachedCelBitmaps.begin();
+	for (CelBitmapCache::iterator iter = _cachedCelBitmaps.begin(); iter != _cachedCelBitmaps.end(); ++iter) {
+		if (iter->_value.lastUsed < oldest->_value.lastUsed)
+			oldest = iter;
+	}
+
+	for (uint i = 0; i < oldest->_value.bitmaps.size(); i++)
+		delete[] oldest->_value.bitmaps[i];
+	_celBitmapMemory -= oldest->_value.size;
+	_cachedCelBitmaps.erase(oldest);
+}
+
+void GfxCache::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+uint32 GfxCache::getViewMemory() const {
+	uint32 memory = 0;
+	for (ViewCache::const_iterator iter = _cachedViews.begin(); iter != _cachedViews.end(); ++iter)
+		memory += iter->_value.view->getMemorySize();
+	return memory;
+}
+
 GfxFont *GfxCache::getFont(GuiResourceId fontId) {
-	if (_cachedFonts.size() >= MAX_CACHED_FONTS)
-		purgeFontCache();
-
-	if (!_cachedFonts.contains(fontId)) {
-		// Create special SJIS font in japanese games, when font 900 is selected
-		if ((fontId == 900) && (g_sci->getLanguage() == Common::JA_JPN))
-			_cachedFonts[fontId] = new GfxFontSjis(_screen, fontId);
-		else
-			_cachedFonts[fontId] = new GfxFontFromResource(_resMan, _screen, fontId);
+	FontCache::iterator iter = _cachedFonts.find(fontId);
+	if (iter != _cachedFonts.end()) {
+		_stats.fontHits++;
+		iter->_value.lastUsed = ++_useCounter;
+		return iter->_value.font;
 	}
 
-	return _cachedFonts[fontId];
+	_stats.fontMisses++;
+	while (_cachedFonts.size() >= MAX_CACHED_FONTS)
+		evictFont();
+
+	CachedFont &entry = _cachedFonts[fontId];
+	// Create special SJIS font in japanese games, when font 900 is selected
+	if ((fontId == 900) && (g_sci->getLanguage() == Common::JA_JPN))
+		entry.font = new GfxFontSjis(_screen, fontId);
+	else
+		entry.font = new GfxFontFromResource(_resMan, _screen, fontId);
+	entry.lastUsed = ++_useCounter;
+
+	return entry.font;
 }
 
 GfxView *GfxCache::getView(GuiResourceId viewId) {
-	if (_cachedViews.size() >= MAX_CACHED_VIEWS)
-		purgeViewCache();
+	ViewCache::iterator iter = _cachedViews.find(viewId);
+	if (iter != _cachedViews.end()) {
+		_stats.viewHits++;
+		iter->_value.lastUsed = ++_useCounter;
+		return iter->_value.view;
+	}
+
+	_stats.viewMisses++;
+
+	// Remove the least recently used views, one at a time, until there is
+	// room for the new one
+	uint32 memory = getViewMemory();
+	while (!_cachedViews.empty() && (_cachedViews.size() >= MAX_CACHED_VIEWS || memory > MAX_CACHED_VIEW_MEMORY)) {
+		memory -= evictView();
+	}
+
+	GfxView *view = new GfxView(_resMan, _screen, _palette, viewId);
+
+	CelBitmapCache::iterator cels = _cachedCelBitmaps.find(viewId);
+	if (cels != _cachedCelBitmaps.end()) {
+		_stats.celBitmapHits++;
+		_celBitmapMemory -= cels->_value.size;
+		view->adoptBitmaps(cels->_value.bitmaps);
+		_cachedCelBitmaps.erase(cels);
+	}
 
-	if (!_cachedViews.contains(viewId))
-		_cachedViews[viewId] = new GfxView(_resMan, _screen, _palette, viewId);
+	CachedView &entry = _cachedViews[viewId];
+	entry.view = view;
+	entry.lastUsed = ++_useCounter;
 
-	return _cachedViews[viewId];
+	return view;
 }
 
 int16 GfxCache::kernelViewGetCelWidth(GuiResourceId viewId, int16 loopNo, int16 celNo) {
@@ -23,6 +23,7 @@
 #ifndef SCI_GRAPHICS_CACHE_H
 #define SCI_GRAPHICS_CACHE_H
 
+#include "common/array.h"
 #include "common/hashmap.h"
 
 namespace Sci {
@@ -30,14 +31,44 @@ namespace Sci {
 class GfxFont;
 class GfxView;
 
-typedef Common::HashMap<int, GfxFont *> FontCache;
-typedef Common::HashMap<int, GfxView *> ViewCache;
+struct CachedFont {
+	GfxFont *font;
+	uint32 lastUsed;
+};
+
+struct CachedView {
+	GfxView *view;
+	uint32 lastUsed;
+};
+
+/** Decoded cel bitmaps of a view which was removed from the view cache */
+struct CachedCelBitmaps {
+	Common::Array<byte *> bitmaps;
+	uint32 size;
+	uint32 lastUsed;
+};
+
+typedef Common::HashMap<int, CachedFont> FontCache;
+typedef Common::HashMap<int, CachedView> ViewCache;
+typedef Common::HashMap<int, CachedCelBitmaps> CelBitmapCache;
 
 /**
- * Cache class, handles caching of views/fonts
+ * Font and view cache class, keeps the most recently used fonts and views
+ * parsed in memory. Views are limited by the memory they use including
+ * their decoded cel bitmaps, and when a view is removed, its decoded cel
+ * bitmaps are kept for a while longer.
  */
 class GfxCache {
 public:
+	struct Stats {
+		uint32 fontHits;
+		uint32 fontMisses;
+		uint32 viewHits;
+		uint32 viewMisses;
+		uint32 celBitmapHits;	///< View misses which could reuse decoded cels
+		uint32 viewEvictions;
+	};
+
 	GfxCache(ResourceManager *resMan, GfxScreen *screen, GfxPalette *palette);
 	~GfxCache();
 
@@ -49,9 +80,19 @@ public:
 	int16 kernelViewGetLoopCount(GuiResourceId viewId);
 	int16 kernelViewGetCelCount(GuiResourceId viewId, int16 loopNo);
 
+	const Stats &getStats() const { return _stats; }
+	void resetStats();
+	uint32 getViewMemory() const;
+	uint32 getCelBitmapMemory() const { return _celBitmapMemory; }
+
 private:
 	void purgeFontCache();
 	void purgeViewCache();
+	void purgeCelBitmapCache();
+
+	void evictFont();
+	uint32 evictView();
+	void evictCelBitmaps();
 
 	ResourceManager *_resMan;
 	GfxScreen *_screen;
@@ -59,6 +100,11 @@ private:
 
 	FontCache _cachedFonts;
 	ViewCache _cachedViews;
+	CelBitmapCache _cachedCelBitmaps;
+	uint32 _celBitmapMemory;
+
+	uint32 _useCounter;
+	Stats _stats;
 };
 
 } // End of namespace Sci
@@ -56,6 +56,10 @@ GfxFrameout::GfxFrameout(SegManager *segMan, ResourceManager *resMan, GfxCoordAd
 	_coordAdjuster = (GfxCoordAdjuster32 *)coordAdjuster;
 	scriptsRunningWidth = 320;
 	scriptsRunningHeight = 200;
+
+	_fullRedraw = true;
+	_showDamage = false;
+	resetStats();
 }
 
 GfxFrameout::~GfxFrameout() {
@@ -65,6 +69,16 @@ void GfxFrameout::clear() {
 	_screenItems.clear();
 	_planes.clear();
 	_planePictures.clear();
+	_lastDrawList.clear();
+	invalidateScreen();
+}
+
+void GfxFrameout::invalidateScreen() {
+	_fullRedraw = true;
+}
+
+void GfxFrameout::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 void GfxFrameout::kernelAddPlane(reg_t object) {
@@ -192,6 +206,7 @@ void GfxFrameout::kernelDeletePlane(reg_t object) {
 			planeRect.clip(screenRect); // we need to do this, at least in gk1 on cemetary we get bottom right -> 201, 321
 			// Blackout removed plane rect
 			_paint32->fillRect(planeRect, 0);
+			addDamage(planeRect);
 			return;
 		}
 	}
@@ -354,6 +369,189 @@ static int16 GetLongest(const char *text, int16 maxWidth, GfxFont *font) {
 	return maxChars;
 }
 
+FrameoutDrawEntry::FrameoutDrawEntry() : type(kDrawPlane), resourceId(0), loopNo(0), celNo(0), x(0), y(0),
+	pictureX(0), scaleX(0), scaleY(0), width(0), color(0), flag(false), picture(0) {
+}
+
+bool FrameoutDrawEntry::operator==(const FrameoutDrawEntry &other) const {
+	return type == other.type && bounds == other.bounds && resourceId == other.resourceId &&
+		loopNo == other.loopNo && celNo == other.celNo && x == other.x && y == other.y &&
+		pictureX == other.pictureX && scaleX == other.scaleX && scaleY == other.scaleY &&
+		width == other.width && color == other.color && flag == other.flag &&
+		celRect == other.celRect && clipRect == other.clipRect &&
+		translatedClipRect == other.translatedClipRect && text == other.text;
+}
+
+// Lays out the lines of a text entry and returns the part of the screen they
+// cover. The text gets drawn as well, if requested.
+static Common::Rect layoutText(GfxFont *font, const FrameoutDrawEntry &entry, bool draw) {
+	Common::Rect bounds;
+	const char *txt = entry.text.c_str();
+	uint16 curY = entry.y;
+	int16 charCount;
+
+	while (*txt) {
+		charCount = GetLongest(txt, entry.width, font);
+		if (charCount == 0)
+			break;
+
+		uint16 curX = entry.x;
+
+		for (int i = 0; i < charCount; i++) {
+			unsigned char curChar = txt[i];
+			if (draw)
+				font->draw(curChar, curY, curX, entry.color, entry.flag);
+			curX += font->getCharWidth(curChar);
+		}
+
+		Common::Rect lineRect(entry.x, curY, curX, curY + font->getHeight());
+		if (bounds.isEmpty())
+			bounds = lineRect;
+		else
+			bounds.extend(lineRect);
+
+		curY += font->getHeight();
+		txt += charCount;
+		while (*txt == ' ')
+			txt++; // skip over breaking spaces
+	}
+
+	return bounds;
+}
+
+void GfxFrameout::addDamage(const Common::Rect &rect) {
+	Common::addDirtyRect(_damage, rect, Common::Rect(_screen->getDisplayWidth(), _screen->getDisplayHeight()));
+}
+
+void GfxFrameout::findDamage(const FrameoutDrawList &drawList) {
+	const uint oldCount = _lastDrawList.size();
+	const uint newCount = drawList.size();
+
+	// Skip the entries at the start and the end that did not change
+	uint prefix = 0;
+	while (prefix < oldCount && prefix < newCount && _lastDrawList[prefix] == drawList[prefix])
+		prefix++;
+	uint suffix = 0;
+	while (suffix < oldCount - prefix && suffix < newCount - prefix &&
+			_lastDrawList[oldCount - 1 - suffix] == drawList[newCount - 1 - suffix])
+		suffix++;
+
+	const uint oldEnd = oldCount - suffix;
+	const uint newEnd = newCount - suffix;
+
+	// Pair up the remaining entries which are still there. Everything that
+	// disappeared or is new is damage. The paired entries draw the same as
+	// before, as long as they are drawn in the same order - otherwise
+	// overlapping ones might have swapped, so they are damage as well.
+	Common::Array<bool> paired;
+	paired.resize(oldEnd - prefix);
+	for (uint i = 0; i < paired.size(); i++)
+		paired[i] = false;
+
+	bool orderChanged = false;
+	uint lastPaired = 0;
+	for (uint newNr = prefix; newNr < newEnd; newNr++) {
+		uint oldNr = prefix;
+		while (oldNr < oldEnd && (paired[oldNr - prefix] || !(_lastDrawList[oldNr] == drawList[newNr])))
+			oldNr++;
+
+		if (oldNr == oldEnd) {
+			addDamage(drawList[newNr].bounds);
+			continue;
+		}
+
+		paired[oldNr - prefix] = true;
+		if (oldNr < lastPaired)
+			orderChanged = true;
+		lastPaired = oldNr;
+	}
+
+	for (uint oldNr = prefix; oldNr < oldEnd; oldNr++) {
+		if (!paired[oldNr - prefix] || orderChanged)
+			addDamage(_lastDrawList[oldNr].bounds);
+	}
+}
+
+void GfxFrameout::drawEntry(const FrameoutDrawEntry &entry, const Common::Rect *clipRect) {
+	switch (entry.type) {
+	case FrameoutDrawEntry::kDrawFill: {
+		Common::Rect fillRect = entry.bounds;
+		if (clipRect)
+			fillRect.clip(*clipRect);
+		_paint32->fillRect(fillRect, entry.color);
+		break;
+	}
+	case FrameoutDrawEntry::kDrawPictureCel:
+		entry.picture->drawSci32Vga(entry.celNo, entry.x, entry.y, entry.pictureX, entry.flag, clipRect);
+		break;
+	case FrameoutDrawEntry::kDrawView: {
+		GfxView *view = _cache->getView(entry.resourceId);
+		Common::Rect viewClipRect = entry.clipRect;
+		Common::Rect translatedClipRect = entry.translatedClipRect;
+		if (clipRect) {
+			// Shrink both clip rects by the same amount
+			translatedClipRect.clip(*clipRect);
+			viewClipRect = translatedClipRect;
+			viewClipRect.translate(entry.clipRect.left - entry.translatedClipRect.left, entry.clipRect.top - entry.translatedClipRect.top);
+		}
+
+		if (translatedClipRect.isEmpty()) {
+			setEntryPalette(entry);
+			break;
+		}
+
+		if ((entry.scaleX == 128) && (entry.scaleY == 128))
+			view->draw(entry.celRect, viewClipRect, translatedClipRect, entry.loopNo, entry.celNo, 255, 0, entry.flag);
+		else
+			view->drawScaled(entry.celRect, viewClipRect, translatedClipRect, entry.loopNo, entry.celNo, 255, entry.scaleX, entry.scaleY);
+		break;
+	}
+	case FrameoutDrawEntry::kDrawText:
+		// Text can't be clipped, kernelFrameout() grows the clip rect instead
+		layoutText(_cache->getFont(entry.resourceId), entry, true);
+		break;
+	default:
+		break;
+	}
+}
+
+// Applies the palette changes that drawing the entry would do, for entries
+// that don't get drawn because nothing changed in their area
+void GfxFrameout::setEntryPalette(const FrameoutDrawEntry &entry) {
+	if (entry.type == FrameoutDrawEntry::kDrawPictureCel) {
+		if (entry.celNo == 0)
+			entry.picture->setSci32Palette();
+	} else if (entry.type == FrameoutDrawEntry::kDrawView) {
+		Palette *viewPalette = _cache->getView(entry.resourceId)->getPalette();
+		if (viewPalette)
+			_palette->set(viewPalette, false);
+	}
+}
+
+void GfxFrameout::updateScreenRect(const Common::Rect &rect) {
+	if (_screen->getUpscaledHires())
+		_screen->copyDisplayRectToScreen(rect);
+	else
+		_screen->copyRectToScreen(rect);
+}
+
+void GfxFrameout::drawDamageOverlay() {
+	const uint16 lineSize = MAX(_screen->getDisplayWidth(), _screen->getDisplayHeight());
+	byte *line = new byte[lineSize];
+	memset(line, _screen->getColorWhite(), lineSize);
+
+	for (uint i = 0; i < _damage.size(); i++) {
+		const Common::Rect &rect = _damage[i];
+		g_system->copyRectToScreen(line, rect.width(), rect.left, rect.top, rect.width(), 1);
+		g_system->copyRectToScreen(line, rect.width(), rect.left, rect.bottom - 1, rect.width(), 1);
+		g_system->copyRectToScreen(line, 1, rect.left, rect.top, 1, rect.height());
+		g_system->copyRectToScreen(line, 1, rect.right - 1, rect.top, 1, rect.height());
+	}
+
+	delete[] line;
+	_overlayRects = _damage;
+}
+
 void GfxFrameout::kernelFrameout() {
 	if (g_sci->_robotDecoder->isVideoLoaded()) {
 		bool skipVideo = false;
@@ -385,11 +583,18 @@ void GfxFrameout::kernelFrameout() {
 
 			g_system->delayMillis(10);
 		}
+
+		// The video was drawn directly to the screen
+		invalidateScreen();
 		return;
 	}
 
 	_palette->palVaryUpdate();
 
+	// Lay out the frame. Screen items are updated and get their ns rect as
+	// usual, but drawing is only recorded at first.
+	FrameoutDrawList drawList;
+
 	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); it++) {
 		reg_t planeObject = it->object;
 		uint16 planeLastPriority = it->lastPriority;
@@ -400,18 +605,31 @@ void GfxFrameout::kernelFrameout() {
 		it->lastPriority = planePriority;
 		if (planePriority == 0xffff) { // Plane currently not meant to be shown
 			// If plane was shown before, delete plane rect
-			if (planePriority != planeLastPriority)
-				_paint32->fillRect(it->planeRect, 0);
+			if (planePriority != planeLastPriority) {
+				FrameoutDrawEntry fillEntry;
+				fillEntry.type = FrameoutDrawEntry::kDrawFill;
+				fillEntry.bounds = it->planeRect;
+				fillEntry.color = 0;
+				drawList.push_back(fillEntry);
+			}
 			continue;
 		}
 
-		if (it->planeBack)
-			_paint32->fillRect(it->planeRect, it->planeBack);
+		if (it->planeBack) {
+			FrameoutDrawEntry fillEntry;
+			fillEntry.type = FrameoutDrawEntry::kDrawFill;
+			fillEntry.bounds = it->planeRect;
+			fillEntry.color = it->planeBack;
+			drawList.push_back(fillEntry);
+		}
 
 		GuiResourceId planeMainPictureId = it->pictureId;
 
-		_coordAdjuster->pictureSetDisplayArea(it->planeRect);
-		_palette->drewPicture(planeMainPictureId);
+		FrameoutDrawEntry planeEntry;
+		planeEntry.type = FrameoutDrawEntry::kDrawPlane;
+		planeEntry.resourceId = planeMainPictureId;
+		planeEntry.clipRect = it->planeRect;
+		drawList.push_back(planeEntry);
 
 		FrameoutList itemList;
 
@@ -464,8 +682,9 @@ void GfxFrameout::kernelFrameout() {
 				itemEntry->picStartX = ((itemEntry->picStartX * _screen->getWidth()) / scriptsRunningWidth);
 
 				// Out of view
+				int16 pictureCelWidth = itemEntry->picture->getSci32celWidth(itemEntry->celNo);
 				int16 pictureCelStartX = itemEntry->picStartX + itemEntry->x;
-				int16 pictureCelEndX = pictureCelStartX + itemEntry->picture->getSci32celWidth(itemEntry->celNo);
+				int16 pictureCelEndX = pictureCelStartX + pictureCelWidth;
 				int16 planeStartX = it->planeOffsetX;
 				int16 planeEndX = planeStartX + it->planeRect.width();
 				if (pictureCelEndX < planeStartX)
@@ -484,7 +703,32 @@ void GfxFrameout::kernelFrameout() {
 					}
 				}
 
-				itemEntry->picture->drawSci32Vga(itemEntry->celNo, pictureX, itemEntry->y, pictureOffsetX, it->planePictureMirrored);
+				FrameoutDrawEntry celEntry;
+				celEntry.type = FrameoutDrawEntry::kDrawPictureCel;
+				celEntry.resourceId = itemEntry->picture->getResourceId();
+				celEntry.picture = itemEntry->picture;
+				celEntry.celNo = itemEntry->celNo;
+				celEntry.x = pictureX;
+				celEntry.y = itemEntry->y;
+				celEntry.pictureX = pictureOffsetX;
+				celEntry.flag = it->planePictureMirrored;
+				celEntry.clipRect = it->planeRect;
+
+				// Same placement as in GfxPicture::drawSci32Vga() and drawCelData()
+				int16 celX = pictureX;
+				if (it->planePictureMirrored)
+					celX = it->planeRect.width() - celX - pictureCelWidth;
+				celX -= pictureOffsetX;
+				int16 celLeft = it->planeRect.left + celX;
+				if (pictureOffsetX && celX < 0)
+					celLeft = it->planeRect.left;
+				int16 celTop = it->planeRect.top + itemEntry->y;
+				int16 celRight = MIN<int16>(it->planeRect.left + celX + pictureCelWidth, it->planeRect.right);
+				int16 celBottom = MIN<int16>(celTop + itemEntry->picture->getSci32celHeight(itemEntry->celNo), it->planeRect.bottom);
+				if (celLeft < celRight && celTop < celBottom)
+					celEntry.bounds = Common::Rect(celLeft, celTop, celRight, celBottom);
+
+				drawList.push_back(celEntry);
 //				warning("picture cel %d %d", itemEntry->celNo, itemEntry->priority);
 
 			} else if (itemEntry->viewId != 0xFFFF) {
@@ -571,10 +815,19 @@ void GfxFrameout::kernelFrameout() {
 				}
 
 				if (!clipRect.isEmpty()) {
-					if ((itemEntry->scaleX == 128) && (itemEntry->scaleY == 128))
-						view->draw(itemEntry->celRect, clipRect, translatedClipRect, itemEntry->loopNo, itemEntry->celNo, 255, 0, view->isSci2Hires());
-					else
-						view->drawScaled(itemEntry->celRect, clipRect, translatedClipRect, itemEntry->loopNo, itemEntry->celNo, 255, itemEntry->scaleX, itemEntry->scaleY);
+					FrameoutDrawEntry viewEntry;
+					viewEntry.type = FrameoutDrawEntry::kDrawView;
+					viewEntry.bounds = translatedClipRect;
+					viewEntry.resourceId = itemEntry->viewId;
+					viewEntry.loopNo = itemEntry->loopNo;
+					viewEntry.celNo = itemEntry->celNo;
+					viewEntry.scaleX = itemEntry->scaleX;
+					viewEntry.scaleY = itemEntry->scaleY;
+					viewEntry.flag = view->isSci2Hires();
+					viewEntry.celRect = itemEntry->celRect;
+					viewEntry.clipRect = clipRect;
+					viewEntry.translatedClipRect = translatedClipRect;
+					drawList.push_back(viewEntry);
 				}
 			} else {
 				// Most likely a text entry
@@ -589,24 +842,25 @@ void GfxFrameout::kernelFrameout() {
 					if (_segMan->isHeapObject(stringObject))
 						stringObject = readSelector(_segMan, stringObject, SELECTOR(data));
 
-					Common::String text = _segMan->getString(stringObject);
-					GfxFont *font = _cache->getFont(readSelectorValue(_segMan, itemEntry->object, SELECTOR(font)));
-					bool dimmed = readSelectorValue(_segMan, itemEntry->object, SELECTOR(dimmed));
-					uint16 foreColor = readSelectorValue(_segMan, itemEntry->object, SELECTOR(fore));
+					FrameoutDrawEntry textEntry;
+					textEntry.type = FrameoutDrawEntry::kDrawText;
+					textEntry.text = _segMan->getString(stringObject);
+					textEntry.resourceId = readSelectorValue(_segMan, itemEntry->object, SELECTOR(font));
+					textEntry.flag = readSelectorValue(_segMan, itemEntry->object, SELECTOR(dimmed));
+					textEntry.color = readSelectorValue(_segMan, itemEntry->object, SELECTOR(fore));
+					GfxFont *font = _cache->getFont(textEntry.resourceId);
 
 					itemEntry->y = ((itemEntry->y * _screen->getHeight()) / scriptsRunningHeight);
 					itemEntry->x = ((itemEntry->x * _screen->getWidth()) / scriptsRunningWidth);
 
 					uint16 startX = itemEntry->x + it->planeRect.left;
 					uint16 curY = itemEntry->y + it->planeRect.top;
-					const char *txt = text.c_str();
 					// HACK. The plane sometimes doesn't contain the correct width. This
 					// hack breaks the dialog options when speaking with Grace, but it's
 					// the best we got up to now. This happens because of the unimplemented
 					// kTextWidth function in SCI32.
 					// TODO: Remove this once kTextWidth has been implemented.
 					uint16 w = it->planeRect.width() >= 20 ? it->planeRect.width() : _screen->getWidth() - 10;
-					int16 charCount;
 
 					// Upscale the coordinates/width if the fonts are already upscaled
 					if (_screen->fontIsUpscaled()) {
@@ -615,25 +869,11 @@ void GfxFrameout::kernelFrameout() {
 						w  = w * _screen->getDisplayWidth() / _screen->getWidth();
 					}
 
-					while (*txt) {
-						charCount = GetLongest(txt, w, font);
-						if (charCount == 0)
-							break;
-
-						uint16 curX = startX;
-
-						for (int i = 0; i < charCount; i++) {
-							unsigned char curChar = txt[i];
-							font->draw(curChar, curY, curX, foreColor, dimmed);
-							curX += font->getCharWidth(curChar);
-						}
-
-						curY += font->getHeight();
-						txt += charCount;
-						while (*txt == ' ')
-							txt++; // skip over breaking spaces
-					}
-
+					textEntry.x = startX;
+					textEntry.y = curY;
+					textEntry.width = w;
+					textEntry.bounds = layoutText(font, textEntry, false);
+					drawList.push_back(textEntry);
 				}
 			}
 		}
@@ -646,7 +886,89 @@ void GfxFrameout::kernelFrameout() {
 		}
 	}
 
-	_screen->copyToScreen();
+	// Find out what changed since the last frame
+	const Common::Rect displayRect(_screen->getDisplayWidth(), _screen->getDisplayHeight());
+	findDamage(drawList);
+	if (_fullRedraw) {
+		_damage.clear();
+		_damage.push_back(displayRect);
+		_fullRedraw = false;
+	}
+
+	// In upscaled hires mode, pictures and views don't share the same
+	// coordinates, so any change redraws the whole screen
+	bool clipDrawing = !_screen->getUpscaledHires();
+	Common::Rect clipRect;
+	if (!_damage.empty()) {
+		clipRect = _damage[0];
+		for (uint i = 1; i < _damage.size(); i++)
+			clipRect.extend(_damage[i]);
+		if (!clipDrawing)
+			clipRect = displayRect;
+
+		// Text can't be drawn partially. Instead, the clip rect is grown to
+		// cover any text that it touches.
+		bool grown = clipDrawing;
+		while (grown) {
+			grown = false;
+			for (uint i = 0; i < drawList.size(); i++) {
+				const Common::Rect &textRect = drawList[i].bounds;
+				if (drawList[i].type == FrameoutDrawEntry::kDrawText && textRect.intersects(clipRect) && !clipRect.contains(textRect)) {
+					clipRect.extend(textRect);
+					grown = true;
+				}
+			}
+		}
+	}
+
+	// Now draw everything that touches the clip rect. Entries outside of it
+	// would draw exactly what is already there, but their palette changes
+	// still have to happen, in the same order.
+	for (uint i = 0; i < drawList.size(); i++) {
+		const FrameoutDrawEntry &entry = drawList[i];
+
+		if (entry.type == FrameoutDrawEntry::kDrawPlane) {
+			_coordAdjuster->pictureSetDisplayArea(entry.clipRect);
+			_palette->drewPicture(entry.resourceId);
+		} else if (!clipDrawing && !clipRect.isEmpty()) {
+			drawEntry(entry, NULL);
+		} else if (entry.bounds.intersects(clipRect)) {
+			drawEntry(entry, &clipRect);
+		} else {
+			setEntryPalette(entry);
+		}
+	}
+
+	// Remove the outlines of the previous frame, then update the changed
+	// parts of the screen
+	for (uint i = 0; i < _overlayRects.size(); i++)
+		updateScreenRect(_overlayRects[i]);
+	_overlayRects.clear();
+
+	_stats.frames++;
+	if (_damage.empty()) {
+		_stats.skippedFrames++;
+	} else {
+		if (!clipDrawing) {
+			_damage.clear();
+			_damage.push_back(displayRect);
+		}
+
+		for (uint i = 0; i < _damage.size(); i++)
+			updateScreenRect(_damage[i]);
+
+		if (clipRect == displayRect)
+			_stats.fullFrames++;
+		else
+			_stats.partialFrames++;
+		_stats.redrawnPixels += clipRect.width() * clipRect.height();
+
+		if (_showDamage)
+			drawDamageOverlay();
+	}
+
+	_damage.clear();
+	_lastDrawList = drawList;
 
 	g_sci->getEngineState()->_throttleTrigger = true;
 }
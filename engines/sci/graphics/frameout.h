@@ -72,6 +72,51 @@ struct PlanePictureEntry {
 
 typedef Common::List<PlanePictureEntry> PlanePictureList;
 
+/**
+ * One drawing step of a frame, as recorded by kernelFrameout(). The steps of
+ * two frames are compared to find the parts of the screen that changed.
+ */
+struct FrameoutDrawEntry {
+	enum Type {
+		kDrawPlane,			///< sets up the display area of a plane, draws nothing
+		kDrawFill,
+		kDrawPictureCel,
+		kDrawView,
+		kDrawText
+	};
+
+	FrameoutDrawEntry();
+	bool operator==(const FrameoutDrawEntry &other) const;
+
+	Type type;
+	Common::Rect bounds;	///< part of the screen that the step may change
+	GuiResourceId resourceId;	///< picture, view or font
+	int16 loopNo;
+	int16 celNo;
+	int16 x, y;
+	int16 pictureX;
+	int16 scaleX;
+	int16 scaleY;
+	uint16 width;			///< wrap width of text
+	uint16 color;
+	bool flag;				///< mirrored picture, hires view or dimmed text
+	Common::Rect celRect;
+	Common::Rect clipRect;	///< for kDrawPlane, the display area
+	Common::Rect translatedClipRect;
+	Common::String text;
+	GfxPicture *picture;	///< only valid during the frame that recorded the entry
+};
+
+typedef Common::Array<FrameoutDrawEntry> FrameoutDrawList;
+
+struct FrameoutStats {
+	uint32 frames;
+	uint32 skippedFrames;	///< frames in which nothing changed
+	uint32 partialFrames;
+	uint32 fullFrames;
+	uint32 redrawnPixels;
+};
+
 class GfxCache;
 class GfxCoordAdjuster32;
 class GfxPaint32;
@@ -100,6 +145,17 @@ public:
 	void deletePlanePictures(reg_t object);
 	void clear();
 
+	/**
+	 * Makes the next frame redraw and update the whole screen. Needs to be
+	 * called when something else has drawn over the screen, e.g. a video.
+	 */
+	void invalidateScreen();
+
+	void setShowDamage(bool show) { _showDamage = show; }
+	bool getShowDamage() const { return _showDamage; }
+	const FrameoutStats &getStats() const { return _stats; }
+	void resetStats();
+
 private:
 	SegManager *_segMan;
 	ResourceManager *_resMan;
@@ -115,6 +171,23 @@ private:
 
 	void sortPlanes();
 
+	void addDamage(const Common::Rect &rect);
+	void findDamage(const FrameoutDrawList &drawList);
+	void drawEntry(const FrameoutDrawEntry &entry, const Common::Rect *clipRect);
+	void setEntryPalette(const FrameoutDrawEntry &entry);
+	void updateScreenRect(const Common::Rect &rect);
+	void drawDamageOverlay();
+
+	/** The drawing steps of the last frame */
+	FrameoutDrawList _lastDrawList;
+	/** Changed parts of the screen in display coordinates, merged where they overlap */
+	Common::Array<Common::Rect> _damage;
+	bool _fullRedraw;
+	/** Outline the redrawn parts of the screen */
+	bool _showDamage;
+	Common::Array<Common::Rect> _overlayRects;
+	FrameoutStats _stats;
+
 	uint16 scriptsRunningWidth;
 	uint16 scriptsRunningHeight;
 };
@@ -59,6 +59,11 @@ GfxPalette::GfxPalette(ResourceManager *resMan, GfxScreen *screen, bool useMergi
 
 	_sysPaletteChanged = false;
 
+	memset(_colorMatchCache, 0, sizeof(_colorMatchCache));
+	_sysPaletteVersion = 1;
+	_usedColorsVersion = 0;
+	_usedColorCount = 0;
+
 	// Quest for Glory 3 demo, Eco Quest 1 demo, Laura Bow 2 demo, Police Quest
 	// 1 vga and all Nick's Picks all use the older palette format and thus are
 	// not using the SCI1.1 palette merging (copying over all the colors) but
@@ -207,6 +212,7 @@ bool GfxPalette::setAmiga() {
 			_sysPalette.colors[curColor].g = ((byte2 & 0xF0) >> 4) * 0x11;
 			_sysPalette.colors[curColor].b = (byte2 & 0x0F) * 0x11;
 		}
+		invalidateColorMatches();
 
 		// Directly set the palette, because setOnScreen() wont do a thing for amiga
 		copySysPaletteToScreen();
@@ -227,6 +233,7 @@ void GfxPalette::modifyAmigaPalette(byte *data) {
 		_sysPalette.colors[curColor].g = ((byte2 & 0xF0) >> 4) * 0x11;
 		_sysPalette.colors[curColor].b = (byte2 & 0x0F) * 0x11;
 	}
+	invalidateColorMatches();
 
 	copySysPaletteToScreen();
 }
@@ -274,6 +281,7 @@ void GfxPalette::setEGA() {
 		_sysPalette.colors[curColor].b = blendColors(_sysPalette.colors[color1].b, _sysPalette.colors[color2].b);
 	}
 	_sysPalette.timestamp = 1;
+	invalidateColorMatches();
 	setOnScreen();
 }
 
@@ -323,6 +331,9 @@ bool GfxPalette::insert(Palette *newPalette, Palette *destPalette) {
 		}
 	}
 
+	if (destPalette == &_sysPalette)
+		invalidateColorMatches();
+
 	// We don't update the timestamp for SCI1.1, it's only updated on kDrawPic calls
 	return paletteChanged;
 }
@@ -345,6 +356,7 @@ bool GfxPalette::merge(Palette *newPalette, bool force, bool forceRealMerge) {
 				_sysPalette.colors[i].b = newPalette->colors[i].b;
 				paletteChanged = true;
 			}
+			invalidateColorMatches();
 			newPalette->mapping[i] = i;
 			continue;
 		}
@@ -373,6 +385,7 @@ bool GfxPalette::merge(Palette *newPalette, bool force, bool forceRealMerge) {
 				_sysPalette.colors[j].r = newPalette->colors[i].r;
 				_sysPalette.colors[j].g = newPalette->colors[i].g;
 				_sysPalette.colors[j].b = newPalette->colors[i].b;
+				invalidateColorMatches();
 				newPalette->mapping[i] = j;
 				paletteChanged = true;
 				break;
@@ -405,28 +418,60 @@ void GfxPalette::drewPicture(GuiResourceId pictureId) {
 }
 
 uint16 GfxPalette::matchColor(byte r, byte g, byte b) {
-	byte found = 0xFF;
-	int diff = 0x2FFFF, cdiff;
-	int16 dr,dg,db;
+	const uint32 rgb = (r << 16) | (g << 8) | b;
+	ColorMatch &match = _colorMatchCache[(rgb ^ (rgb >> 12)) & (kColorMatchCacheSize - 1)];
 
-	for (int i = 1; i < 255; i++) {
-		if ((!_sysPalette.colors[i].used))
-			continue;
-		dr = _sysPalette.colors[i].r - r;
-		dg = _sysPalette.colors[i].g - g;
-		db = _sysPalette.colors[i].b - b;
+	if (match.version != _sysPaletteVersion || match.rgb != rgb) {
+		match.version = _sysPaletteVersion;
+		match.rgb = rgb;
+		match.result = matchColorUncached(r, g, b);
+	}
+	return match.result;
+}
+
+uint16 GfxPalette::matchColorUncached(byte r, byte g, byte b) {
+	if (_usedColorsVersion != _sysPaletteVersion) {
+		_usedColorCount = 0;
+		for (int i = 1; i < 255; i++) {
+			if (!_sysPalette.colors[i].used)
+				continue;
+			_usedColorsR[_usedColorCount] = _sysPalette.colors[i].r;
+			_usedColorsG[_usedColorCount] = _sysPalette.colors[i].g;
+			_usedColorsB[_usedColorCount] = _sysPalette.colors[i].b;
+			_usedColorsIndex[_usedColorCount] = i;
+			_usedColorCount++;
+		}
+		_usedColorsVersion = _sysPaletteVersion;
+	}
+
+	if (!_usedColorCount)
+		return 0xFF;
+
+	// Calculate all differences first, without any branches, so that the
+	// compiler is able to vectorize these loops
+	int diff[256];
+	for (int i = 0; i < _usedColorCount; i++) {
+		const int dr = _usedColorsR[i] - r;
+		const int dg = _usedColorsG[i] - g;
+		const int db = _usedColorsB[i] - b;
 //		minimum squares match
-		cdiff = (dr*dr) + (dg*dg) + (db*db);
+		diff[i] = (dr*dr) + (dg*dg) + (db*db);
 //		minimum sum match (Sierra's)
-//		cdiff = ABS(dr) + ABS(dg) + ABS(db);
-		if (cdiff < diff) {
-			if (cdiff == 0)
-				return i | 0x8000; // setting this flag to indicate exact match
-			found = i;
-			diff = cdiff;
-		}
+//		diff[i] = ABS(dr) + ABS(dg) + ABS(db);
 	}
-	return found;
+
+	int minDiff = diff[0];
+	for (int i = 1; i < _usedColorCount; i++)
+		minDiff = MIN(minDiff, diff[i]);
+
+	// Like the original scan, prefer the lowest color index
+	int found = 0;
+	while (diff[found] != minDiff)
+		found++;
+
+	if (minDiff == 0)
+		return _usedColorsIndex[found] | 0x8000; // setting this flag to indicate exact match
+	return _usedColorsIndex[found];
 }
 
 void GfxPalette::getSys(Palette *pal) {
@@ -484,6 +529,7 @@ void GfxPalette::kernelSetFlag(uint16 fromColor, uint16 toColor, uint16 flag) {
 	for (colorNr = fromColor; colorNr < toColor; colorNr++) {
 		_sysPalette.colors[colorNr].used |= flag;
 	}
+	invalidateColorMatches();
 }
 
 void GfxPalette::kernelUnsetFlag(uint16 fromColor, uint16 toColor, uint16 flag) {
@@ -491,6 +537,7 @@ void GfxPalette::kernelUnsetFlag(uint16 fromColor, uint16 toColor, uint16 flag)
 	for (colorNr = fromColor; colorNr < toColor; colorNr++) {
 		_sysPalette.colors[colorNr].used &= ~flag;
 	}
+	invalidateColorMatches();
 }
 
 void GfxPalette::kernelSetIntensity(uint16 fromColor, uint16 toColor, uint16 intensity, bool setPalette) {
@@ -554,6 +601,7 @@ bool GfxPalette::kernelAnimate(byte fromColor, byte toColor, int speed) {
 					}
 					_sysPalette.colors[fromColor] = col;
 				}
+				invalidateColorMatches();
 				// removing schedule
 				_schedules[scheduleNr].schedule = now + ABS(speed);
 				// TODO: Not sure when sierra actually removes a schedule
@@ -631,6 +679,7 @@ void GfxPalette::kernelSyncScreenPalette() {
 		_sysPalette.colors[i].g = bpal[i * 3 + 1];
 		_sysPalette.colors[i].b = bpal[i * 3 + 2];
 	}
+	invalidateColorMatches();
 }
 
 // palVary
@@ -851,6 +900,7 @@ void GfxPalette::palVaryProcess(int signal, bool setPalette) {
 		if (memcmp(&inbetween, &_sysPalette.colors[colorNr], sizeof(Sci::Color))) {
 			_sysPalette.colors[colorNr] = inbetween;
 			_sysPaletteChanged = true;
+			invalidateColorMatches();
 		}
 	}
 
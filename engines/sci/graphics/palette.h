@@ -49,7 +49,23 @@ public:
 	void set(Palette *sciPal, bool force, bool forceRealMerge = false);
 	bool insert(Palette *newPalette, Palette *destPalette);
 	bool merge(Palette *pFrom, bool force, bool forceRealMerge);
+
+	/**
+	 * Finds the used color of the system palette which is closest to the
+	 * given one. Bit 15 of the result is set for an exact match. Results are
+	 * cached until the system palette changes.
+	 */
 	uint16 matchColor(byte r, byte g, byte b);
+
+	/** Same as matchColor(), but always scans the whole system palette */
+	uint16 matchColorUncached(byte r, byte g, byte b);
+
+	/**
+	 * Drops all cached matchColor() results. Must be called whenever colors
+	 * or used flags of _sysPalette get changed.
+	 */
+	void invalidateColorMatches() { _sysPaletteVersion++; }
+
 	void getSys(Palette *pal);
 	uint16 getTotalColorCount() const { return _totalScreenColors; }
 
@@ -110,6 +126,29 @@ private:
 	bool _sysPaletteChanged;
 	bool _useMerging;
 
+	/** A cached result of matchColor() */
+	struct ColorMatch {
+		uint32 version;	///< Entry is only valid if this matches _sysPaletteVersion
+		uint32 rgb;
+		uint16 result;
+	};
+
+	enum {
+		kColorMatchCacheSize = 4096	///< Number of cache slots, must be a power of two
+	};
+
+	ColorMatch _colorMatchCache[kColorMatchCacheSize];
+	uint32 _sysPaletteVersion;
+
+	// The used colors of the system palette, stored in separate arrays so
+	// that the compiler can vectorize the distance calculation
+	uint32 _usedColorsVersion;
+	int _usedColorCount;
+	int _usedColorsR[256];
+	int _usedColorsG[256];
+	int _usedColorsB[256];
+	byte _usedColorsIndex[256];
+
 	Common::Array<PalSchedule> _schedules;
 
 	GuiResourceId _palVaryResourceId;
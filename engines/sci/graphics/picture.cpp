@@ -169,6 +169,13 @@ int16 GfxPicture::getSci32celWidth(int16 celNo) {
 	return READ_SCI11ENDIAN_UINT16(inbuffer + cel_headerPos + 0);
 }
 
+int16 GfxPicture::getSci32celHeight(int16 celNo) {
+	byte *inbuffer = _resource->data;
+	int header_size = READ_SCI11ENDIAN_UINT16(inbuffer);
+	int cel_headerPos = header_size + 42 * celNo;
+	return READ_SCI11ENDIAN_UINT16(inbuffer + cel_headerPos + 2);
+}
+
 int16 GfxPicture::getSci32celPriority(int16 celNo) {
 	byte *inbuffer = _resource->data;
 	int header_size = READ_SCI11ENDIAN_UINT16(inbuffer);
@@ -176,26 +183,33 @@ int16 GfxPicture::getSci32celPriority(int16 celNo) {
 	return READ_SCI11ENDIAN_UINT16(inbuffer + cel_headerPos + 36);
 }
 
-void GfxPicture::drawSci32Vga(int16 celNo, int16 drawX, int16 drawY, int16 pictureX, bool mirrored) {
+void GfxPicture::setSci32Palette() {
 	byte *inbuffer = _resource->data;
 	int size = _resource->size;
-	int header_size = READ_SCI11ENDIAN_UINT16(inbuffer);
 	int palette_data_ptr = READ_SCI11ENDIAN_UINT32(inbuffer + 6);
+	Palette palette;
+
+	// Create palette and set it
+	_palette->createFromData(inbuffer + palette_data_ptr, size - palette_data_ptr, &palette);
+	_palette->set(&palette, true);
+}
+
+// When clipRect is given, only the pixels inside of it are drawn
+void GfxPicture::drawSci32Vga(int16 celNo, int16 drawX, int16 drawY, int16 pictureX, bool mirrored, const Common::Rect *clipRect) {
+	byte *inbuffer = _resource->data;
+	int size = _resource->size;
+	int header_size = READ_SCI11ENDIAN_UINT16(inbuffer);
 //	int celCount = inbuffer[2];
 	int cel_headerPos = header_size;
 	int cel_RlePos, cel_LiteralPos;
-	Palette palette;
 
 	// HACK
 	_mirroredFlag = mirrored;
 	_addToFlag = false;
 	_resourceType = SCI_PICTURE_TYPE_SCI32;
 
-	if (celNo == 0) {
-		// Create palette and set it
-		_palette->createFromData(inbuffer + palette_data_ptr, size - palette_data_ptr, &palette);
-		_palette->set(&palette, true);
-	}
+	if (celNo == 0)
+		setSci32Palette();
 
 	// Header
 	// [headerSize:WORD] [celCount:BYTE] [Unknown:BYTE] [Unknown:WORD] [paletteOffset:DWORD] [Unknown:DWORD]
@@ -216,14 +230,14 @@ void GfxPicture::drawSci32Vga(int16 celNo, int16 drawX, int16 drawY, int16 pictu
 	cel_RlePos = READ_SCI11ENDIAN_UINT32(inbuffer + cel_headerPos + 24);
 	cel_LiteralPos = READ_SCI11ENDIAN_UINT32(inbuffer + cel_headerPos + 28);
 
-	drawCelData(inbuffer, size, cel_headerPos, cel_RlePos, cel_LiteralPos, drawX, drawY, pictureX);
+	drawCelData(inbuffer, size, cel_headerPos, cel_RlePos, cel_LiteralPos, drawX, drawY, pictureX, clipRect);
 	cel_headerPos += 42;
 }
 #endif
 
 extern void unpackCelData(byte *inBuffer, byte *celBitmap, byte clearColor, int pixelCount, int rlePos, int literalPos, ViewType viewType, uint16 width, bool isMacSci11ViewData);
 
-void GfxPicture::drawCelData(byte *inbuffer, int size, int headerPos, int rlePos, int literalPos, int16 drawX, int16 drawY, int16 pictureX) {
+void GfxPicture::drawCelData(byte *inbuffer, int size, int headerPos, int rlePos, int literalPos, int16 drawX, int16 drawY, int16 pictureX, const Common::Rect *clipRect) {
 	byte *celBitmap = NULL;
 	byte *ptr = NULL;
 	byte *headerPtr = inbuffer + headerPos;
@@ -334,12 +348,26 @@ void GfxPicture::drawCelData(byte *inbuffer, int size, int headerPos, int rlePos
 
 		ptr = celBitmap;
 		ptr += skipCelBitmapPixels;
+
+		// Every row takes up width bytes of the bitmap, so rows above the clip
+		// rect can be skipped directly. Columns are checked per pixel.
+		int16 clipLeft = leftX, clipRight = rightX;
+		if (clipRect) {
+			if (y < clipRect->top) {
+				ptr += (clipRect->top - y) * width;
+				y = clipRect->top;
+			}
+			lastY = MIN<int16>(lastY, clipRect->bottom);
+			clipLeft = MAX<int16>(leftX, clipRect->left);
+			clipRight = MIN<int16>(rightX, clipRect->right);
+		}
+
 		if (!_mirroredFlag) {
 			// Draw bitmap to screen
 			x = leftX;
 			while (y < lastY) {
 				curByte = *ptr++;
-				if ((curByte != clearColor) && (priority >= _screen->getPriority(x, y)))
+				if ((curByte != clearColor) && (x >= clipLeft) && (x < clipRight) && (priority >= _screen->getPriority(x, y)))
 					_screen->putPixel(x, y, drawMask, curByte, priority, 0);
 
 				x++;
@@ -355,7 +383,7 @@ void GfxPicture::drawCelData(byte *inbuffer, int size, int headerPos, int rlePos
 			x = rightX - 1;
 			while (y < lastY) {
 				curByte = *ptr++;
-				if ((curByte != clearColor) && (priority >= _screen->getPriority(x, y)))
+				if ((curByte != clearColor) && (x >= clipLeft) && (x < clipRight) && (priority >= _screen->getPriority(x, y)))
 					_screen->putPixel(x, y, drawMask, curByte, priority, 0);
 			
 				if (x == leftX) {
@@ -33,6 +33,7 @@ namespace Sci {
 GfxView::GfxView(ResourceManager *resMan, GfxScreen *screen, GfxPalette *palette, GuiResourceId resourceId)
 	: _resMan(resMan), _screen(screen), _palette(palette), _resourceId(resourceId) {
 	assert(resourceId != -1);
+	_bitmapSize = 0;
 	_coordAdjuster = g_sci->_gfxCoordAdjuster;
 	initData(resourceId);
 }
@@ -575,6 +576,7 @@ const byte *GfxView::getBitmap(int16 loopNo, int16 celNo) {
 	int pixelCount = width * height;
 	_loop[loopNo].cel[celNo].rawBitmap = new byte[pixelCount];
 	byte *pBitmap = _loop[loopNo].cel[celNo].rawBitmap;
+	_bitmapSize += pixelCount;
 
 	// unpack the actual cel bitmap data
 	unpackCel(loopNo, celNo, pBitmap, pixelCount);
@@ -591,6 +593,56 @@ const byte *GfxView::getBitmap(int16 loopNo, int16 celNo) {
 	return _loop[loopNo].cel[celNo].rawBitmap;
 }
 
+uint32 GfxView::releaseBitmaps(Common::Array<byte *> &bitmaps) {
+	bitmaps.clear();
+
+	// EGA cels get undithered against the current picture when they are
+	// unpacked, so they can't be reused later on
+	if (_resMan->getViewType() == kViewEga || !_bitmapSize)
+		return 0;
+
+	for (uint16 loopNo = 0; loopNo < _loopCount; loopNo++) {
+		for (uint16 celNo = 0; celNo < _loop[loopNo].celCount; celNo++) {
+			bitmaps.push_back(_loop[loopNo].cel[celNo].rawBitmap);
+			_loop[loopNo].cel[celNo].rawBitmap = 0;
+		}
+	}
+
+	uint32 size = _bitmapSize;
+	_bitmapSize = 0;
+	return size;
+}
+
+void GfxView::adoptBitmaps(Common::Array<byte *> &bitmaps) {
+	uint celCount = 0;
+	for (uint16 loopNo = 0; loopNo < _loopCount; loopNo++)
+		celCount += _loop[loopNo].celCount;
+
+	if (bitmaps.size() != celCount) {
+		// Doesn't belong to this view, e.g. because the resource got patched
+		for (uint i = 0; i < bitmaps.size(); i++)
+			delete[] bitmaps[i];
+		bitmaps.clear();
+		return;
+	}
+
+	uint i = 0;
+	for (uint16 loopNo = 0; loopNo < _loopCount; loopNo++) {
+		for (uint16 celNo = 0; celNo < _loop[loopNo].celCount; celNo++, i++) {
+			CelInfo &cel = _loop[loopNo].cel[celNo];
+			if (!bitmaps[i])
+				continue;
+			if (cel.rawBitmap) {
+				delete[] bitmaps[i];
+				continue;
+			}
+			cel.rawBitmap = bitmaps[i];
+			_bitmapSize += cel.width * cel.height;
+		}
+	}
+	bitmaps.clear();
+}
+
 /**
  * Called after unpacking an EGA cel, this will try to undither (parts) of the
  * cel if the dithering in here matches dithering used by the current picture.
@@ -23,6 +23,8 @@
 #ifndef SCI_GRAPHICS_VIEW_H
 #define SCI_GRAPHICS_VIEW_H
 
+#include "common/array.h"
+
 namespace Sci {
 
 enum Sci32ViewNativeResolution {
@@ -82,6 +84,23 @@ public:
 	bool isScaleable();
 	bool isSci2Hires();
 
+	/** Returns the memory used by the view resource and all decoded cel bitmaps */
+	uint32 getMemorySize() const { return _resourceSize + _bitmapSize; }
+
+	/**
+	 * Hands the decoded cel bitmaps over to the caller, so that they can be
+	 * reused by a later instance of the same view.
+	 * @param bitmaps	receives the bitmaps of all cels, in loop order
+	 * @return the amount of bytes handed over
+	 */
+	uint32 releaseBitmaps(Common::Array<byte *> &bitmaps);
+
+	/**
+	 * Takes over cel bitmaps which were handed out by releaseBitmaps() of
+	 * another instance of the same view.
+	 */
+	void adoptBitmaps(Common::Array<byte *> &bitmaps);
+
 	void adjustToUpscaledCoordinates(int16 &y, int16 &x);
 	void adjustBackUpscaledCoordinates(int16 &y, int16 &x);
 
@@ -99,6 +118,7 @@ private:
 	Resource *_resource;
 	byte *_resourceData;
 	int _resourceSize;
+	uint32 _bitmapSize;	///< Memory used by the decoded cel bitmaps
 
 	uint16 _loopCount;
 	LoopInfo *_loop;
@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/memstream.h"
 #include "common/textconsole.h"
 
 #include "sci/resource.h"
@@ -190,11 +191,14 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : _resMan(resMan), _i
 	_source = NULL;
 	_header = NULL;
 	_headerSize = 0;
+	_packedData = NULL;
+	_packedSize = 0;
 }
 
 Resource::~Resource() {
 	delete[] data;
 	delete[] _header;
+	delete[] _packedData;
 	if (_source && _source->getSourceType() == kSourcePatch)
 		delete _source;
 }
@@ -563,11 +567,21 @@ Common::SeekableReadStream *ResourceSource::getVolumeFile(ResourceManager *resMa
 }
 
 void ResourceSource::loadResource(ResourceManager *resMan, Resource *res) {
-	Common::SeekableReadStream *fileStream = getVolumeFile(resMan, res);
-	if (!fileStream)
-		return;
+	Common::SeekableReadStream *fileStream;
+	const bool fromMemory = res->_packedData != NULL;
+
+	if (fromMemory) {
+		// The compressed data is still in memory, no need to access the volume
+		fileStream = new Common::MemoryReadStream(res->_packedData, res->_packedSize);
+		resMan->_typeStats[res->getType()].packedHits++;
+		resMan->touchPackedData(res);
+	} else {
+		fileStream = getVolumeFile(resMan, res);
+		if (!fileStream)
+			return;
 
-	fileStream->seek(res->_fileOffset, SEEK_SET);
+		fileStream->seek(res->_fileOffset, SEEK_SET);
+	}
 
 	int error = res->decompress(resMan->getVolVersion(), fileStream);
 	if (error) {
@@ -577,7 +591,7 @@ void ResourceSource::loadResource(ResourceManager *resMan, Resource *res) {
 		res->unalloc();
 	}
 
-	if (_resourceFile)
+	if (fromMemory || _resourceFile)
 		delete fileStream;
 }
 
@@ -891,6 +905,12 @@ void ResourceManager::init(bool initFromFallbackDetector) {
 	_memoryLocked = 0;
 	_memoryLRU = 0;
 	_LRU.clear();
+	_memoryPacked = 0;
+	_maxMemoryPacked = 0;
+	_packedLRU.clear();
+	memset(_memoryLRUByType, 0, sizeof(_memoryLRUByType));
+	resetStats();
+	setMaxMemory(DEFAULT_MAX_MEMORY);
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 
@@ -942,6 +962,9 @@ void ResourceManager::init(bool initFromFallbackDetector) {
 
 	debugC(1, kDebugLevelResMan, "resMan: Detected %s", getSciVersionDesc(getSciVersion()));
 
+	if (getSciVersion() >= SCI_VERSION_2)
+		setMaxMemory(DEFAULT_MAX_MEMORY_SCI32);
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -995,6 +1018,7 @@ void ResourceManager::removeFromLRU(Resource *res) {
 	}
 	_LRU.remove(res);
 	_memoryLRU -= res->size;
+	_memoryLRUByType[res->getType()] -= res->size;
 	res->_status = kResStatusAllocated;
 }
 
@@ -1005,6 +1029,7 @@ void ResourceManager::addToLRU(Resource *res) {
 	}
 	_LRU.push_front(res);
 	_memoryLRU += res->size;
+	_memoryLRUByType[res->getType()] += res->size;
 #if SCI_VERBOSE_RESMAN
 	debug("Adding %s.%03d (%d bytes) to lru control: %d bytes total",
 	      getResourceTypeName(res->type), res->number, res->size,
@@ -1031,17 +1056,107 @@ void ResourceManager::printLRU() {
 }
 
 void ResourceManager::freeOldResources() {
-	while (MAX_MEMORY < _memoryLRU) {
+	// Enforce the quotas of the single resource types first, freeing the
+	// least recently used resources of the affected types
+	for (int type = 0; type < kResourceTypeInvalid; type++) {
+		if (!_typeQuota[type] || _memoryLRUByType[type] <= _typeQuota[type])
+			continue;
+
+		Common::List<Resource *>::iterator it = _LRU.reverse_begin();
+		while (_typeQuota[type] < _memoryLRUByType[type]) {
+			assert(it != _LRU.end());
+			Resource *goner = *it;
+			--it;
+
+			if (goner->getType() != type)
+				continue;
+
+			removeFromLRU(goner);
+			goner->unalloc();
+			_typeStats[type].evictions++;
+		}
+	}
+
+	while (_maxMemoryLRU < _memoryLRU) {
 		assert(!_LRU.empty());
 		Resource *goner = *_LRU.reverse_begin();
 		removeFromLRU(goner);
 		goner->unalloc();
+		_typeStats[goner->getType()].evictions++;
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s.%03d (%d bytes)", getResourceTypeName(goner->type), goner->number, goner->size);
 #endif
 	}
 }
 
+void ResourceManager::setMaxMemory(int maxMemory) {
+	assert(maxMemory > 0);
+	_maxMemoryLRU = maxMemory;
+
+	// Speech is rarely played more than once, so don't let it push
+	// everything else out of memory
+	memset(_typeQuota, 0, sizeof(_typeQuota));
+	_typeQuota[kResourceTypeAudio] = maxMemory / 4;
+	_typeQuota[kResourceTypeAudio36] = maxMemory / 4;
+
+	freeOldResources();
+}
+
+void ResourceManager::setTypeQuota(ResourceType type, int quota) {
+	assert(type < kResourceTypeInvalid && quota >= 0);
+	_typeQuota[type] = quota;
+	freeOldResources();
+}
+
+void ResourceManager::setMaxPackedMemory(int maxMemory) {
+	assert(maxMemory >= 0);
+	_maxMemoryPacked = maxMemory;
+
+	while (_maxMemoryPacked < _memoryPacked)
+		freePackedData(*_packedLRU.reverse_begin());
+}
+
+void ResourceManager::addPackedData(Resource *res, byte *data, uint32 size) {
+	assert(!res->_packedData);
+
+	if ((int)size > _maxMemoryPacked) {
+		delete[] data;
+		return;
+	}
+
+	while (_maxMemoryPacked - _memoryPacked < (int)size)
+		freePackedData(*_packedLRU.reverse_begin());
+
+	res->_packedData = data;
+	res->_packedSize = size;
+	_packedLRU.push_front(res);
+	_memoryPacked += size;
+}
+
+void ResourceManager::touchPackedData(Resource *res) {
+	if (*_packedLRU.begin() == res)
+		return;
+
+	_packedLRU.remove(res);
+	_packedLRU.push_front(res);
+}
+
+void ResourceManager::freePackedData(Resource *res) {
+	if (!res->_packedData)
+		return;
+
+	_packedLRU.remove(res);
+	_memoryPacked -= res->_packedSize;
+	delete[] res->_packedData;
+	res->_packedData = NULL;
+	res->_packedSize = 0;
+}
+
+void ResourceManager::resetStats() {
+	memset(_typeStats, 0, sizeof(_typeStats));
+	memset(_compressionStats, 0, sizeof(_compressionStats));
+}
+
 Common::List<ResourceId> *ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> *resources = new Common::List<ResourceId>;
 
@@ -1061,10 +1176,14 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_status == kResStatusNoMalloc) {
+		_typeStats[retval->getType()].misses++;
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
-		removeFromLRU(retval);
+	} else {
+		_typeStats[retval->getType()].hits++;
+		if (retval->_status == kResStatusEnqueued)
+			removeFromLRU(retval);
+	}
 	// Unless an error occurred, the resource is now either
 	// locked or allocated, but never queued or freed.
 
@@ -1851,6 +1970,9 @@ Resource *ResourceManager::updateResource(ResourceId resId, ResourceSource *src,
 		_resMap.setVal(resId, res);
 	}
 
+	// Any compressed data in memory belongs to the previous source
+	freePackedData(res);
+
 	res->_status = kResStatusNoMalloc;
 	res->_source = src;
 	res->_headerSize = 0;
@@ -1961,12 +2083,33 @@ int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file
 	int errorNum;
 	uint32 szPacked = 0;
 	ResourceCompression compression = kCompUnknown;
+	const int32 entryStart = file->pos();
 
 	// fill resource info
 	errorNum = readResourceInfo(volVersion, file, szPacked, compression);
 	if (errorNum)
 		return errorNum;
 
+	// Keep the whole compressed volume entry in memory, so that the resource
+	// can be decompressed again later on without accessing the volume file
+	Common::MemoryReadStream *packedStream = NULL;
+	if (compression != kCompNone && !_packedData && _resMan->_maxMemoryPacked > 0) {
+		const uint32 entrySize = file->pos() - entryStart + szPacked;
+		if (entrySize <= (uint32)_resMan->_maxMemoryPacked) {
+			byte *entry = new byte[entrySize];
+			file->seek(entryStart, SEEK_SET);
+			if (file->read(entry, entrySize) != entrySize) {
+				delete[] entry;
+				return SCI_ERROR_IO_ERROR;
+			}
+
+			packedStream = new Common::MemoryReadStream(entry, entrySize);
+			packedStream->seek(entrySize - szPacked, SEEK_SET);
+			file = packedStream;
+			_resMan->addPackedData(this, entry, entrySize);
+		}
+	}
+
 	// getting a decompressor
 	Decompressor *dec = NULL;
 	switch (compression) {
@@ -2001,7 +2144,13 @@ int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file
 	if (errorNum)
 		unalloc();
 
+	ResourceManager::CompressionStats &stats = _resMan->_compressionStats[compression];
+	stats.resources++;
+	stats.packedBytes += szPacked;
+	stats.unpackedBytes += size;
+
 	delete dec;
+	delete packedStream;
 	return errorNum;
 }
 
@@ -242,6 +242,8 @@ protected:
 	uint16 _lockers; /**< Number of places where this resource was locked */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
+	byte *_packedData; /**< Compressed volume entry kept in memory, or NULL */
+	uint32 _packedSize;
 
 	bool loadPatch(Common::SeekableReadStream *file);
 	bool loadFromPatchFile();
@@ -269,8 +271,28 @@ class ResourceManager {
 #ifdef ENABLE_SCI32
 	friend class ChunkResourceSource;
 #endif
+	friend class Resource;
 
 public:
+	/** Cache statistics of a resource type */
+	struct TypeStats {
+		uint32 hits;		///< Resource was still in memory
+		uint32 misses;		///< Resource had to be loaded
+		uint32 packedHits;	///< Resource was decompressed from the compressed cache
+		uint32 evictions;	///< Resource was freed to stay within the memory limits
+	};
+
+	/** Statistics of a compression method */
+	struct CompressionStats {
+		uint32 resources;		///< Number of resources decompressed
+		uint32 packedBytes;		///< Amount of compressed bytes read
+		uint32 unpackedBytes;	///< Amount of decompressed bytes produced
+	};
+
+	enum {
+		kCompressionMethods = kCompDCL + 1
+	};
+
 	/**
 	 * Creates a new SCI resource manager.
 	 */
@@ -378,20 +400,66 @@ public:
 	 */
 	ResourceType convertResType(byte type);
 
+	/**
+	 * Sets the maximum amount of memory for resources which are not locked.
+	 * Locked resources do not count towards this limit. This also resets
+	 * the per-type quotas to their defaults.
+	 * @param maxMemory	The limit in bytes
+	 */
+	void setMaxMemory(int maxMemory);
+	int getMaxMemory() const { return _maxMemoryLRU; }
+
+	/**
+	 * Limits the amount of memory which unlocked resources of a single type
+	 * may use, so that e.g. speech can not push all views out of memory.
+	 * @param type		The resource type
+	 * @param quota		The limit in bytes, 0 for none besides the global one
+	 */
+	void setTypeQuota(ResourceType type, int quota);
+	int getTypeQuota(ResourceType type) const { return _typeQuota[type]; }
+
+	/**
+	 * Sets the amount of memory used to keep the compressed data of
+	 * resources which were read from volume files, so that they can be
+	 * decompressed again without accessing the volume file.
+	 * @param maxMemory	The limit in bytes, 0 disables the compressed cache
+	 */
+	void setMaxPackedMemory(int maxMemory);
+	int getMaxPackedMemory() const { return _maxMemoryPacked; }
+
+	int getLockedMemory() const { return _memoryLocked; }
+	int getLRUMemory() const { return _memoryLRU; }
+	int getLRUMemory(ResourceType type) const { return _memoryLRUByType[type]; }
+	int getPackedMemory() const { return _memoryPacked; }
+	uint getPackedCount() const { return _packedLRU.size(); }
+
+	const TypeStats &getTypeStats(ResourceType type) const { return _typeStats[type]; }
+	const CompressionStats &getCompressionStats(ResourceCompression compression) const { return _compressionStats[compression]; }
+	void resetStats();
+
 protected:
-	// Maximum number of bytes to allow being allocated for resources
+	// Default maximum number of bytes to allow being allocated for resources
 	// Note: maxMemory will not be interpreted as a hard limit, only as a restriction
 	// for resources which are not explicitly locked. However, a warning will be
 	// issued whenever this limit is exceeded.
 	enum {
-		MAX_MEMORY = 256 * 1024	// 256KB
+		DEFAULT_MAX_MEMORY = 4 * 1024 * 1024,		// 4MB
+		DEFAULT_MAX_MEMORY_SCI32 = 16 * 1024 * 1024	// 16MB
 	};
 
 	ViewType _viewType; // Used to determine if the game has EGA or VGA graphics
 	Common::List<ResourceSource *> _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
+	int _maxMemoryLRU;	///< Maximum amount of resource bytes under LRU control
+	int _memoryLRUByType[kResourceTypeInvalid];	///< Resource bytes under LRU control, per type
+	int _typeQuota[kResourceTypeInvalid];	///< Maximum resource bytes under LRU control, per type
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	int _memoryPacked;		///< Amount of compressed bytes kept in memory
+	int _maxMemoryPacked;	///< Maximum amount of compressed bytes kept in memory
+	Common::List<Resource *> _packedLRU; ///< Resources with compressed data, most recently used first
+	TypeStats _typeStats[kResourceTypeInvalid];
+	CompressionStats _compressionStats[kCompressionMethods];
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -512,6 +580,11 @@ protected:
 	void addToLRU(Resource *res);
 	void removeFromLRU(Resource *res);
 
+	/** Takes ownership of the compressed volume entry of a resource */
+	void addPackedData(Resource *res, byte *data, uint32 size);
+	void touchPackedData(Resource *res);
+	void freePackedData(Resource *res);
+
 	ResourceCompression getViewCompression();
 	ViewType detectViewType();
 	bool hasSci0Voc999();
@@ -214,6 +214,7 @@ void ResourceManager::removeAudioResource(ResourceId resId) {
 				if (res->_status == kResStatusEnqueued)
 					removeFromLRU(res);
 
+				freePackedData(res);
 				_resMap.erase(resId);
 				delete res;
 			}
@@ -185,12 +185,21 @@ Common::Error SciEngine::run() {
 	ConfMan.registerDefault("sci_originalsaveload", "false");
 	ConfMan.registerDefault("native_fb01", "false");
 	ConfMan.registerDefault("windows_cursors", "false");	// Windows cursors for KQ6 Windows
+	ConfMan.registerDefault("resource_budget", 0);
+	ConfMan.registerDefault("sci_compressed_cache", "true");
+	ConfMan.registerDefault("sci_incremental_gc", "false");
 
 	_resMan = new ResourceManager();
 	assert(_resMan);
 	_resMan->addAppropriateSources();
 	_resMan->init();
 
+	// The resource budget is given in KB, 0 keeps the default of the game
+	if (ConfMan.getInt("resource_budget") > 0)
+		_resMan->setMaxMemory(ConfMan.getInt("resource_budget") * 1024);
+	if (ConfMan.getBool("sci_compressed_cache"))
+		_resMan->setMaxPackedMemory(_resMan->getMaxMemory() / 2);
+
 	// TODO: Add error handling. Check return values of addAppropriateSources
 	// and init. We first have to *add* sensible return values, though ;).
 /*
@@ -223,6 +232,8 @@ Common::Error SciEngine::run() {
 		_vocabulary = new Vocabulary(_resMan, false);
 	_audio = new AudioPlayer(_resMan);
 	_gamestate = new EngineState(segMan);
+	if (ConfMan.getBool("sci_incremental_gc"))
+		_gamestate->scriptGCSlice = GC_SLICE;
 	_eventMan = new EventManager(_resMan->detectFontExtended());
 
 	// Create debugger console. It requires GFX and _gamestate to be initialized
@@ -37,6 +37,8 @@
 
 namespace Scumm {
 
+extern const char *nameOfResType(ResType type);
+
 void debugC(int channel, const char *s, ...) {
 	char buf[STRINGBUFLEN];
 	va_list va;
@@ -79,6 +81,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	DCmd_Register("scr",       WRAP_METHOD(ScummDebugger, Cmd_Script));
 	DCmd_Register("scripts",   WRAP_METHOD(ScummDebugger, Cmd_PrintScript));
 	DCmd_Register("importres", WRAP_METHOD(ScummDebugger, Cmd_ImportRes));
+	DCmd_Register("resources", WRAP_METHOD(ScummDebugger, Cmd_Resources));
 
 	if (_vm->_game.id == GID_LOOM)
 		DCmd_Register("drafts",  WRAP_METHOD(ScummDebugger, Cmd_PrintDraft));
@@ -311,6 +314,48 @@ bool ScummDebugger::Cmd_ImportRes(int argc, const char** argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_Resources(int argc, const char **argv) {
+	ResourceManager *res = _vm->_res;
+
+	if (argc > 1 && !strcmp(argv[1], "reset")) {
+		memset(&res->_cacheStats, 0, sizeof(res->_cacheStats));
+		DebugPrintf("Resource statistics reset\n");
+		return true;
+	}
+
+	DebugPrintf("+--------------+------+----------+------+----------+\n");
+	DebugPrintf("|type          |loaded|     size |locked|     size |\n");
+	DebugPrintf("+--------------+------+----------+------+----------+\n");
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		uint32 loadedNum = 0, loadedSize = 0, lockedNum = 0, lockedSize = 0;
+
+		for (ResId idx = 0; idx < res->_types[type].size(); idx++) {
+			if (!res->isResourceLoaded(type, idx))
+				continue;
+			loadedNum++;
+			loadedSize += res->_types[type][idx]._size;
+			if (res->isLocked(type, idx)) {
+				lockedNum++;
+				lockedSize += res->_types[type][idx]._size;
+			}
+		}
+
+		if (loadedNum)
+			DebugPrintf("|%-14s|%6d|%10d|%6d|%10d|\n", nameOfResType(type), loadedNum, loadedSize, lockedNum, lockedSize);
+	}
+	DebugPrintf("+--------------+------+----------+------+----------+\n");
+
+	const ResourceManager::CacheStats &stats = res->_cacheStats;
+	const uint32 accesses = stats.hits + stats.misses;
+	DebugPrintf("Allocated %d of %d bytes\n", res->getAllocatedSize(), res->getMemoryBudget());
+	DebugPrintf("Hits: %d, misses: %d (%d%% hits)\n", stats.hits, stats.misses,
+	            accesses ? (int)((double)stats.hits * 100 / accesses) : 0);
+	DebugPrintf("Evictions: %d, %d bytes\n", stats.evictions, stats.evictedSize);
+	DebugPrintf("Use 'resources reset' to reset the statistics\n");
+
+	return true;
+}
+
 bool ScummDebugger::Cmd_PrintScript(int argc, const char **argv) {
 	int i;
 	ScriptSlot *ss = _vm->vm.slot;
@@ -43,9 +43,7 @@
 namespace Scumm {
 
 enum {
-	RF_LOCK = 0x80,
-	RF_USAGE = 0x7F,
-	RF_USAGE_MAX = RF_USAGE,
+	RF_USAGE_MAX = 0x7F,
 
 	RS_MODIFIED = 0x10
 };
@@ -539,9 +537,16 @@ void ResourceManager::allocResTypeData(ResType type, uint32 tag, int num, ResTyp
 
 	// If there was data in there, let's clear it out completely. This is important
 	// in case we are restarting the game.
+	for (ResId idx = 0; idx < _types[type].size(); idx++)
+		nukeResource(type, idx);
 	_types[type].clear();
 	_types[type].resize(num);
 
+	for (ResId idx = 0; idx < (ResId)num; idx++) {
+		_types[type][idx]._type = type;
+		_types[type][idx]._idx = idx;
+	}
+
 /*
 	TODO: Use multiple Resource subclasses, one for each res mode; then,
 	given them serializability.
@@ -735,8 +740,13 @@ byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
 		return NULL;
 
 	// If the resource is missing, but loadable from the game data files, try to do so.
-	if (!_res->_types[type][idx]._address && _res->_types[type]._mode != kDynamicResTypeMode) {
-		ensureResourceLoaded(type, idx);
+	if (_res->_types[type]._mode != kDynamicResTypeMode) {
+		if (_res->_types[type][idx]._address) {
+			_res->_cacheStats.hits++;
+		} else {
+			_res->_cacheStats.misses++;
+			ensureResourceLoaded(type, idx);
+		}
 	}
 
 	ptr = (byte *)_res->_types[type][idx]._address;
@@ -776,28 +786,69 @@ void ResourceManager::increaseExpireCounter() {
 }
 
 void ResourceManager::increaseResourceCounters() {
-	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-		ResId idx = _types[type].size();
-		while (idx-- > 0) {
-			byte counter = _types[type][idx].getResourceCounter();
-			if (counter && counter < RF_USAGE_MAX) {
-				setResourceCounter(type, idx, counter + 1);
-			}
-		}
-	}
+	_usageGeneration++;
 }
 
 void ResourceManager::setResourceCounter(ResType type, ResId idx, byte counter) {
-	_types[type][idx].setResourceCounter(counter);
+	Resource &res = _types[type][idx];
+
+	if (counter == 0)
+		res._lastUsed = 0;
+	else if (counter >= RF_USAGE_MAX)
+		res._lastUsed = 1;
+	else
+		res._lastUsed = _usageGeneration - (counter - 1);
+
+	if (res._address && _types[type]._mode != kDynamicResTypeMode) {
+		unlinkLRU(res);
+		if (counter != 0)
+			linkLRU(res);
+	}
+}
+
+byte ResourceManager::getResourceCounter(ResType type, ResId idx) const {
+	return getResourceCounter(_types[type][idx]);
 }
 
-void ResourceManager::Resource::setResourceCounter(byte counter) {
-	_flags &= RF_LOCK;	// Clear lower 7 bits, preserve the lock bit.
-	_flags |= counter;	// Update the usage counter
+byte ResourceManager::getResourceCounter(const Resource &res) const {
+	if (!res._lastUsed)
+		return 0;
+	return MIN<uint32>(_usageGeneration - res._lastUsed + 1, RF_USAGE_MAX);
+}
+
+void ResourceManager::linkLRU(Resource &res) {
+	// Find the last resource with a higher or equal counter. Most of the
+	// time the resource was just used, so it becomes the tail.
+	Resource *prev = _lruTail;
+	while (prev && prev->_lastUsed > res._lastUsed)
+		prev = prev->_lruPrev;
+
+	res._lruPrev = prev;
+	res._lruNext = prev ? prev->_lruNext : _lruHead;
+	if (res._lruPrev)
+		res._lruPrev->_lruNext = &res;
+	else
+		_lruHead = &res;
+	if (res._lruNext)
+		res._lruNext->_lruPrev = &res;
+	else
+		_lruTail = &res;
 }
 
-byte ResourceManager::Resource::getResourceCounter() const {
-	return _flags & RF_USAGE;
+void ResourceManager::unlinkLRU(Resource &res) {
+	if (!res._lruPrev && _lruHead != &res)
+		return;
+
+	if (res._lruPrev)
+		res._lruPrev->_lruNext = res._lruNext;
+	else
+		_lruHead = res._lruNext;
+	if (res._lruNext)
+		res._lruNext->_lruPrev = res._lruPrev;
+	else
+		_lruTail = res._lruPrev;
+
+	res._lruPrev = res._lruNext = 0;
 }
 
 /* 2 bytes safety area to make "precaching" of bytes in the gdi drawer easier */
@@ -838,7 +889,11 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 ResourceManager::Resource::Resource() {
 	_address = 0;
 	_size = 0;
-	_flags = 0;
+	_locked = false;
+	_lastUsed = 0;
+	_lruPrev = _lruNext = 0;
+	_type = rtInvalid;
+	_idx = 0;
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
@@ -853,7 +908,8 @@ void ResourceManager::Resource::nuke() {
 	delete _address;
 	_address = 0;
 	_size = 0;
-	_flags = 0;
+	_locked = false;
+	_lastUsed = 0;
 	_status &= ~RS_MODIFIED;
 }
 
@@ -866,21 +922,27 @@ ResourceManager::ResTypeData::~ResTypeData() {
 }
 
 ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
 	_allocatedSize = 0;
-	_maxHeapThreshold = 0;
-	_minHeapThreshold = 0;
+	_memoryBudget = 0;
+	_expireTarget = 0;
 	_expireCounter = 0;
+	// Start high enough that a _lastUsed value of 1 always means the
+	// maximal counter
+	_usageGeneration = RF_USAGE_MAX;
+	_lruHead = _lruTail = 0;
 }
 
 ResourceManager::~ResourceManager() {
 	freeResources();
 }
 
-void ResourceManager::setHeapThreshold(int min, int max) {
-	assert(0 < max);
-	assert(min <= max);
-	_maxHeapThreshold = max;
-	_minHeapThreshold = min;
+void ResourceManager::setMemoryBudget(uint32 budget) {
+	assert(0 < budget);
+	_memoryBudget = budget;
+	// Expire a quarter of the budget at once, so that this does not happen
+	// again on the next resource load
+	_expireTarget = budget - budget / 4;
 }
 
 bool ResourceManager::validateResource(const char *str, ResType type, ResId idx) const {
@@ -896,6 +958,7 @@ void ResourceManager::nukeResource(ResType type, ResId idx) {
 	if (ptr != NULL) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
 		_allocatedSize -= _types[type][idx]._size;
+		unlinkLRU(_types[type][idx]);
 		_types[type][idx].nuke();
 	}
 }
@@ -944,15 +1007,15 @@ bool ResourceManager::isLocked(ResType type, ResId idx) const {
 }
 
 void ResourceManager::Resource::lock() {
-	_flags |= RF_LOCK;
+	_locked = true;
 }
 
 void ResourceManager::Resource::unlock() {
-	_flags &= ~RF_LOCK;
+	_locked = false;
 }
 
 bool ResourceManager::Resource::isLocked() const {
-	return (_flags & RF_LOCK) != 0;
+	return _locked;
 }
 
 bool ScummEngine::isResourceInUse(ResType type, ResId idx) const {
@@ -1007,9 +1070,6 @@ bool ResourceManager::Resource::isModified() const {
 }
 
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
 	uint32 oldAllocatedSize;
 
 	if (_expireCounter != 0xFF) {
@@ -1017,36 +1077,26 @@ void ResourceManager::expireResources(uint32 size) {
 		increaseResourceCounters();
 	}
 
-	if (size + _allocatedSize < _maxHeapThreshold)
+	if (size + _allocatedSize < _memoryBudget)
 		return;
 
 	oldAllocatedSize = _allocatedSize;
 
-	do {
-		best_type = rtInvalid;
-		best_counter = 2;
-
-		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx)) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
-				}
-			}
+	// Walk the LRU list from the resource with the highest counter on.
+	// Resources with a counter below 2 are never expired, and neither are
+	// all resources following them.
+	Resource *res = _lruHead;
+	while (res && size + _allocatedSize > _expireTarget && getResourceCounter(*res) >= 2) {
+		Resource *next = res->_lruNext;
+
+		if (!res->isLocked() && !_vm->isResourceInUse(res->_type, res->_idx)) {
+			_cacheStats.evictions++;
+			_cacheStats.evictedSize += res->_size;
+			nukeResource(res->_type, res->_idx);
 		}
 
-		if (!best_type)
-			break;
-		nukeResource(best_type, best_res);
-	} while (size + _allocatedSize > _minHeapThreshold);
+		res = next;
+	}
 
 	increaseResourceCounters();
 
@@ -1108,6 +1158,8 @@ void ResourceManager::resourceStats() {
 	}
 
 	debug(1, "Total allocated size=%d, locked=%d(%d)", _allocatedSize, lockedSize, lockedNum);
+	debug(1, "Memory budget=%d, hits=%d, misses=%d, evictions=%d(%d)", _memoryBudget,
+	      _cacheStats.hits, _cacheStats.misses, _cacheStats.evictions, _cacheStats.evictedSize);
 }
 
 void ScummEngine_v5::readMAXS(int blockSize) {
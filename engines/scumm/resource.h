@@ -80,6 +80,7 @@ protected:
 
 public:
 	class Resource {
+	friend class ResourceManager;
 	public:
 		/**
 		 * Pointer to the data contained in this resource
@@ -93,15 +94,36 @@ public:
 
 	protected:
 		/**
-		 * The uppermost bit indicates whether the resources is locked.
-		 * The lower 7 bits contain a counter. This counter measures roughly
-		 * how old the resource is; it starts out with a count of 1 and can go
-		 * as high as 127. When memory falls low resp. when the engine decides
-		 * that it should throw out some unused stuff, then it begins by
-		 * removing the resources with the highest counter (excluding locked
-		 * resources and resources that are known to be in use).
+		 * Whether the resource is locked. Locked resources are never expired.
+		 */
+		bool _locked;
+
+		/**
+		 * Determines the counter of the resource, see getResourceCounter().
+		 * This counter measures roughly how old the resource is; it starts
+		 * out with a count of 1 and can go as high as 127. When memory falls
+		 * low resp. when the engine decides that it should throw out some
+		 * unused stuff, then it begins by removing the resources with the
+		 * highest counter (excluding locked resources and resources that are
+		 * known to be in use).
+		 *
+		 * Instead of the counter itself, the value of _usageGeneration at the
+		 * time the counter was 1 is stored, so that the counters of all
+		 * resources can be increased at once. A value of 0 means a counter
+		 * of 0.
+		 */
+		uint32 _lastUsed;
+
+		/**
+		 * Neighbours in the LRU list of the resource manager.
 		 */
-		byte _flags;
+		Resource *_lruPrev, *_lruNext;
+
+		/**
+		 * Type and index of the resource, set by allocResTypeData().
+		 */
+		ResType _type;
+		ResId _idx;
 
 		/**
 		 * The status of the resource. Currently only one bit is used, which
@@ -131,9 +153,6 @@ public:
 
 		void nuke();
 
-		inline void setResourceCounter(byte counter);
-		inline byte getResourceCounter() const;
-
 		void lock();
 		void unlock();
 		bool isLocked() const;
@@ -166,16 +185,51 @@ public:
 	};
 	ResTypeData _types[rtLast + 1];
 
+	/**
+	 * Statistics about the resource cache, shown by the debugger.
+	 */
+	struct CacheStats {
+		uint32 hits;			///!< Resources found in memory by getResourceAddress()
+		uint32 misses;			///!< Resources loaded by getResourceAddress()
+		uint32 evictions;		///!< Resources expired to stay within the memory budget
+		uint32 evictedSize;		///!< Total size of the expired resources
+	};
+	CacheStats _cacheStats;
+
 protected:
 	uint32 _allocatedSize;
-	uint32 _maxHeapThreshold, _minHeapThreshold;
+
+	/**
+	 * When a new resource would make the total size of all resources exceed
+	 * the memory budget, unused resources are expired until the total size
+	 * is below the expire target.
+	 */
+	uint32 _memoryBudget, _expireTarget;
 	byte _expireCounter;
 
+	/**
+	 * Incremented by increaseResourceCounters(), which increases the
+	 * counters of all resources at once this way.
+	 */
+	uint32 _usageGeneration;
+
+	/**
+	 * All loaded resources which can be reloaded from the game data files,
+	 * i.e. which may be expired, ordered by their counter. The head has the
+	 * highest counter.
+	 */
+	Resource *_lruHead, *_lruTail;
+
 public:
 	ResourceManager(ScummEngine *vm);
 	~ResourceManager();
 
-	void setHeapThreshold(int min, int max);
+	/**
+	 * Set the memory budget for all resources, in bytes.
+	 */
+	void setMemoryBudget(uint32 budget);
+	uint32 getMemoryBudget() const { return _memoryBudget; }
+	uint32 getAllocatedSize() const { return _allocatedSize; }
 
 	void allocResTypeData(ResType type, uint32 tag, int num, ResTypeMode mode);
 	void freeResources();
@@ -208,8 +262,13 @@ public:
 	void setResourceCounter(ResType type, ResId idx, byte counter);
 
 	/**
-	 * Increment the counter of all unlocked loaded resources.
-	 * The maximal count is 255.
+	 * Get the specified resource's counter.
+	 */
+	byte getResourceCounter(ResType type, ResId idx) const;
+
+	/**
+	 * Increment the counter of all resources with a non-zero counter.
+	 * The maximal count is 127.
 	 * This is called by increaseExpireCounter and expireResources,
 	 * but also by ScummEngine::startScene.
 	 */
@@ -221,6 +280,10 @@ public:
 	bool validateResource(const char *str, ResType type, ResId idx) const;
 protected:
 	void expireResources(uint32 size);
+
+	byte getResourceCounter(const Resource &res) const;
+	void linkLRU(Resource &res);
+	void unlinkLRU(Resource &res);
 };
 
 } // End of namespace Scumm
@@ -1264,20 +1264,23 @@ void ScummEngine::setupScumm() {
 		_bootParam = -1;
 	}
 
-	int maxHeapThreshold = -1;
+	uint32 memoryBudget;
 
-	if (_game.features & GF_16BIT_COLOR) {
+	if (ConfMan.getInt("resource_budget") > 0) {
+		// The user knows best (the budget is given in KB)
+		memoryBudget = ConfMan.getInt("resource_budget") * 1024;
+	} else if (_game.features & GF_16BIT_COLOR) {
 		// 16bit color games require double the memory, due to increased resource sizes.
-		maxHeapThreshold = 12 * 1024 * 1024;
+		memoryBudget = 12 * 1024 * 1024;
 	} else if (_game.features & GF_NEW_COSTUMES) {
 		// Since the new costumes are very big, we increase the heap limit, to avoid having
 		// to constantly reload stuff from the data files.
-		maxHeapThreshold = 6 * 1024 * 1024;
+		memoryBudget = 6 * 1024 * 1024;
 	} else {
-		maxHeapThreshold = 550000;
+		memoryBudget = 550000;
 	}
 
-	_res->setHeapThreshold(400000, maxHeapThreshold);
+	_res->setMemoryBudget(memoryBudget);
 
 	free(_compositeBuf);
 	_compositeBuf = (byte *)malloc(_screenWidth * _textSurfaceMultiplier * _screenHeight * _textSurfaceMultiplier * _bytesPerPixelOutput);
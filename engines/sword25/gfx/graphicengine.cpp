@@ -66,6 +66,7 @@ GraphicEngine::GraphicEngine(Kernel *pKernel) :
 	_width(0),
 	_height(0),
 	_bitDepth(0),
+	_clipping(false),
 	_lastTimeStamp((uint) -1), // max. BS_INT64 um beim ersten Aufruf von _UpdateLastFrameDuration() einen Reset zu erzwingen
 	_lastFrameDuration(0),
 	_timerActive(true),
@@ -107,6 +108,7 @@ bool GraphicEngine::init(int width, int height, int bitDepth, int backbufferCoun
 	_screenRect.top = 0;
 	_screenRect.right = _width;
 	_screenRect.bottom = _height;
+	_clipRect = _screenRect;
 
 	const Graphics::PixelFormat format = g_system->getScreenFormat();
 
@@ -135,13 +137,19 @@ bool GraphicEngine::startFrame(bool updateAll) {
 	// Den Layer-Manager auf den nchsten Frame vorbereiten
 	_renderObjectManagerPtr->startFrame();
 
+	if (updateAll)
+		_renderObjectManagerPtr->invalidateScreen();
+
 	return true;
 }
 
 bool GraphicEngine::endFrame() {
 #ifndef THEORA_INDIRECT_RENDERING
-	if (Kernel::getInstance()->getFMV()->isMovieLoaded())
+	if (Kernel::getInstance()->getFMV()->isMovieLoaded()) {
+		// The movie is drawn directly to the screen
+		_renderObjectManagerPtr->invalidateScreen();
 		return true;
+	}
 #endif
 
 	_renderObjectManagerPtr->render();
@@ -151,6 +159,13 @@ bool GraphicEngine::endFrame() {
 	return true;
 }
 
+void GraphicEngine::setClipRect(const Common::Rect *clipRectPtr) {
+	_clipRect = _screenRect;
+	_clipping = (clipRectPtr != 0);
+	if (_clipping)
+		_clipRect.clip(*clipRectPtr);
+}
+
 RenderObjectPtr<Panel> GraphicEngine::getMainPanel() {
 	return _mainPanelPtr;
 }
@@ -181,6 +196,9 @@ bool GraphicEngine::fill(const Common::Rect *fillRectPtr, uint color) {
 		rect = *fillRectPtr;
 	}
 
+	if (rect.isValidRect())
+		rect.clip(_clipRect);
+
 	if (rect.width() > 0 && rect.height() > 0) {
 		if (ca == 0xff) {
 			_backSurface.fillRect(rect, color);
@@ -216,7 +234,8 @@ bool GraphicEngine::fill(const Common::Rect *fillRectPtr, uint color) {
 			}
 		}
 
-		g_system->copyRectToScreen((byte *)_backSurface.getBasePtr(rect.left, rect.top), _backSurface.pitch, rect.left, rect.top, rect.width(), rect.height());
+		if (!_clipping)
+			g_system->copyRectToScreen((byte *)_backSurface.getBasePtr(rect.left, rect.top), _backSurface.pitch, rect.left, rect.top, rect.width(), rect.height());
 	}
 
 	return true;
@@ -229,6 +229,29 @@ public:
 	 */
 	bool fill(const Common::Rect *fillRectPtr = 0, uint color = BS_RGB(0, 0, 0));
 
+	/**
+	 * Restricts all drawing to the frame buffer to a rectangle.
+	 * While a clip rectangle is set, drawing operations don't copy their results to the screen,
+	 * that is left to the caller.
+	 * @param ClipRectPtr   Pointer to the clip rectangle. If a NULL value is passed, drawing
+	 * is possible on the whole frame buffer again.
+	 */
+	void setClipRect(const Common::Rect *clipRectPtr);
+
+	/**
+	 * Returns the rectangle drawing is restricted to. Without a clip rectangle, this is the display rectangle.
+	 */
+	const Common::Rect &getClipRect() const {
+		return _clipRect;
+	}
+
+	/**
+	 * Returns true if a clip rectangle is set.
+	 */
+	bool isClipping() const {
+		return _clipping;
+	}
+
 	Graphics::Surface _backSurface;
 	Graphics::Surface *getSurface() { return &_backSurface; }
 
@@ -291,6 +314,8 @@ protected:
 	int _height;
 	Common::Rect _screenRect;
 	int _bitDepth;
+	Common::Rect _clipRect;
+	bool _clipping;
 
 	/**
 	 * Calculates the time since the last frame beginning has passed.
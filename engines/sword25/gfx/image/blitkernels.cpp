@@ -0,0 +1,385 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "sword25/gfx/image/blitkernels.h"
+#include "common/cpudetect.h"
+#include "common/util.h"
+
+// The SIMD kernels work on the bytes of the pixels in memory, which are
+// stored as B, G, R, A on little endian systems only.
+#ifdef SCUMM_LITTLE_ENDIAN
+#ifdef SCUMMVM_SSE2
+#define BLIT_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef SCUMMVM_NEON
+#define BLIT_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace Sword25 {
+
+#pragma mark -
+#pragma mark --- Scalar kernels ---
+#pragma mark -
+
+static void blitRowScalar(byte *out, const byte *in, int inStep, int count, int ca, int cr, int cg, int cb) {
+	for (; count > 0; --count) {
+		uint32 pix = *(const uint32 *)in;
+		int b = (pix >> 0) & 0xff;
+		int g = (pix >> 8) & 0xff;
+		int r = (pix >> 16) & 0xff;
+		int a = (pix >> 24) & 0xff;
+		in += inStep;
+
+		if (ca != 255) {
+			a = a * ca >> 8;
+		}
+
+		switch (a) {
+		case 0: // Full transparency
+			out += 4;
+			break;
+		case 255: // Full opacity
+#if defined(SCUMM_LITTLE_ENDIAN)
+			if (cb != 255)
+				*out++ = (b * cb) >> 8;
+			else
+				*out++ = b;
+
+			if (cg != 255)
+				*out++ = (g * cg) >> 8;
+			else
+				*out++ = g;
+
+			if (cr != 255)
+				*out++ = (r * cr) >> 8;
+			else
+				*out++ = r;
+
+			*out++ = a;
+#else
+			*out++ = a;
+
+			if (cr != 255)
+				*out++ = (r * cr) >> 8;
+			else
+				*out++ = r;
+
+			if (cg != 255)
+				*out++ = (g * cg) >> 8;
+			else
+				*out++ = g;
+
+			if (cb != 255)
+				*out++ = (b * cb) >> 8;
+			else
+				*out++ = b;
+#endif
+			break;
+
+		default: // alpha blending
+#if defined(SCUMM_LITTLE_ENDIAN)
+			if (cb != 255)
+				*out += ((b - *out) * a * cb) >> 16;
+			else
+				*out += ((b - *out) * a) >> 8;
+			out++;
+			if (cg != 255)
+				*out += ((g - *out) * a * cg) >> 16;
+			else
+				*out += ((g - *out) * a) >> 8;
+			out++;
+			if (cr != 255)
+				*out += ((r - *out) * a * cr) >> 16;
+			else
+				*out += ((r - *out) * a) >> 8;
+			out++;
+			*out = 255;
+			out++;
+#else
+			*out = 255;
+			out++;
+			if (cr != 255)
+				*out += ((r - *out) * a * cr) >> 16;
+			else
+				*out += ((r - *out) * a) >> 8;
+			out++;
+			if (cg != 255)
+				*out += ((g - *out) * a * cg) >> 16;
+			else
+				*out += ((g - *out) * a) >> 8;
+			out++;
+			if (cb != 255)
+				*out += ((b - *out) * a * cb) >> 16;
+			else
+				*out += ((b - *out) * a) >> 8;
+			out++;
+#endif
+		}
+	}
+}
+
+// All SIMD kernels below compute exactly the same as the scalar one, four
+// pixels at a time. Horizontally mirrored rows are handled by loading the
+// four pixels preceding the current one and reversing their order. With a
+// uniform modulation color t all color channels use the tinted formulas:
+//
+//   opaque:  c * t >> 8
+//   blended: out + ((c - out) * a * t >> 16)
+//
+// Pixels with an alpha of 0 are left untouched and blended pixels get an
+// alpha of 255, like in the scalar kernel.
+
+#ifdef BLIT_KERNELS_SSE2
+
+#pragma mark -
+#pragma mark --- SSE2 kernels ---
+#pragma mark -
+
+static inline __m128i selectSSE2(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/**
+ * Blends the channels of two pixels, which have been widened to 16 bits.
+ * Without modulation this is out + ((c - out) * a >> 8), which the signed
+ * high multiplication computes exactly as ((c - out) << 7) * (a << 1) >> 16.
+ * With modulation the product p = a * t needs all 16 bits, so it is split
+ * into its high and low byte and (c - out) * p is computed with a multiply
+ * and add of ((c - out) << 7, c - out) and (high << 1, low).
+ */
+template<bool modulate>
+static inline __m128i blendSSE2(__m128i c, __m128i out, __m128i alpha, __m128i tint) {
+	const __m128i diff = _mm_sub_epi16(c, out);
+
+	if (!modulate)
+		return _mm_add_epi16(out, _mm_mulhi_epi16(_mm_slli_epi16(diff, 7), _mm_slli_epi16(alpha, 1)));
+
+	const __m128i p = _mm_mullo_epi16(alpha, tint);
+	const __m128i pHigh = _mm_slli_epi16(_mm_srli_epi16(p, 8), 1);
+	const __m128i pLow = _mm_and_si128(p, _mm_set1_epi16(0xFF));
+	const __m128i diffHigh = _mm_slli_epi16(diff, 7);
+
+	const __m128i d0 = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(diffHigh, diff), _mm_unpacklo_epi16(pHigh, pLow)), 16);
+	const __m128i d1 = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(diffHigh, diff), _mm_unpackhi_epi16(pHigh, pLow)), 16);
+	return _mm_add_epi16(out, _mm_packs_epi32(d0, d1));
+}
+
+template<bool modulate>
+static void blitRowSSE2(byte *out, const byte *in, int inStep, int count, int ca, int cr, int cg, int cb) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i opaqueAlpha = _mm_set1_epi32(255);
+	const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000);
+	const __m128i alphaScale = _mm_set1_epi32(ca);
+	const __m128i tint = _mm_set1_epi16(cr);
+
+	for (; count >= 4; count -= 4) {
+		__m128i src;
+		if (inStep > 0)
+			src = _mm_loadu_si128((const __m128i *)in);
+		else
+			src = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(in - 12)), _MM_SHUFFLE(0, 1, 2, 3));
+		in += 4 * inStep;
+
+		__m128i alpha = _mm_srli_epi32(src, 24);
+		if (modulate && ca != 255)
+			alpha = _mm_srli_epi32(_mm_mullo_epi16(alpha, alphaScale), 8);
+
+		const __m128i transparent = _mm_cmpeq_epi32(alpha, zero);
+		if (_mm_movemask_epi8(transparent) == 0xFFFF) {
+			out += 16;
+			continue;
+		}
+
+		const __m128i opaque = _mm_cmpeq_epi32(alpha, opaqueAlpha);
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		// Spread the alpha of each pixel over its four 16 bit channels
+		alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+		const __m128i alphaLo = _mm_unpacklo_epi32(alpha, alpha);
+		const __m128i alphaHi = _mm_unpackhi_epi32(alpha, alpha);
+
+		const __m128i srcLo = _mm_unpacklo_epi8(src, zero);
+		const __m128i srcHi = _mm_unpackhi_epi8(src, zero);
+
+		__m128i result = _mm_packus_epi16(
+			blendSSE2<modulate>(srcLo, _mm_unpacklo_epi8(dst, zero), alphaLo, tint),
+			blendSSE2<modulate>(srcHi, _mm_unpackhi_epi8(dst, zero), alphaHi, tint));
+		result = _mm_or_si128(result, alphaMask);
+
+		__m128i opaqueResult = src;
+		if (modulate) {
+			opaqueResult = _mm_packus_epi16(
+				_mm_srli_epi16(_mm_mullo_epi16(srcLo, tint), 8),
+				_mm_srli_epi16(_mm_mullo_epi16(srcHi, tint), 8));
+			opaqueResult = _mm_or_si128(opaqueResult, alphaMask);
+		}
+
+		result = selectSSE2(opaque, opaqueResult, result);
+		result = selectSSE2(transparent, dst, result);
+		_mm_storeu_si128((__m128i *)out, result);
+		out += 16;
+	}
+
+	blitRowScalar(out, in, inStep, count, ca, cr, cg, cb);
+}
+
+#endif
+
+#ifdef BLIT_KERNELS_NEON
+
+#pragma mark -
+#pragma mark --- NEON kernels ---
+#pragma mark -
+
+/**
+ * Blends four channels, which have been widened to 16 bits. The products
+ * are computed with 32 bits, so no tricks are needed to keep them exact.
+ */
+template<bool modulate>
+static inline int16x4_t blendNEON(int16x4_t c, int16x4_t out, int16x4_t alpha, int tint) {
+	int32x4_t d = vmull_s16(vsub_s16(c, out), alpha);
+
+	if (modulate)
+		d = vshrq_n_s32(vmulq_n_s32(d, tint), 16);
+	else
+		d = vshrq_n_s32(d, 8);
+
+	return vadd_s16(out, vmovn_s32(d));
+}
+
+template<bool modulate>
+static inline uint8x8_t blendHalfNEON(uint8x8_t c, uint8x8_t out, uint8x8_t alpha, int tint) {
+	const int16x8_t c16 = vreinterpretq_s16_u16(vmovl_u8(c));
+	const int16x8_t out16 = vreinterpretq_s16_u16(vmovl_u8(out));
+	const int16x8_t alpha16 = vreinterpretq_s16_u16(vmovl_u8(alpha));
+
+	return vqmovun_s16(vcombine_s16(
+		blendNEON<modulate>(vget_low_s16(c16), vget_low_s16(out16), vget_low_s16(alpha16), tint),
+		blendNEON<modulate>(vget_high_s16(c16), vget_high_s16(out16), vget_high_s16(alpha16), tint)));
+}
+
+template<bool modulate>
+static void blitRowNEON(byte *out, const byte *in, int inStep, int count, int ca, int cr, int cg, int cb) {
+	const uint32x4_t zero = vdupq_n_u32(0);
+	const uint32x4_t opaqueAlpha = vdupq_n_u32(255);
+	const uint8x16_t alphaMask = vreinterpretq_u8_u32(vdupq_n_u32(0xFF000000));
+	const uint8x8_t tint = vdup_n_u8(cr);
+
+	for (; count >= 4; count -= 4) {
+		uint8x16_t src;
+		if (inStep > 0) {
+			src = vld1q_u8(in);
+		} else {
+			const uint32x4_t reversed = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(in - 12)));
+			src = vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(reversed), vget_low_u32(reversed)));
+		}
+		in += 4 * inStep;
+
+		uint32x4_t alpha = vshrq_n_u32(vreinterpretq_u32_u8(src), 24);
+		if (modulate && ca != 255)
+			alpha = vshrq_n_u32(vmulq_n_u32(alpha, ca), 8);
+
+		const uint32x4_t transparent = vceqq_u32(alpha, zero);
+		const uint32x2_t allTransparent = vand_u32(vget_low_u32(transparent), vget_high_u32(transparent));
+		if (vget_lane_u32(vpmin_u32(allTransparent, allTransparent), 0)) {
+			out += 16;
+			continue;
+		}
+
+		const uint32x4_t opaque = vceqq_u32(alpha, opaqueAlpha);
+		const uint8x16_t dst = vld1q_u8(out);
+
+		// Spread the alpha of each pixel over its four channels
+		const uint8x16_t alpha8 = vreinterpretq_u8_u32(vmulq_n_u32(alpha, 0x01010101));
+
+		uint8x16_t result = vcombine_u8(
+			blendHalfNEON<modulate>(vget_low_u8(src), vget_low_u8(dst), vget_low_u8(alpha8), cr),
+			blendHalfNEON<modulate>(vget_high_u8(src), vget_high_u8(dst), vget_high_u8(alpha8), cr));
+		result = vorrq_u8(result, alphaMask);
+
+		uint8x16_t opaqueResult = src;
+		if (modulate) {
+			opaqueResult = vcombine_u8(
+				vshrn_n_u16(vmull_u8(vget_low_u8(src), tint), 8),
+				vshrn_n_u16(vmull_u8(vget_high_u8(src), tint), 8));
+			opaqueResult = vorrq_u8(opaqueResult, alphaMask);
+		}
+
+		result = vbslq_u8(vreinterpretq_u8_u32(opaque), opaqueResult, result);
+		result = vbslq_u8(vreinterpretq_u8_u32(transparent), dst, result);
+		vst1q_u8(out, result);
+		out += 16;
+	}
+
+	blitRowScalar(out, in, inStep, count, ca, cr, cg, cb);
+}
+
+#endif
+
+#pragma mark -
+
+static const BlitKernels s_blitKernels[kBlitKernelCount] = {
+	{ "scalar", blitRowScalar, blitRowScalar, blitRowScalar },
+#ifdef BLIT_KERNELS_SSE2
+	{ "SSE2", blitRowSSE2<false>, blitRowSSE2<true>, blitRowScalar },
+#else
+	{ "SSE2", 0, 0, 0 },
+#endif
+#ifdef BLIT_KERNELS_NEON
+	{ "NEON", blitRowNEON<false>, blitRowNEON<true>, blitRowScalar }
+#else
+	{ "NEON", 0, 0, 0 }
+#endif
+};
+
+const BlitKernels *getBlitKernels(BlitKernelType type) {
+	assert(type >= 0 && type < kBlitKernelCount);
+
+	if (!s_blitKernels[type].blitRow)
+		return 0;
+
+	switch (type) {
+	case kBlitKernelSSE2:
+		return Common::hasCPUFeature(Common::kCPUFeatureSSE2) ? &s_blitKernels[type] : 0;
+	case kBlitKernelNEON:
+		return Common::hasCPUFeature(Common::kCPUFeatureNEON) ? &s_blitKernels[type] : 0;
+	default:
+		return &s_blitKernels[type];
+	}
+}
+
+const BlitKernels &getBestBlitKernels() {
+	static const BlitKernelType preferred[] = { kBlitKernelSSE2, kBlitKernelNEON };
+
+	for (int i = 0; i < ARRAYSIZE(preferred); ++i) {
+		const BlitKernels *kernels = getBlitKernels(preferred[i]);
+		if (kernels)
+			return *kernels;
+	}
+
+	return s_blitKernels[kBlitKernelScalar];
+}
+
+} // End of namespace Sword25
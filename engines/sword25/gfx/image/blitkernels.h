@@ -0,0 +1,92 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef SWORD25_BLITKERNELS_H
+#define SWORD25_BLITKERNELS_H
+
+#include "common/scummsys.h"
+
+namespace Sword25 {
+
+/**
+ * Draws a row of 32 bit ARGB pixels onto the frame buffer, as done by
+ * RenderedImage::blit(): the source pixels are modulated by the given color
+ * and alpha blended with the pixels already in the frame buffer.
+ *
+ * @param out    the first destination pixel
+ * @param in     the first source pixel
+ * @param inStep distance between two source pixels in bytes, either 4 or -4
+ *               for horizontally mirrored images
+ * @param count  number of pixels to draw
+ * @param ca     alpha of the modulation color
+ * @param cr     red of the modulation color, already multiplied by its alpha
+ * @param cg     green of the modulation color, already multiplied by its alpha
+ * @param cb     blue of the modulation color, already multiplied by its alpha
+ */
+typedef void (*BlitRowProc)(byte *out, const byte *in, int inStep, int count, int ca, int cr, int cg, int cb);
+
+/**
+ * A set of blitting kernels for one instruction set.
+ */
+struct BlitKernels {
+	const char *name;
+	/** Only for ca, cr, cg and cb all being 255, i.e. no color modulation. */
+	BlitRowProc blitRowPlain;
+	/** Only for cr == cg == cb != 255, i.e. a uniform alpha or gray tint. */
+	BlitRowProc blitRowUniform;
+	/** For any modulation color. */
+	BlitRowProc blitRow;
+};
+
+enum BlitKernelType {
+	kBlitKernelScalar,
+	kBlitKernelSSE2,
+	kBlitKernelNEON,
+
+	kBlitKernelCount
+};
+
+/**
+ * Returns the kernels for the given instruction set, or 0 if they are not
+ * compiled in or not supported by the host CPU.
+ */
+const BlitKernels *getBlitKernels(BlitKernelType type);
+
+/**
+ * Returns the fastest set of kernels supported by the host CPU.
+ */
+const BlitKernels &getBestBlitKernels();
+
+/**
+ * Returns the kernel of the set which handles the given modulation color.
+ */
+inline BlitRowProc selectBlitRow(const BlitKernels &kernels, int ca, int cr, int cg, int cb) {
+	if (ca == 255 && cr == 255 && cg == 255 && cb == 255)
+		return kernels.blitRowPlain;
+	if (cr == cg && cg == cb)
+		return kernels.blitRowUniform;
+	return kernels.blitRow;
+}
+
+} // End of namespace Sword25
+
+#endif
@@ -37,6 +37,7 @@
 #include "sword25/package/packagemanager.h"
 #include "sword25/gfx/image/imgloader.h"
 #include "sword25/gfx/image/renderedimage.h"
+#include "sword25/gfx/image/blitkernels.h"
 
 #include "common/system.h"
 
@@ -96,7 +97,8 @@ static byte *readSavegameThumbnail(const Common::String &filename, uint &fileSiz
 RenderedImage::RenderedImage(const Common::String &filename, bool &result) :
 	_data(0),
 	_width(0),
-	_height(0) {
+	_height(0),
+	_scaledImage(0) {
 	result = false;
 
 	PackageManager *pPackage = Kernel::getInstance()->getPackage();
@@ -146,7 +148,8 @@ RenderedImage::RenderedImage(const Common::String &filename, bool &result) :
 
 RenderedImage::RenderedImage(uint width, uint height, bool &result) :
 	_width(width),
-	_height(height) {
+	_height(height),
+	_scaledImage(0) {
 
 	_data = new byte[width * height * 4];
 	Common::set_to(_data, &_data[width * height * 4], 0);
@@ -159,7 +162,7 @@ RenderedImage::RenderedImage(uint width, uint height, bool &result) :
 	return;
 }
 
-RenderedImage::RenderedImage() : _width(0), _height(0), _data(0) {
+RenderedImage::RenderedImage() : _width(0), _height(0), _data(0), _scaledImage(0) {
 	_backSurface = Kernel::getInstance()->getGfx()->getSurface();
 
 	_doCleanup = false;
@@ -170,6 +173,8 @@ RenderedImage::RenderedImage() : _width(0), _height(0), _data(0) {
 // -----------------------------------------------------------------------------
 
 RenderedImage::~RenderedImage() {
+	freeScaledImage();
+
 	if (_doCleanup)
 		delete[] _data;
 }
@@ -190,6 +195,8 @@ bool RenderedImage::setContent(const byte *pixeldata, uint size, uint offset, ui
 		return false;
 	}
 
+	freeScaledImage();
+
 	const byte *in = &pixeldata[offset];
 	byte *out = _data;
 
@@ -203,6 +210,8 @@ bool RenderedImage::setContent(const byte *pixeldata, uint size, uint offset, ui
 }
 
 void RenderedImage::replaceContent(byte *pixeldata, int width, int height) {
+	freeScaledImage();
+
 	_width = width;
 	_height = height;
 	_data = pixeldata;
@@ -268,161 +277,67 @@ bool RenderedImage::blit(int posX, int posY, int flipping, Common::Rect *pPartRe
 	height = height * 2 / 3;
 #endif
 
-	Graphics::Surface *img;
-	Graphics::Surface *imgScaled = NULL;
-	byte *savedPixels = NULL;
+	// Work on a copy of the surface description, since it gets clipped below
+	Graphics::Surface img = srcImage;
 	if ((width != srcImage.w) || (height != srcImage.h)) {
-		// Scale the image
-		img = imgScaled = scale(srcImage, width, height);
-		savedPixels = (byte *)img->pixels;
-	} else {
-		img = &srcImage;
+		// Scale the image, or reuse the scaled version of a previous blit
+		const Common::Rect part = pPartRect ? *pPartRect : Common::Rect(_width, _height);
+		img = *getScaledImage(srcImage, part, width, height);
 	}
 
 	// Handle off-screen clipping
 	if (posY < 0) {
-		img->h = MAX(0, (int)img->h - -posY);
-		img->pixels = (byte *)img->pixels + img->pitch * -posY;
+		img.h = MAX(0, (int)img.h - -posY);
+		img.pixels = (byte *)img.pixels + img.pitch * -posY;
 		posY = 0;
 	}
 
 	if (posX < 0) {
-		img->w = MAX(0, (int)img->w - -posX);
-		img->pixels = (byte *)img->pixels + (-posX * 4);
+		img.w = MAX(0, (int)img.w - -posX);
+		img.pixels = (byte *)img.pixels + (-posX * 4);
 		posX = 0;
 	}
 
-	img->w = CLIP((int)img->w, 0, (int)MAX((int)_backSurface->w - posX, 0));
-	img->h = CLIP((int)img->h, 0, (int)MAX((int)_backSurface->h - posY, 0));
+	img.w = CLIP((int)img.w, 0, (int)MAX((int)_backSurface->w - posX, 0));
+	img.h = CLIP((int)img.h, 0, (int)MAX((int)_backSurface->h - posY, 0));
+
+	// Only the part inside of the clip rect of the graphic engine is drawn,
+	// with the same mapping of source to destination pixels as without it
+	GraphicEngine *gfxPtr = Kernel::getInstance()->getGfx();
+	const Common::Rect &clipRect = gfxPtr->getClipRect();
+	const int firstRow = MAX(clipRect.top - posY, 0);
+	const int lastRow = MIN(clipRect.bottom - posY, (int)img.h);
+	const int firstCol = MAX(clipRect.left - posX, 0);
+	const int lastCol = MIN(clipRect.right - posX, (int)img.w);
 
-	if ((img->w > 0) && (img->h > 0)) {
+	if ((img.w > 0) && (img.h > 0) && (firstRow < lastRow) && (firstCol < lastCol)) {
 		int xp = 0, yp = 0;
 
 		int inStep = 4;
-		int inoStep = img->pitch;
+		int inoStep = img.pitch;
 		if (flipping & Image::FLIP_V) {
 			inStep = -inStep;
-			xp = img->w - 1;
+			xp = img.w - 1;
 		}
 
 		if (flipping & Image::FLIP_H) {
 			inoStep = -inoStep;
-			yp = img->h - 1;
+			yp = img.h - 1;
 		}
 
-		byte *ino = (byte *)img->getBasePtr(xp, yp);
-		byte *outo = (byte *)_backSurface->getBasePtr(posX, posY);
-		byte *in, *out;
-
-		for (int i = 0; i < img->h; i++) {
-			out = outo;
-			in = ino;
-			for (int j = 0; j < img->w; j++) {
-				uint32 pix = *(uint32 *)in;
-				int b = (pix >> 0) & 0xff;
-				int g = (pix >> 8) & 0xff;
-				int r = (pix >> 16) & 0xff;
-				int a = (pix >> 24) & 0xff;
-				in += inStep;
-
-				if (ca != 255) {
-					a = a * ca >> 8;
-				}
-
-				switch (a) {
-				case 0: // Full transparency
-					out += 4;
-					break;
-				case 255: // Full opacity
-#if defined(SCUMM_LITTLE_ENDIAN)
-					if (cb != 255)
-						*out++ = (b * cb) >> 8;
-					else
-						*out++ = b;
-
-					if (cg != 255)
-						*out++ = (g * cg) >> 8;
-					else
-						*out++ = g;
-
-					if (cr != 255)
-						*out++ = (r * cr) >> 8;
-					else
-						*out++ = r;
-
-					*out++ = a;
-#else
-					*out++ = a;
-
-					if (cr != 255)
-						*out++ = (r * cr) >> 8;
-					else
-						*out++ = r;
-
-					if (cg != 255)
-						*out++ = (g * cg) >> 8;
-					else
-						*out++ = g;
-
-					if (cb != 255)
-						*out++ = (b * cb) >> 8;
-					else
-						*out++ = b;
-#endif
-					break;
-
-				default: // alpha blending
-#if defined(SCUMM_LITTLE_ENDIAN)
-					if (cb != 255)
-						*out += ((b - *out) * a * cb) >> 16;
-					else
-						*out += ((b - *out) * a) >> 8;
-					out++;
-					if (cg != 255)
-						*out += ((g - *out) * a * cg) >> 16;
-					else
-						*out += ((g - *out) * a) >> 8;
-					out++;
-					if (cr != 255)
-						*out += ((r - *out) * a * cr) >> 16;
-					else
-						*out += ((r - *out) * a) >> 8;
-					out++;
-					*out = 255;
-					out++;
-#else
-					*out = 255;
-					out++;
-					if (cr != 255)
-						*out += ((r - *out) * a * cr) >> 16;
-					else
-						*out += ((r - *out) * a) >> 8;
-					out++;
-					if (cg != 255)
-						*out += ((g - *out) * a * cg) >> 16;
-					else
-						*out += ((g - *out) * a) >> 8;
-					out++;
-					if (cb != 255)
-						*out += ((b - *out) * a * cb) >> 16;
-					else
-						*out += ((b - *out) * a) >> 8;
-					out++;
-#endif
-				}
-			}
+		byte *ino = (byte *)img.getBasePtr(xp, yp) + firstRow * inoStep + firstCol * inStep;
+		byte *outo = (byte *)_backSurface->getBasePtr(posX + firstCol, posY + firstRow);
+
+		const BlitRowProc blitRow = selectBlitRow(getBestBlitKernels(), ca, cr, cg, cb);
+		for (int i = firstRow; i < lastRow; i++) {
+			blitRow(outo, ino, inStep, lastCol - firstCol, ca, cr, cg, cb);
 			outo += _backSurface->pitch;
 			ino += inoStep;
 		}
 
-		g_system->copyRectToScreen((byte *)_backSurface->getBasePtr(posX, posY), _backSurface->pitch, posX, posY,
-			img->w, img->h);
-	}
-
-	if (imgScaled) {
-		imgScaled->pixels = savedPixels;
-		imgScaled->free();
-		delete imgScaled;
+		if (!gfxPtr->isClipping())
+			g_system->copyRectToScreen((byte *)_backSurface->getBasePtr(posX, posY), _backSurface->pitch, posX, posY,
+				img.w, img.h);
 	}
 
 	return true;
@@ -452,6 +367,24 @@ void RenderedImage::copyDirectly(int posX, int posY) {
 	g_system->copyRectToScreen(data, _backSurface->pitch, posX, posY, w, h);
 }
 
+const Graphics::Surface *RenderedImage::getScaledImage(const Graphics::Surface &srcImage, const Common::Rect &part, int width, int height) {
+	if (_scaledImage && _scaledPart == part && _scaledImage->w == width && _scaledImage->h == height)
+		return _scaledImage;
+
+	freeScaledImage();
+	_scaledImage = scale(srcImage, width, height);
+	_scaledPart = part;
+	return _scaledImage;
+}
+
+void RenderedImage::freeScaledImage() {
+	if (_scaledImage) {
+		_scaledImage->free();
+		delete _scaledImage;
+		_scaledImage = 0;
+	}
+}
+
 /**
  * Scales a passed surface, creating a new surface with the result
  * @param srcImage		Source image to scale
@@ -113,6 +113,18 @@ private:
 
 	Graphics::Surface *_backSurface;
 
+	// The scaled version of the image used by the last scaled blit, so
+	// that blitting at the same size again doesn't need to rescale it
+	Graphics::Surface *_scaledImage;
+	Common::Rect _scaledPart;
+
+	/**
+	 * Returns the given part of the image scaled to the given size. The
+	 * result is cached until the next call with a different part or size.
+	 */
+	const Graphics::Surface *getScaledImage(const Graphics::Surface &srcImage, const Common::Rect &part, int width, int height);
+	void freeScaledImage();
+
 	static int *scaleLine(int size, int srcSize);
 };
 
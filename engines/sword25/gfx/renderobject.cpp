@@ -100,13 +100,17 @@ RenderObject::~RenderObject() {
 	if (_parentPtr.isValid())
 		_parentPtr->detatchChildren(this->getHandle());
 
+	// The area that the object covered has to be redrawn without it
+	if (_managerPtr)
+		_managerPtr->addDamage(_renderRect);
+
 	deleteAllChildren();
 
 	// Objekt deregistrieren.
 	RenderObjectRegistry::instance().deregisterObject(this);
 }
 
-bool RenderObject::render() {
+bool RenderObject::render(const Common::Rect &clipRect) {
 	// Objektnderungen validieren
 	validateObject();
 
@@ -121,12 +125,15 @@ bool RenderObject::render() {
 	}
 
 	// Objekt zeichnen.
-	doRender();
+	// Objects outside of the clip rect would not change anything there.
+	if (_renderRect.intersects(clipRect))
+		doRender();
 
 	// Dann mssen die Kinder gezeichnet werden
+	// They don't have to be inside of the area of their parent.
 	RENDEROBJECT_ITER it = _children.begin();
 	for (; it != _children.end(); ++it)
-		if (!(*it)->render())
+		if (!(*it)->render(clipRect))
 			return false;
 
 	return true;
@@ -145,12 +152,13 @@ void RenderObject::validateObject() {
 bool RenderObject::updateObjectState() {
 	// Falls sich das Objekt verndert hat, muss der interne Zustand neu berechnet werden und evtl. Update-Regions fr den nchsten Frame
 	// registriert werden.
-	if ((calcBoundingBox() != _oldBbox) ||
+	bool changed = (calcBoundingBox() != _oldBbox) ||
 	        (_visible != _oldVisible) ||
 	        (_x != _oldX) ||
 	        (_y != _oldY) ||
 	        (_z != _oldZ) ||
-	        _refreshForced) {
+	        _refreshForced;
+	if (changed) {
 		// Renderrang des Objektes neu bestimmen, da sich dieser verndert haben knnte
 		if (_parentPtr.isValid())
 			_parentPtr->signalChildChange();
@@ -162,6 +170,16 @@ bool RenderObject::updateObjectState() {
 		validateObject();
 	}
 
+	// Both the area that the object covered in the last frame and the one it
+	// covers now have to be redrawn. An object can also appear, disappear or
+	// move without a change of its own, through its ancestors.
+	Common::Rect renderRect = calcRenderRect();
+	if (_managerPtr && (changed || renderRect != _renderRect)) {
+		_managerPtr->addDamage(_renderRect);
+		_managerPtr->addDamage(renderRect);
+	}
+	_renderRect = renderRect;
+
 	// Dann muss der Objektstatus der Kinder aktualisiert werden.
 	RENDEROBJECT_ITER it = _children.begin();
 	for (; it != _children.end(); ++it)
@@ -191,6 +209,20 @@ Common::Rect RenderObject::calcBoundingBox() const {
 	return bbox;
 }
 
+Common::Rect RenderObject::calcRenderRect() const {
+	if (!isRendered())
+		return Common::Rect();
+
+	// doRender() draws at the absolute position, without clipping at the parent
+	return Common::Rect(_absoluteX, _absoluteY, _absoluteX + _width, _absoluteY + _height);
+}
+
+bool RenderObject::isRendered() const {
+	if (!_visible)
+		return false;
+	return !_parentPtr.isValid() || _parentPtr->isRendered();
+}
+
 void RenderObject::calcAbsolutePos(int &x, int &y) const {
 	x = calcAbsoluteX();
 	y = calcAbsoluteY();
@@ -214,11 +214,12 @@ public:
 	/**
 	    @brief Rendert des Objekt und alle seine Unterobjekte.
 	    @return Gibt false zurck, falls beim Rendern ein Fehler aufgetreten ist.
+	    @param ClipRect nur Objekte, die dieses Rechteck berhren, werden gezeichnet.
 	    @remark Vor jedem Aufruf dieser Methode muss ein Aufruf von UpdateObjectState() erfolgt sein.
 	            Dieses kann entweder direkt geschehen oder durch den Aufruf von UpdateObjectState() an einem Vorfahren-Objekt.<br>
 	            Diese Methode darf nur von BS_RenderObjectManager aufgerufen werden.
 	*/
-	bool render();
+	bool render(const Common::Rect &clipRect);
 	/**
 	    @brief Bereitet das Objekt und alle seine Unterobjekte auf einen Rendervorgang vor.
 	           Hierbei werden alle Dirty-Rectangles berechnet und die Renderreihenfolge aktualisiert.
@@ -387,6 +388,8 @@ protected:
 	int         _oldY;
 	int         _oldZ;
 	bool        _oldVisible;
+	/// The screen area the object covered when it was last drawn, empty if it was not drawn.
+	Common::Rect _renderRect;
 
 	/// Ein Pointer auf den BS_RenderObjektManager, der das Objekt verwaltet.
 	RenderObjectManager *_managerPtr;
@@ -469,6 +472,15 @@ private:
 	    @return Gibt das Dirty-Rectangle des Objektes in Bildschirmkoordinaten zurck.
 	*/
 	Common::Rect calcDirtyRect() const;
+	/**
+	    @brief Calculates the screen area the object covers when it is drawn.
+	    @return Returns an empty rect if the object or one of its ancestors is invisible.
+	*/
+	Common::Rect calcRenderRect() const;
+	/**
+	    @brief Returns true if the object and all of its ancestors are visible.
+	*/
+	bool isRendered() const;
 	/**
 	    @brief Berechnet die absolute Position des Objektes.
 	*/
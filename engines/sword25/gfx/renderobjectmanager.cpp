@@ -41,10 +41,14 @@
 #include "sword25/gfx/timedrenderobject.h"
 #include "sword25/gfx/rootrenderobject.h"
 
+#include "common/system.h"
+#include "graphics/surface.h"
+
 namespace Sword25 {
 
 RenderObjectManager::RenderObjectManager(int width, int height, int framebufferCount) :
-	_frameStarted(false) {
+	_frameStarted(false),
+	_screenRect(width, height) {
 	// Wurzel des BS_RenderObject-Baumes erzeugen.
 	_rootPtr = (new RootRenderObject(this, width, height))->getHandle();
 }
@@ -75,8 +79,35 @@ bool RenderObjectManager::render() {
 
 	_frameStarted = false;
 
+	// Nothing changed, the screen is still up to date
+	if (_damage.empty())
+		return true;
+
 	// Die Render-Methode der Wurzel aufrufen. Dadurch wird das rekursive Rendern der Baumelemente angestoen.
-	return _rootPtr->render();
+	// Each changed area is redrawn on its own, only with the objects touching it.
+	GraphicEngine *gfxPtr = Kernel::getInstance()->getGfx();
+	bool result = true;
+	for (uint i = 0; i < _damage.size() && result; ++i) {
+		gfxPtr->setClipRect(&_damage[i]);
+		result = _rootPtr->render(_damage[i]);
+	}
+	gfxPtr->setClipRect(0);
+
+	// While clipping, drawing doesn't update the screen, so do that now
+	Graphics::Surface *backSurface = gfxPtr->getSurface();
+	for (uint i = 0; i < _damage.size(); ++i) {
+		const Common::Rect &rect = _damage[i];
+		g_system->copyRectToScreen((byte *)backSurface->getBasePtr(rect.left, rect.top), backSurface->pitch,
+		                           rect.left, rect.top, rect.width(), rect.height());
+	}
+
+	_damage.clear();
+
+	return result;
+}
+
+void RenderObjectManager::addDamage(const Common::Rect &rect) {
+	Common::addDirtyRect(_damage, rect, _screenRect);
 }
 
 void RenderObjectManager::attatchTimedRenderObject(RenderObjectPtr<TimedRenderObject> renderObjectPtr) {
@@ -140,6 +171,8 @@ bool RenderObjectManager::unpersist(InputPersistenceBlock &reader) {
 	// Alle BS_AnimationTemplates wieder herstellen.
 	result &= AnimationTemplateRegistry::instance().unpersist(reader);
 
+	invalidateScreen();
+
 	return result;
 }
 
@@ -106,11 +106,26 @@ public:
 	*/
 	void detatchTimedRenderObject(RenderObjectPtr<TimedRenderObject> pRenderObject);
 
+	/**
+	    @brief Marks a screen area as changed, so that it gets redrawn by the next call of render().
+	    @param Rect the area in screen coordinates. It is clipped to the screen.
+	*/
+	void addDamage(const Common::Rect &rect);
+	/**
+	    @brief Makes the next call of render() redraw the whole screen.
+	*/
+	void invalidateScreen() {
+		addDamage(_screenRect);
+	}
+
 	virtual bool persist(OutputPersistenceBlock &writer);
 	virtual bool unpersist(InputPersistenceBlock &reader);
 
 private:
 	bool _frameStarted;
+	Common::Rect _screenRect;
+	/// Changed screen areas since the last frame, merged where they overlap
+	Common::Array<Common::Rect> _damage;
 	typedef Common::Array<RenderObjectPtr<TimedRenderObject> > RenderObjectList;
 	RenderObjectList _timedRenderObjects;
 
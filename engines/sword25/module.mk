@@ -24,6 +24,7 @@ MODULE_OBJS := \
 	gfx/text.o \
 	gfx/timedrenderobject.o \
 	gfx/image/art.o \
+	gfx/image/blitkernels.o \
 	gfx/image/imgloader.o \
 	gfx/image/renderedimage.o \
 	gfx/image/swimage.o \
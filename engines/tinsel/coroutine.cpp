@@ -22,6 +22,8 @@
 #include "tinsel/coroutine.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/memorypool.h"
+#include "common/textconsole.h"
 
 namespace Tinsel {
 
@@ -59,6 +61,94 @@ static void displayCoroStats() {
 }
 #endif
 
+#pragma mark --- Context allocation ---
+
+namespace {
+
+/**
+ * Coroutine contexts are created and destroyed all the time by the
+ * scheduler, so they are taken from pools for a few size classes.
+ * Each allocation is preceded by a small header recording its size
+ * class, as contexts are deleted through a CoroBaseContext pointer
+ * and the real size of the object is not known at that point.
+ */
+enum {
+	kCoroHeaderSize = 8,
+	kNumCoroPools = 5
+};
+
+struct CoroHeader {
+	uint32 pool;	// Pool index, or kNumCoroPools for plain malloc
+	uint32 size;	// Size requested
+};
+
+static Common::MemoryPool s_coroPool32(32 + kCoroHeaderSize);
+static Common::MemoryPool s_coroPool64(64 + kCoroHeaderSize);
+static Common::MemoryPool s_coroPool128(128 + kCoroHeaderSize);
+static Common::MemoryPool s_coroPool256(256 + kCoroHeaderSize);
+static Common::MemoryPool s_coroPool512(512 + kCoroHeaderSize);
+
+static Common::MemoryPool *const s_coroPools[kNumCoroPools] = {
+	&s_coroPool32, &s_coroPool64, &s_coroPool128, &s_coroPool256, &s_coroPool512
+};
+
+static CoroAllocStats s_coroAllocStats;
+
+}
+
+void *CoroBaseContext::operator new(size_t size) {
+	assert(sizeof(CoroHeader) <= kCoroHeaderSize);
+
+	uint32 pool = 0;
+	while (pool < kNumCoroPools && size + kCoroHeaderSize > s_coroPools[pool]->getChunkSize())
+		pool++;
+
+	byte *block;
+	if (pool < kNumCoroPools) {
+		block = (byte *)s_coroPools[pool]->allocChunk();
+	} else {
+		block = (byte *)malloc(size + kCoroHeaderSize);
+		s_coroAllocStats.largeAllocations++;
+	}
+
+	if (!block)
+		error("Cannot allocate memory for coroutine context");
+
+	CoroHeader *header = (CoroHeader *)block;
+	header->pool = pool;
+	header->size = size;
+
+	s_coroAllocStats.allocations++;
+	s_coroAllocStats.liveContexts++;
+	s_coroAllocStats.liveBytes += size;
+	if (s_coroAllocStats.liveBytes > s_coroAllocStats.peakBytes)
+		s_coroAllocStats.peakBytes = s_coroAllocStats.liveBytes;
+
+	return block + kCoroHeaderSize;
+}
+
+void CoroBaseContext::operator delete(void *ptr) {
+	if (!ptr)
+		return;
+
+	byte *block = (byte *)ptr - kCoroHeaderSize;
+	const CoroHeader *header = (const CoroHeader *)block;
+
+	s_coroAllocStats.liveContexts--;
+	s_coroAllocStats.liveBytes -= header->size;
+
+	if (header->pool < kNumCoroPools)
+		s_coroPools[header->pool]->freeChunk(block);
+	else
+		free(block);
+}
+
+const CoroAllocStats &getCoroAllocStats() {
+	return s_coroAllocStats;
+}
+
+#pragma mark --- Context ---
+
 CoroBaseContext::CoroBaseContext(const char *func)
 	: _line(0), _sleep(0), _subctx(0) {
 #if COROUTINE_DEBUG
@@ -73,10 +73,27 @@ struct CoroBaseContext {
 #endif
 	CoroBaseContext(const char *func);
 	~CoroBaseContext();
+
+	// Contexts are allocated from size-class pools, see coroutine.cpp
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr);
 };
 
 typedef CoroBaseContext *CoroContext;
 
+/**
+ * Statistics about the memory used for coroutine contexts.
+ */
+struct CoroAllocStats {
+	uint32 allocations;			///< Number of contexts allocated so far
+	uint32 largeAllocations;	///< Contexts too large for any of the pools
+	uint32 liveContexts;		///< Number of contexts currently allocated
+	uint32 liveBytes;			///< Bytes currently used by contexts
+	uint32 peakBytes;			///< Highest value of liveBytes so far
+};
+
+const CoroAllocStats &getCoroAllocStats();
+
 
 // FIXME: Document this!
 extern CoroContext nullContext;
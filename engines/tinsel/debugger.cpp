@@ -24,6 +24,7 @@
 #include "tinsel/debugger.h"
 #include "tinsel/dialogs.h"
 #include "tinsel/pcode.h"
+#include "tinsel/polygons.h"
 #include "tinsel/scene.h"
 #include "tinsel/sound.h"
 #include "tinsel/music.h"
@@ -67,6 +68,7 @@ Console::Console() : GUI::Debugger() {
 	DCmd_Register("music",		WRAP_METHOD(Console, cmd_music));
 	DCmd_Register("sound",		WRAP_METHOD(Console, cmd_sound));
 	DCmd_Register("string",		WRAP_METHOD(Console, cmd_string));
+	DCmd_Register("poly_stats",	WRAP_METHOD(Console, cmd_polyStats));
 }
 
 Console::~Console() {
@@ -161,4 +163,28 @@ bool Console::cmd_string(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmd_polyStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset"))) {
+		DebugPrintf("%s [reset]\n", argv[0]);
+		DebugPrintf("Prints the polygon hit test statistics, or resets them\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		ResetPolygonQueryStats();
+		DebugPrintf("Polygon statistics reset\n");
+		return true;
+	}
+
+	const POLY_QUERY_STATS &stats = GetPolygonQueryStats();
+	DebugPrintf("Frames: %d, queries: %d, polygons tested: %d, grid rebuilds: %d\n",
+		stats.frames, stats.queries, stats.candidates, stats.rebuilds);
+	if (stats.frames)
+		DebugPrintf("Queries per frame: %.2f\n", (double)stats.queries / stats.frames);
+	if (stats.queries)
+		DebugPrintf("Polygons tested per query: %.2f\n", (double)stats.candidates / stats.queries);
+
+	return true;
+}
+
 } // End of namespace Tinsel
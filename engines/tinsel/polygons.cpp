@@ -312,6 +312,28 @@ int highestYet = 0;
 // dead/alive, offsets
 static POLY_VOLATILE volatileStuff[MAX_POLY];
 
+/**
+ * Uniform grid over the bounding boxes of the scene's polygons, used to
+ * narrow down the candidates tested by InPolygon(). Each cell lists the
+ * handles of the polygons whose (offset) bounding box overlaps it, in
+ * ascending order. The grid is rebuilt lazily whenever the set of
+ * polygons or their offsets change. The dynamic blocking polygon is not
+ * part of the grid, it is always tested separately.
+ */
+#define POLY_GRID_SIZE	16
+
+static struct {
+	bool valid;
+	int left, top;				// Top left corner of the grid
+	int cellWidth, cellHeight;
+	uint32 cellStart[POLY_GRID_SIZE * POLY_GRID_SIZE + 1];
+	byte entries[MAX_POLY * POLY_GRID_SIZE * POLY_GRID_SIZE];
+	int numPaths;
+	byte paths[MAX_POLY];		// Handles of all PATH and EX_PATH polygons
+} polyGrid;
+
+static POLY_QUERY_STATS polyStats;
+
 //----------------- LOCAL MACROS --------------------
 
 // The str parameter is no longer used
@@ -321,14 +343,120 @@ static POLY_VOLATILE volatileStuff[MAX_POLY];
 //-------------------- METHODS ----------------------
 
 static HPOLYGON PolygonIndex(const POLYGON *pp) {
-	for (int i = 0; i <= MAX_POLY; ++i) {
+	// Slots are always handed out from the Polygons array in order
+	if (Polygons && pp >= Polygons && pp < Polygons + MaxPolys) {
+		int i = pp - Polygons;
 		if (Polys[i] == pp)
 			return i;
+	} else if (pp == &extraBlock && Polys[MAX_POLY] == pp) {
+		return MAX_POLY;
 	}
 
 	error("PolygonIndex(): polygon not found");
 }
 
+/**
+ * Marks the polygon grid as out of date.
+ */
+static void InvalidatePolyGrid() {
+	polyGrid.valid = false;
+}
+
+/**
+ * Returns the range of grid cells covered by the given span, clipped
+ * to the grid.
+ */
+static void PolyGridSpan(int from, int to, int origin, int cellSize, int &first, int &last) {
+	first = CLIP((from - origin) / cellSize, 0, POLY_GRID_SIZE - 1);
+	last = CLIP((to - origin) / cellSize, 0, POLY_GRID_SIZE - 1);
+}
+
+/**
+ * Rebuilds the polygon grid from the current polygons and their offsets.
+ */
+static void RebuildPolyGrid() {
+	int left = 0, top = 0, right = -1, bottom = -1;
+	int i, x, y;
+
+	polyGrid.numPaths = 0;
+
+	// Find the area covered by the polygons
+	for (i = 0; i < MAX_POLY; i++) {
+		const POLYGON *pp = Polys[i];
+		if (!pp)
+			continue;
+
+		if (pp->polyType == PATH || pp->polyType == EX_PATH)
+			polyGrid.paths[polyGrid.numPaths++] = (byte)i;
+
+		int xoff = TinselV2 ? volatileStuff[i].xoff : 0;
+		int yoff = TinselV2 ? volatileStuff[i].yoff : 0;
+
+		if (right < left) {
+			left = pp->pleft + xoff;
+			right = pp->pright + xoff;
+			top = pp->ptop + yoff;
+			bottom = pp->pbottom + yoff;
+		} else {
+			left = MIN(left, pp->pleft + xoff);
+			right = MAX(right, pp->pright + xoff);
+			top = MIN(top, pp->ptop + yoff);
+			bottom = MAX(bottom, pp->pbottom + yoff);
+		}
+	}
+
+	polyGrid.left = left;
+	polyGrid.top = top;
+	polyGrid.cellWidth = MAX(1, (right - left + POLY_GRID_SIZE) / POLY_GRID_SIZE);
+	polyGrid.cellHeight = MAX(1, (bottom - top + POLY_GRID_SIZE) / POLY_GRID_SIZE);
+
+	// Count the polygons per cell, then turn the counts into start offsets
+	uint32 *cellStart = polyGrid.cellStart;
+	memset(cellStart, 0, sizeof(polyGrid.cellStart));
+
+	for (i = 0; i < MAX_POLY; i++) {
+		const POLYGON *pp = Polys[i];
+		if (!pp)
+			continue;
+
+		int xoff = TinselV2 ? volatileStuff[i].xoff : 0;
+		int yoff = TinselV2 ? volatileStuff[i].yoff : 0;
+		int x1, x2, y1, y2;
+		PolyGridSpan(pp->pleft + xoff, pp->pright + xoff, polyGrid.left, polyGrid.cellWidth, x1, x2);
+		PolyGridSpan(pp->ptop + yoff, pp->pbottom + yoff, polyGrid.top, polyGrid.cellHeight, y1, y2);
+
+		for (y = y1; y <= y2; y++)
+			for (x = x1; x <= x2; x++)
+				cellStart[y * POLY_GRID_SIZE + x + 1]++;
+	}
+
+	for (i = 0; i < POLY_GRID_SIZE * POLY_GRID_SIZE; i++)
+		cellStart[i + 1] += cellStart[i];
+
+	// Fill in the cells. Walking the polygons in order keeps each cell sorted.
+	uint32 fill[POLY_GRID_SIZE * POLY_GRID_SIZE];
+	memcpy(fill, cellStart, sizeof(fill));
+
+	for (i = 0; i < MAX_POLY; i++) {
+		const POLYGON *pp = Polys[i];
+		if (!pp)
+			continue;
+
+		int xoff = TinselV2 ? volatileStuff[i].xoff : 0;
+		int yoff = TinselV2 ? volatileStuff[i].yoff : 0;
+		int x1, x2, y1, y2;
+		PolyGridSpan(pp->pleft + xoff, pp->pright + xoff, polyGrid.left, polyGrid.cellWidth, x1, x2);
+		PolyGridSpan(pp->ptop + yoff, pp->pbottom + yoff, polyGrid.top, polyGrid.cellHeight, y1, y2);
+
+		for (y = y1; y <= y2; y++)
+			for (x = x1; x <= x2; x++)
+				polyGrid.entries[fill[y * POLY_GRID_SIZE + x]++] = (byte)i;
+	}
+
+	polyGrid.valid = true;
+	polyStats.rebuilds++;
+}
+
 /**
  * Returns TRUE if the point is within the polygon supplied.
  *
@@ -421,15 +549,63 @@ bool IsInPolygon(int xt, int yt, HPOLYGON hp) {
  * Finds a polygon of the specified type containing the supplied point.
  */
 HPOLYGON InPolygon(int xt, int yt, PTYPE type) {
-	for (int j = 0; j <= MAX_POLY; j++)	{
-		if (Polys[j] && Polys[j]->polyType == type) {
-			if (IsInPolygon(xt, yt, j))
-				return j;
+	if (!polyGrid.valid)
+		RebuildPolyGrid();
+
+	polyStats.queries++;
+
+	// Only the polygons overlapping the point's cell can contain it
+	int x = xt - polyGrid.left;
+	int y = yt - polyGrid.top;
+	if (x >= 0 && y >= 0) {
+		x /= polyGrid.cellWidth;
+		y /= polyGrid.cellHeight;
+
+		if (x < POLY_GRID_SIZE && y < POLY_GRID_SIZE) {
+			int cell = y * POLY_GRID_SIZE + x;
+
+			for (uint32 j = polyGrid.cellStart[cell]; j < polyGrid.cellStart[cell + 1]; j++) {
+				HPOLYGON hp = polyGrid.entries[j];
+				if (Polys[hp]->polyType == type) {
+					polyStats.candidates++;
+					if (IsInPolygon(xt, yt, hp))
+						return hp;
+				}
+			}
 		}
 	}
+
+	// The dynamic blocking polygon has the highest handle, so it comes last
+	if (Polys[MAX_POLY] && Polys[MAX_POLY]->polyType == type) {
+		polyStats.candidates++;
+		if (IsInPolygon(xt, yt, MAX_POLY))
+			return MAX_POLY;
+	}
+
 	return NOPOLY;
 }
 
+/**
+ * Returns the polygon query statistics.
+ */
+const POLY_QUERY_STATS &GetPolygonQueryStats() {
+	return polyStats;
+}
+
+/**
+ * Resets the polygon query statistics.
+ */
+void ResetPolygonQueryStats() {
+	memset(&polyStats, 0, sizeof(polyStats));
+}
+
+/**
+ * Called once per game cycle, to allow per-frame query statistics.
+ */
+void CountPolygonQueryFrame() {
+	polyStats.frames++;
+}
+
 /**
  * Given a blocking polygon, current co-ordinates of an actor, and the
  * co-ordinates of where the actor is heading, works out which corner of
@@ -764,9 +940,12 @@ static HPOLYGON PathOnTheWay(HPOLYGON from, HPOLYGON to) {
 	if (IsAdjacentPath(from, to))
 		return to;
 
-	for (i = 0; i < MAX_POLY; i++) {		// For each polygon..
-		POLYGON *p = Polys[i];
-		if (p && p->polyType == PATH)	//...if it's a path
+	if (!polyGrid.valid)
+		RebuildPolyGrid();
+
+	for (i = 0; i < polyGrid.numPaths; i++) {		// For each path polygon..
+		POLYGON *p = Polys[polyGrid.paths[i]];
+		if (p->polyType == PATH)	//...if it's still a path
 			p->tried = false;
 	}
 	Polys[from]->tried = true;
@@ -1239,6 +1418,7 @@ void SavePolygonStuff(POLY_VOLATILE *sps) {
 void RestorePolygonStuff(POLY_VOLATILE *sps) {
 	assert(TinselV2);
 	memcpy(volatileStuff, sps, MAX_POLY*sizeof(POLY_VOLATILE));
+	InvalidatePolyGrid();
 }
 
 
@@ -1580,6 +1760,7 @@ static PPOLYGON GetPolyEntry() {
 	for (i = 0; i < MaxPolys; i++) {
 		if (!Polys[i]) {
 			p = Polys[i] = &Polygons[i];
+			InvalidatePolyGrid();
 
 			// What the hell, just clear it all out - it's safer
 			memset(p, 0, sizeof(POLYGON));
@@ -1786,6 +1967,7 @@ static void KillDeadPolygons() {
 void InitPolygons(SCNHANDLE ph, int numPoly, bool bRestart) {
 	pHandle = ph;
 	noofPolys = numPoly;
+	InvalidatePolyGrid();
 
 	if (Polygons == NULL) {
 		// first time - allocate memory for process list
@@ -1900,6 +2082,7 @@ void DropPolygons() {
 	noofPolys = 0;
 	free(Polygons);
 	Polygons = NULL;
+	InvalidatePolyGrid();
 }
 
 
@@ -2261,6 +2444,7 @@ void MovePolygon(PTYPE ptype, int id, int x, int y) {
 	if (i != NOPOLY) {
 		volatileStuff[i].xoff += (short)x;
 		volatileStuff[i].yoff += (short)y;
+		InvalidatePolyGrid();
 	}
 }
 
@@ -2286,6 +2470,7 @@ void MovePolygonTo(PTYPE ptype, int id, int x, int y) {
 	if (i != NOPOLY) {
 		volatileStuff[i].xoff = (short)x;
 		volatileStuff[i].yoff = (short)y;
+		InvalidatePolyGrid();
 	}
 }
 
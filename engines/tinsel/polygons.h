@@ -73,10 +73,20 @@ struct POLY_VOLATILE {
 	short xoff, yoff;	// Polygon offset
 };
 
+struct POLY_QUERY_STATS {
+	uint32 frames;		// Game cycles counted
+	uint32 queries;		// Calls to InPolygon()
+	uint32 candidates;	// Polygons tested by InPolygon()
+	uint32 rebuilds;	// Rebuilds of the polygon grid
+};
+
 /*-------------------------------------------------------------------------*/
 
 bool IsInPolygon(int xt, int yt, HPOLYGON p);
 HPOLYGON InPolygon(int xt, int yt, PTYPE type);
+const POLY_QUERY_STATS &GetPolygonQueryStats();
+void ResetPolygonQueryStats();
+void CountPolygonQueryFrame();
 void BlockingCorner(HPOLYGON poly, int *x, int *y, int tarx, int tary);
 void FindBestPoint(HPOLYGON path, int *x, int *y, int *line);
 bool IsAdjacentPath(HPOLYGON path1, HPOLYGON path2);
@@ -64,6 +64,7 @@ Scheduler::Scheduler() {
 	// diagnostic process counters
 	numProcs = 0;
 	maxProcs = 0;
+	createdProcs = 0;
 #endif
 
 	pRCfunction = 0;
@@ -129,10 +130,19 @@ void Scheduler::reset() {
 
 #ifdef	DEBUG
 /**
- * Shows the maximum number of process used at once.
+ * Shows the maximum number of process used at once, and the memory
+ * used for the coroutine contexts of the processes.
  */
 void Scheduler::printStats() {
 	debug("%i process of %i used", maxProcs, NUM_PROCESS);
+	debug("%u processes created, peak %u bytes of process data",
+		createdProcs, (uint32)(maxProcs * sizeof(PROCESS)));
+
+	const CoroAllocStats &stats = getCoroAllocStats();
+	debug("%u coroutine contexts allocated (%u too large for the pools), %u live",
+		stats.allocations, stats.largeAllocations, stats.liveContexts);
+	debug("Coroutine contexts use %u bytes, peak %u bytes",
+		stats.liveBytes, stats.peakBytes);
 }
 #endif
 
@@ -325,6 +335,7 @@ PROCESS *Scheduler::createProcess(int pid, CORO_ADDR coroAddr, const void *pPara
 	// one more process in use
 	if (++numProcs > maxProcs)
 		maxProcs = numProcs;
+	createdProcs++;
 #endif
 
 	// get link to next free process
@@ -82,6 +82,7 @@ private:
 	// diagnostic process counters
 	int numProcs;
 	int maxProcs;
+	uint32 createdProcs;
 
 	void CheckStack();
 #endif
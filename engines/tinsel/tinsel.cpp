@@ -1021,6 +1021,8 @@ void TinselEngine::NextGameCycle() {
 	// Allow a user event for this schedule
 	ResetEcount();
 
+	CountPolygonQueryFrame();
+
 	// schedule process
 	_scheduler->schedule();
 
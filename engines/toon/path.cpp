@@ -56,8 +56,9 @@ int32 PathFindingHeap::unload() {
 int32 PathFindingHeap::clear() {
 	//debugC(1, kDebugPath, "clear()");
 
+	// The entries are always written by push() before they are read again,
+	// so there is no need to clear the whole preallocated heap here
 	_count = 0;
-	memset(_data, 0, sizeof(HeapDataGrid) * _alloc * 2);
 	return 1;
 }
 
@@ -138,6 +139,8 @@ PathFinding::PathFinding(ToonEngine *vm) : _vm(vm) {
 	_heap = new PathFindingHeap();
 	_gridTemp = NULL;
 	_numBlockingRects = 0;
+	_distanceMap = NULL;
+	_distanceMapValid = false;
 }
 
 PathFinding::~PathFinding(void) {
@@ -145,6 +148,7 @@ PathFinding::~PathFinding(void) {
 		_heap->unload();
 	delete _heap;
 	delete[] _gridTemp;
+	delete[] _distanceMap;
 }
 
 bool PathFinding::isLikelyWalkable(int32 x, int32 y) {
@@ -171,6 +175,77 @@ bool PathFinding::isWalkable(int32 x, int32 y) {
 	return maskWalk;
 }
 
+void PathFinding::updateDistanceMap() {
+	if (_distanceMapValid)
+		return;
+
+	debugC(1, kDebugPath, "updateDistanceMap()");
+
+	// This is the exact euclidean distance transform by Meijster et al.
+	// Pixels without any walkable pixel in their column get a distance which
+	// is larger than any real one.
+	const uint32 infinity = _width + _height;
+	uint32 *map = _distanceMap;
+
+	// First pass: vertical distance to the closest walkable pixel
+	for (int32 x = 0; x < _width; x++) {
+		map[x] = isWalkable(x, 0) ? 0 : infinity;
+		for (int32 y = 1; y < _height; y++)
+			map[y * _width + x] = isWalkable(x, y) ? 0 : map[(y - 1) * _width + x] + 1;
+		for (int32 y = _height - 2; y >= 0; y--) {
+			if (map[(y + 1) * _width + x] < map[y * _width + x])
+				map[y * _width + x] = map[(y + 1) * _width + x] + 1;
+		}
+	}
+
+	// Second pass: for every row, the lower envelope of the parabolas
+	// (x - i)^2 + g(i)^2 defined by the vertical distances g of the row
+	int32 *g = new int32[_width];
+	int32 *s = new int32[_width];
+	int32 *t = new int32[_width];
+
+	for (int32 y = 0; y < _height; y++) {
+		uint32 *row = &map[y * _width];
+		for (int32 x = 0; x < _width; x++)
+			g[x] = row[x] * row[x];
+
+		int32 q = 0;
+		s[0] = 0;
+		t[0] = 0;
+		for (int32 u = 1; u < _width; u++) {
+			while (q >= 0 && (t[q] - s[q]) * (t[q] - s[q]) + g[s[q]] > (t[q] - u) * (t[q] - u) + g[u])
+				q--;
+
+			if (q < 0) {
+				q = 0;
+				s[0] = u;
+			} else {
+				// First column where the parabola of u is below the one of s[q]
+				int32 num = u * u - s[q] * s[q] + g[u] - g[s[q]];
+				int32 den = 2 * (u - s[q]);
+				int32 w = 1 + (num >= 0 ? num / den : -((-num + den - 1) / den));
+				if (w < _width) {
+					q++;
+					s[q] = u;
+					t[q] = w;
+				}
+			}
+		}
+
+		for (int32 u = _width - 1; u >= 0; u--) {
+			row[u] = (u - s[q]) * (u - s[q]) + g[s[q]];
+			if (u == t[q])
+				q--;
+		}
+	}
+
+	delete[] g;
+	delete[] s;
+	delete[] t;
+
+	_distanceMapValid = true;
+}
+
 int32 PathFinding::findClosestWalkingPoint(int32 xx, int32 yy, int32 *fxx, int32 *fyy, int origX, int origY) {
 	debugC(1, kDebugPath, "findClosestWalkingPoint(%d, %d, fxx, fyy, %d, %d)", xx, yy, origX, origY);
 
@@ -183,15 +258,60 @@ int32 PathFinding::findClosestWalkingPoint(int32 xx, int32 yy, int32 *fxx, int32
 	if (origY == -1)
 		origY = yy;
 
-	for (int y = 0; y < _height; y++) {
-		for (int x = 0; x < _width; x++) {
-			if (isWalkable(x, y) && isLikelyWalkable(x, y)) {
-				int32 ndist = (x - xx) * (x - xx) + (y - yy) * (y - yy);
-				int32 ndist2 = (x - origX) * (x - origX) + (y - origY) * (y - origY);
-				if (currentFound < 0 || ndist < dist || (ndist == dist && ndist2 < dist2)) {
-					dist = ndist;
-					dist2 = ndist2;
-					currentFound = y * _width + x;
+	updateDistanceMap();
+
+	if (xx >= 0 && xx < _width && yy >= 0 && yy < _height) {
+		// No walkable pixel of the mask is closer than the distance map
+		// tells, so the search starts with the first square ring that can
+		// contain such pixels, and works its way outwards until the rings
+		// are further away than the best candidate found so far. Only the
+		// pixels walkable in the mask need to be checked against the
+		// blocking rects. Ties are broken like in a scan of all pixels.
+		const int32 minDist = _distanceMap[yy * _width + xx];
+		const int32 maxRing = MAX(MAX(xx, _width - 1 - xx), MAX(yy, _height - 1 - yy));
+
+		int32 ring = 0;
+		while (2 * (ring + 1) * (ring + 1) <= minDist)
+			ring++;
+
+		for (; ring <= maxRing && (currentFound < 0 || ring * ring <= dist); ring++) {
+			for (int32 dy = -ring; dy <= ring; dy++) {
+				// Rows inside of the ring only have the two pixels at its sides
+				const int32 step = (dy == -ring || dy == ring) ? 1 : 2 * ring;
+				for (int32 dx = -ring; dx <= ring; dx += step) {
+					int32 x = xx + dx;
+					int32 y = yy + dy;
+					if (x < 0 || x >= _width || y < 0 || y >= _height || _distanceMap[y * _width + x])
+						continue;
+
+					int32 ndist = dx * dx + dy * dy;
+					if (currentFound >= 0 && ndist > dist)
+						continue;
+					if (!isLikelyWalkable(x, y))
+						continue;
+
+					int32 ndist2 = (x - origX) * (x - origX) + (y - origY) * (y - origY);
+					int32 node = y * _width + x;
+					if (currentFound < 0 || ndist < dist || (ndist == dist && (ndist2 < dist2 || (ndist2 == dist2 && node < currentFound)))) {
+						dist = ndist;
+						dist2 = ndist2;
+						currentFound = node;
+					}
+				}
+			}
+		}
+	} else {
+		// Points outside of the mask are rare, so they just check all pixels
+		for (int y = 0; y < _height; y++) {
+			for (int x = 0; x < _width; x++) {
+				if (!_distanceMap[y * _width + x] && isLikelyWalkable(x, y)) {
+					int32 ndist = (x - xx) * (x - xx) + (y - yy) * (y - yy);
+					int32 ndist2 = (x - origX) * (x - origX) + (y - origY) * (y - origY);
+					if (currentFound < 0 || ndist < dist || (ndist == dist && ndist2 < dist2)) {
+						dist = ndist;
+						dist2 = ndist2;
+						currentFound = y * _width + x;
+					}
 				}
 			}
 		}
@@ -413,6 +533,9 @@ void PathFinding::init(Picture *mask) {
 	_heap->init(TOON_BACKBUFFER_WIDTH * _height);	// should really be _width
 	delete[] _gridTemp;
 	_gridTemp = new int32[_width*_height];
+	delete[] _distanceMap;
+	_distanceMap = new uint32[_width * _height];
+	_distanceMapValid = false;
 }
 
 void PathFinding::resetBlockingRects() {
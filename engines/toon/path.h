@@ -64,6 +64,9 @@ public:
 	bool walkLine(int32 x, int32 y, int32 x2, int32 y2);
 	void init(Picture *mask);
 
+	// Must be called whenever the walk mask given to init() was modified
+	void invalidateDistanceMap() { _distanceMapValid = false; }
+
 	void resetBlockingRects();
 	void addBlockingRect(int32 x1, int32 y1, int32 x2, int32 y2);
 	void addBlockingEllipse(int32 x1, int32 y1, int32 w, int32 h);
@@ -72,6 +75,8 @@ public:
 	int32 getPathNodeX(int32 nodeId) const;
 	int32 getPathNodeY(int32 nodeId) const;
 protected:
+	void updateDistanceMap();
+
 	Picture *_currentMask;
 
 	PathFindingHeap *_heap;
@@ -87,6 +92,12 @@ protected:
 	int32 _allocatedGridPathCount;
 	int32 _gridPathCount;
 
+	// Squared distance of every pixel to the closest walkable pixel of the
+	// mask. The blocking rects change all the time, so they are not part of
+	// it but checked by findClosestWalkingPoint() itself.
+	uint32 *_distanceMap;
+	bool _distanceMapValid;
+
 	ToonEngine *_vm;
 };
 
@@ -3223,6 +3223,7 @@ bool ToonEngine::loadGame(int32 slot) {
 				int16 x = rStr.readSint16BE();
 				int16 y = rStr.readSint16BE();
 				getMask()->floodFillNotWalkableOnMask(x, y);
+				_pathFinding->invalidateDistanceMap();
 				break;
 			}
 			default:
@@ -4664,10 +4665,12 @@ void ToonEngine::unloadTextsVariants(char **texts) {
 
 void ToonEngine::makeLineNonWalkable(int32 x, int32 y, int32 x2, int32 y2) {
 	_currentMask->drawLineOnMask(x, y, x2, y2, false);
+	_pathFinding->invalidateDistanceMap();
 }
 
 void ToonEngine::makeLineWalkable(int32 x, int32 y, int32 x2, int32 y2) {
 	_currentMask->drawLineOnMask(x, y, x2, y2, true);
+	_pathFinding->invalidateDistanceMap();
 }
 
 void ToonEngine::playRoomMusic() {
@@ -60,22 +60,11 @@ uint32 hqx_green_redBlue_Mask = 0;
  * 16bit RGB to YUV conversion table. This table is setup by InitLUT().
  * Used by the hq scaler family.
  *
- * FIXME/TODO: The RGBtoYUV table sucks up 256 KB. This is bad.
- * In addition we never free it...
- *
- * Note: a memory lookup table is *not* necessarily faster than computing
- * these things on the fly, because of its size. The table together with
- * the code, plus the input/output GFX data, may not fit in the cache on some
- * systems, so main memory has to be accessed, which is about the worst thing
- * that can happen to code which tries to be fast...
- *
- * So we should think about ways to get this smaller / removed. Maybe we can
- * use the same technique employed by our MPEG code to reduce the size of the
- * lookup table at the cost of some additional computations?
- *
- * Of course, the above is largely a conjecture, and the actual speed
- * differences are likely to vary a lot between different architectures and
- * CPUs.
+ * The table sucks up 256 KB, and together with the code, plus the
+ * input/output GFX data, it may not fit in the cache on some systems.
+ * Hence the hq scalers compute the YUV values on the fly instead (see
+ * convertToYUV() and computeHQPatterns()), and the table is only allocated
+ * when it is still needed, see initHQScalerYUV(). Otherwise it is 0.
  */
 uint32 *RGBtoYUV = 0;
 }
@@ -113,6 +102,26 @@ void InitLUT(Graphics::PixelFormat format) {
 	hqx_green_redBlue_Mask = (hqx_greenMask << 16) | hqx_redBlueMask;
 #endif
 }
+
+/**
+ * Set up the RGBtoYUV table if the hq scalers need it for the given pixel
+ * format, and free it otherwise.
+ */
+static void initHQScalerYUV(Graphics::PixelFormat format) {
+#ifdef USE_NASM
+	// The assembly scalers always use the table
+	const bool needLUT = true;
+#else
+	const bool needLUT = (gBitFormat != 565 && gBitFormat != 555);
+#endif
+
+	if (needLUT) {
+		InitLUT(format);
+	} else {
+		free(RGBtoYUV);
+		RGBtoYUV = 0;
+	}
+}
 #endif
 
 
@@ -137,7 +146,7 @@ void InitScalers(uint32 BitFormat) {
 	}
 
 #ifdef USE_HQ_SCALERS
-	InitLUT(format);
+	initHQScalerYUV(format);
 #endif
 
 	// Build dotmatrix lookup table for the DotMatrix scaler.
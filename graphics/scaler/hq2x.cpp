@@ -21,6 +21,7 @@
  */
 
 #include "graphics/scaler/intern.h"
+#include "common/util.h"
 
 #ifdef USE_NASM
 // Assembly version of HQ2x
@@ -94,14 +95,14 @@ void HQ2x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
 #define PIXEL11_100	*(q+1+nextlineDst) = interpolate16_14_1_1<ColorMask >(w5, w6, w8);
 
 extern "C" uint32   *RGBtoYUV;
-#define YUV(x)	RGBtoYUV[w ## x]
+#define YUV(x)	(useLUT ? (int)RGBtoYUV[w ## x] : convertToYUV<ColorMask>(w ## x))
 
 /*
  * The HQ2x high quality 2x graphics filter.
  * Original author Maxim Stepin (see http://www.hiend3d.com/hq2x.html).
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
-template<typename ColorMask>
+template<typename ColorMask, bool useLUT>
 static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	register int w1, w2, w3, w4, w5, w6, w7, w8, w9;
 
@@ -131,24 +132,27 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w5 = *(p);
 		w8 = *(p + nextlineSrc);
 
+		uint8 patterns[kHQPatternChunk];
+		int patternIndex = kHQPatternChunk;
+
 		int tmpWidth = width;
 		while (tmpWidth--) {
+			if (patternIndex == kHQPatternChunk) {
+				const int chunk = MIN<int>(tmpWidth + 1, kHQPatternChunk);
+				if (useLUT)
+					computeHQPatternsLUT(p, nextlineSrc, chunk, patterns);
+				else
+					computeHQPatterns<ColorMask>(p, nextlineSrc, chunk, patterns);
+				patternIndex = 0;
+			}
+
 			p++;
 
 			w3 = *(p - nextlineSrc);
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = patterns[patternIndex++];
 
 			switch (pattern) {
 			case 0:
@@ -1959,10 +1963,18 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 
 void HQ2x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	extern int gBitFormat;
-	if (gBitFormat == 565)
-		HQ2x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
-	else
-		HQ2x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	// The RGBtoYUV table is only set up if it is supposed to be used
+	if (RGBtoYUV) {
+		if (gBitFormat == 565)
+			HQ2x_implementation<Graphics::ColorMasks<565>, true>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+		else
+			HQ2x_implementation<Graphics::ColorMasks<555>, true>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	} else {
+		if (gBitFormat == 565)
+			HQ2x_implementation<Graphics::ColorMasks<565>, false>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+		else
+			HQ2x_implementation<Graphics::ColorMasks<555>, false>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	}
 }
 
 #endif // Assembly version
@@ -21,6 +21,7 @@
  */
 
 #include "graphics/scaler/intern.h"
+#include "common/util.h"
 
 #ifdef USE_NASM
 // Assembly version of HQ3x
@@ -97,14 +98,14 @@ void HQ3x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
 #define PIXEL22_C   *(q+2+nextlineDst2) = w5;
 
 extern "C" uint32   *RGBtoYUV;
-#define YUV(x)	RGBtoYUV[w ## x]
+#define YUV(x)	(useLUT ? (int)RGBtoYUV[w ## x] : convertToYUV<ColorMask>(w ## x))
 
 /*
  * The HQ3x high quality 3x graphics filter.
  * Original author Maxim Stepin (see http://www.hiend3d.com/hq3x.html).
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
-template<typename ColorMask>
+template<typename ColorMask, bool useLUT>
 static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	register int  w1, w2, w3, w4, w5, w6, w7, w8, w9;
 
@@ -135,24 +136,27 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w5 = *(p);
 		w8 = *(p + nextlineSrc);
 
+		uint8 patterns[kHQPatternChunk];
+		int patternIndex = kHQPatternChunk;
+
 		int tmpWidth = width;
 		while (tmpWidth--) {
+			if (patternIndex == kHQPatternChunk) {
+				const int chunk = MIN<int>(tmpWidth + 1, kHQPatternChunk);
+				if (useLUT)
+					computeHQPatternsLUT(p, nextlineSrc, chunk, patterns);
+				else
+					computeHQPatterns<ColorMask>(p, nextlineSrc, chunk, patterns);
+				patternIndex = 0;
+			}
+
 			p++;
 
 			w3 = *(p - nextlineSrc);
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = patterns[patternIndex++];
 
 			switch (pattern) {
 			case 0:
@@ -2936,10 +2940,18 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 
 void HQ3x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	extern int gBitFormat;
-	if (gBitFormat == 565)
-		HQ3x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
-	else
-		HQ3x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	// The RGBtoYUV table is only set up if it is supposed to be used
+	if (RGBtoYUV) {
+		if (gBitFormat == 565)
+			HQ3x_implementation<Graphics::ColorMasks<565>, true>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+		else
+			HQ3x_implementation<Graphics::ColorMasks<555>, true>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	} else {
+		if (gBitFormat == 565)
+			HQ3x_implementation<Graphics::ColorMasks<565>, false>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+		else
+			HQ3x_implementation<Graphics::ColorMasks<555>, false>(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	}
 }
 
 #endif // Assembly version
@@ -0,0 +1,207 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/scaler/intern.h"
+#include "common/cpudetect.h"
+
+#ifdef SCUMMVM_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef SCUMMVM_NEON
+#include <arm_neon.h>
+#endif
+
+extern "C" uint32 *RGBtoYUV;
+
+// Note: diffYUV() is false for equal colors, so the scalar functions below
+// skip the YUV lookup for neighbours which are equal to the center pixel.
+// That is the common case in most game graphics.
+
+void computeHQPatternsLUT(const uint16 *p, uint32 nextline, int width, uint8 *patterns) {
+	for (int i = 0; i < width; ++i, ++p) {
+		const uint16 w5 = *p;
+		const int yuv5 = RGBtoYUV[w5];
+		int pattern = 0;
+		uint16 w;
+		w = *(p - 1 - nextline); if (w != w5 && diffYUV(yuv5, RGBtoYUV[w])) pattern |= 0x0001;
+		w = *(p - nextline);     if (w != w5 && diffYUV(yuv5, RGBtoYUV[w])) pattern |= 0x0002;
+		w = *(p + 1 - nextline); if (w != w5 && diffYUV(yuv5, RGBtoYUV[w])) pattern |= 0x0004;
+		w = *(p - 1);            if (w != w5 && diffYUV(yuv5, RGBtoYUV[w])) pattern |= 0x0008;
+		w = *(p + 1);            if (w != w5 && diffYUV(yuv5, RGBtoYUV[w])) pattern |= 0x0010;
+		w = *(p - 1 + nextline); if (w != w5 && diffYUV(yuv5, RGBtoYUV[w])) pattern |= 0x0020;
+		w = *(p + nextline);     if (w != w5 && diffYUV(yuv5, RGBtoYUV[w])) pattern |= 0x0040;
+		w = *(p + 1 + nextline); if (w != w5 && diffYUV(yuv5, RGBtoYUV[w])) pattern |= 0x0080;
+		patterns[i] = pattern;
+	}
+}
+
+template<typename ColorMask>
+static void computeHQPatternsScalar(const uint16 *p, uint32 nextline, int width, uint8 *patterns) {
+	for (int i = 0; i < width; ++i, ++p) {
+		const uint16 w5 = *p;
+		const int yuv5 = convertToYUV<ColorMask>(w5);
+		int pattern = 0;
+		uint16 w;
+		w = *(p - 1 - nextline); if (w != w5 && diffYUV(yuv5, convertToYUV<ColorMask>(w))) pattern |= 0x0001;
+		w = *(p - nextline);     if (w != w5 && diffYUV(yuv5, convertToYUV<ColorMask>(w))) pattern |= 0x0002;
+		w = *(p + 1 - nextline); if (w != w5 && diffYUV(yuv5, convertToYUV<ColorMask>(w))) pattern |= 0x0004;
+		w = *(p - 1);            if (w != w5 && diffYUV(yuv5, convertToYUV<ColorMask>(w))) pattern |= 0x0008;
+		w = *(p + 1);            if (w != w5 && diffYUV(yuv5, convertToYUV<ColorMask>(w))) pattern |= 0x0010;
+		w = *(p - 1 + nextline); if (w != w5 && diffYUV(yuv5, convertToYUV<ColorMask>(w))) pattern |= 0x0020;
+		w = *(p + nextline);     if (w != w5 && diffYUV(yuv5, convertToYUV<ColorMask>(w))) pattern |= 0x0040;
+		w = *(p + 1 + nextline); if (w != w5 && diffYUV(yuv5, convertToYUV<ColorMask>(w))) pattern |= 0x0080;
+		patterns[i] = pattern;
+	}
+}
+
+// The SIMD versions below work on eight pixels at once. They keep Y, U and V
+// in separate 16 bit lanes, where U and V are stored without the offset of
+// 128, which cancels out in the differences anyway. The thresholds are the
+// ones of diffYUV(): 48 for Y, 7 for U and 6 for V.
+
+#ifdef SCUMMVM_SSE2
+
+struct YUV8SSE2 {
+	__m128i y, u, v;
+};
+
+template<typename ColorMask>
+static inline YUV8SSE2 convertToYUV8SSE2(const uint16 *p) {
+	const __m128i c = _mm_loadu_si128((const __m128i *)p);
+	const __m128i r = _mm_slli_epi16(_mm_srli_epi16(_mm_and_si128(c, _mm_set1_epi16((int16)ColorMask::kRedMask)), ColorMask::kRedShift), 8 - ColorMask::kRedBits);
+	const __m128i g = _mm_slli_epi16(_mm_srli_epi16(_mm_and_si128(c, _mm_set1_epi16((int16)ColorMask::kGreenMask)), ColorMask::kGreenShift), 8 - ColorMask::kGreenBits);
+	const __m128i b = _mm_slli_epi16(_mm_srli_epi16(_mm_and_si128(c, _mm_set1_epi16((int16)ColorMask::kBlueMask)), ColorMask::kBlueShift), 8 - ColorMask::kBlueBits);
+
+	YUV8SSE2 yuv;
+	yuv.y = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(r, g), b), 2);
+	yuv.u = _mm_srai_epi16(_mm_sub_epi16(r, b), 2);
+	yuv.v = _mm_srai_epi16(_mm_sub_epi16(_mm_sub_epi16(_mm_add_epi16(g, g), r), b), 3);
+	return yuv;
+}
+
+static inline __m128i absDiffExceedsSSE2(__m128i a, __m128i b, __m128i threshold) {
+	const __m128i diff = _mm_sub_epi16(a, b);
+	return _mm_or_si128(_mm_cmpgt_epi16(diff, threshold), _mm_cmplt_epi16(diff, _mm_sub_epi16(_mm_setzero_si128(), threshold)));
+}
+
+static inline __m128i diffYUV8SSE2(const YUV8SSE2 &yuv1, const YUV8SSE2 &yuv2, int bit) {
+	const __m128i mask = _mm_or_si128(absDiffExceedsSSE2(yuv1.y, yuv2.y, _mm_set1_epi16(48)),
+	                     _mm_or_si128(absDiffExceedsSSE2(yuv1.u, yuv2.u, _mm_set1_epi16(7)),
+	                                  absDiffExceedsSSE2(yuv1.v, yuv2.v, _mm_set1_epi16(6))));
+	return _mm_and_si128(mask, _mm_set1_epi16(bit));
+}
+
+template<typename ColorMask>
+static int computeHQPatternsSSE2(const uint16 *p, uint32 nextline, int width, uint8 *patterns) {
+	int i = 0;
+	for (; i + 8 <= width; i += 8, p += 8) {
+		const YUV8SSE2 yuv5 = convertToYUV8SSE2<ColorMask>(p);
+
+		__m128i pattern = diffYUV8SSE2(yuv5, convertToYUV8SSE2<ColorMask>(p - 1 - nextline), 0x0001);
+		pattern = _mm_or_si128(pattern, diffYUV8SSE2(yuv5, convertToYUV8SSE2<ColorMask>(p - nextline), 0x0002));
+		pattern = _mm_or_si128(pattern, diffYUV8SSE2(yuv5, convertToYUV8SSE2<ColorMask>(p + 1 - nextline), 0x0004));
+		pattern = _mm_or_si128(pattern, diffYUV8SSE2(yuv5, convertToYUV8SSE2<ColorMask>(p - 1), 0x0008));
+		pattern = _mm_or_si128(pattern, diffYUV8SSE2(yuv5, convertToYUV8SSE2<ColorMask>(p + 1), 0x0010));
+		pattern = _mm_or_si128(pattern, diffYUV8SSE2(yuv5, convertToYUV8SSE2<ColorMask>(p - 1 + nextline), 0x0020));
+		pattern = _mm_or_si128(pattern, diffYUV8SSE2(yuv5, convertToYUV8SSE2<ColorMask>(p + nextline), 0x0040));
+		pattern = _mm_or_si128(pattern, diffYUV8SSE2(yuv5, convertToYUV8SSE2<ColorMask>(p + 1 + nextline), 0x0080));
+
+		_mm_storel_epi64((__m128i *)(patterns + i), _mm_packus_epi16(pattern, pattern));
+	}
+	return i;
+}
+
+#endif
+
+#ifdef SCUMMVM_NEON
+
+struct YUV8NEON {
+	int16x8_t y, u, v;
+};
+
+// Extract a color component and scale it to 8 bits. The shift is done with
+// vshlq_u16(), since vshrq_n_u16() does not allow shifting by 0.
+static inline int16x8_t extractComponentNEON(uint16x8_t c, uint16 mask, int shift, int bits) {
+	return vreinterpretq_s16_u16(vshlq_u16(vandq_u16(c, vdupq_n_u16(mask)), vdupq_n_s16(8 - bits - shift)));
+}
+
+template<typename ColorMask>
+static inline YUV8NEON convertToYUV8NEON(const uint16 *p) {
+	const uint16x8_t c = vld1q_u16(p);
+	const int16x8_t r = extractComponentNEON(c, ColorMask::kRedMask, ColorMask::kRedShift, ColorMask::kRedBits);
+	const int16x8_t g = extractComponentNEON(c, ColorMask::kGreenMask, ColorMask::kGreenShift, ColorMask::kGreenBits);
+	const int16x8_t b = extractComponentNEON(c, ColorMask::kBlueMask, ColorMask::kBlueShift, ColorMask::kBlueBits);
+
+	YUV8NEON yuv;
+	yuv.y = vshrq_n_s16(vaddq_s16(vaddq_s16(r, g), b), 2);
+	yuv.u = vshrq_n_s16(vsubq_s16(r, b), 2);
+	yuv.v = vshrq_n_s16(vsubq_s16(vsubq_s16(vaddq_s16(g, g), r), b), 3);
+	return yuv;
+}
+
+static inline uint16x8_t diffYUV8NEON(const YUV8NEON &yuv1, const YUV8NEON &yuv2, uint16 bit) {
+	const uint16x8_t mask = vorrq_u16(vcgtq_s16(vabdq_s16(yuv1.y, yuv2.y), vdupq_n_s16(48)),
+	                        vorrq_u16(vcgtq_s16(vabdq_s16(yuv1.u, yuv2.u), vdupq_n_s16(7)),
+	                                  vcgtq_s16(vabdq_s16(yuv1.v, yuv2.v), vdupq_n_s16(6))));
+	return vandq_u16(mask, vdupq_n_u16(bit));
+}
+
+template<typename ColorMask>
+static int computeHQPatternsNEON(const uint16 *p, uint32 nextline, int width, uint8 *patterns) {
+	int i = 0;
+	for (; i + 8 <= width; i += 8, p += 8) {
+		const YUV8NEON yuv5 = convertToYUV8NEON<ColorMask>(p);
+
+		uint16x8_t pattern = diffYUV8NEON(yuv5, convertToYUV8NEON<ColorMask>(p - 1 - nextline), 0x0001);
+		pattern = vorrq_u16(pattern, diffYUV8NEON(yuv5, convertToYUV8NEON<ColorMask>(p - nextline), 0x0002));
+		pattern = vorrq_u16(pattern, diffYUV8NEON(yuv5, convertToYUV8NEON<ColorMask>(p + 1 - nextline), 0x0004));
+		pattern = vorrq_u16(pattern, diffYUV8NEON(yuv5, convertToYUV8NEON<ColorMask>(p - 1), 0x0008));
+		pattern = vorrq_u16(pattern, diffYUV8NEON(yuv5, convertToYUV8NEON<ColorMask>(p + 1), 0x0010));
+		pattern = vorrq_u16(pattern, diffYUV8NEON(yuv5, convertToYUV8NEON<ColorMask>(p - 1 + nextline), 0x0020));
+		pattern = vorrq_u16(pattern, diffYUV8NEON(yuv5, convertToYUV8NEON<ColorMask>(p + nextline), 0x0040));
+		pattern = vorrq_u16(pattern, diffYUV8NEON(yuv5, convertToYUV8NEON<ColorMask>(p + 1 + nextline), 0x0080));
+
+		vst1_u8(patterns + i, vmovn_u16(pattern));
+	}
+	return i;
+}
+
+#endif
+
+template<typename ColorMask>
+void computeHQPatterns(const uint16 *p, uint32 nextline, int width, uint8 *patterns) {
+	int done = 0;
+
+#if defined(SCUMMVM_SSE2)
+	if (Common::hasCPUFeature(Common::kCPUFeatureSSE2))
+		done = computeHQPatternsSSE2<ColorMask>(p, nextline, width, patterns);
+#elif defined(SCUMMVM_NEON)
+	if (Common::hasCPUFeature(Common::kCPUFeatureNEON))
+		done = computeHQPatternsNEON<ColorMask>(p, nextline, width, patterns);
+#endif
+
+	// The remaining pixels
+	computeHQPatternsScalar<ColorMask>(p + done, nextline, width - done, patterns + done);
+}
+
+template void computeHQPatterns<Graphics::ColorMasks<565> >(const uint16 *p, uint32 nextline, int width, uint8 *patterns);
+template void computeHQPatterns<Graphics::ColorMasks<555> >(const uint16 *p, uint32 nextline, int width, uint8 *patterns);
@@ -218,4 +218,50 @@ static inline bool diffYUV(int yuv1, int yuv2) {
 */
 }
 
+/**
+ * Convert a 16 bit pixel to the YUV value (encoded 8-8-8) used by diffYUV().
+ * This computes exactly what InitLUT() stores in the RGBtoYUV table, and is
+ * used by the hq scaler family instead of the table when possible.
+ */
+template<typename ColorMask>
+static inline int convertToYUV(int color) {
+	const int r = ((color & ColorMask::kRedMask) >> ColorMask::kRedShift) << (8 - ColorMask::kRedBits);
+	const int g = ((color & ColorMask::kGreenMask) >> ColorMask::kGreenShift) << (8 - ColorMask::kGreenBits);
+	const int b = ((color & ColorMask::kBlueMask) >> ColorMask::kBlueShift) << (8 - ColorMask::kBlueBits);
+
+	const int Y = (r + g + b) >> 2;
+	const int u = 128 + ((r - b) >> 2);
+	const int v = 128 + ((-r + 2 * g - b) >> 3);
+	return (Y << 16) | (u << 8) | v;
+}
+
+#ifdef USE_HQ_SCALERS
+
+/**
+ * Maximal number of pixels the hq scalers pass to the pattern functions
+ * below at once.
+ */
+enum {
+	kHQPatternChunk = 64
+};
+
+/**
+ * Compute the neighbour patterns of the hq scaler family for width pixels
+ * starting at p. Bit n of patterns[i] is set if the n-th neighbour of p[i]
+ * (in the order w1, w2, w3, w4, w6, w7, w8, w9) differs from it according
+ * to diffYUV().
+ *
+ * This version computes the YUV values arithmetically, using SSE2 or NEON
+ * where available.
+ */
+template<typename ColorMask>
+void computeHQPatterns(const uint16 *p, uint32 nextline, int width, uint8 *patterns);
+
+/**
+ * Same as computeHQPatterns(), but uses the RGBtoYUV lookup table.
+ */
+void computeHQPatternsLUT(const uint16 *p, uint32 nextline, int width, uint8 *patterns);
+
+#endif
+
 #endif
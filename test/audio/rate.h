@@ -0,0 +1,166 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/rate.h"
+#include "audio/rate_kernels.h"
+#include "audio/decoders/raw.h"
+
+#include "common/endian.h"
+#include "common/stream.h"
+
+class RateTestSuite : public CxxTest::TestSuite
+{
+private:
+	static void fillSamples(int16 *buffer, int len, uint32 seed) {
+		for (int i = 0; i < len; ++i) {
+			seed = seed * 1103515245 + 12345;
+			buffer[i] = (int16)(seed >> 16);
+		}
+
+		// Make sure the extreme values are covered
+		if (len > 1) {
+			buffer[0] = -32768;
+			buffer[1] = 32767;
+		}
+	}
+
+	void compareKernelTemplate(const Audio::MixKernels &kernels, bool stereo, int frames, Audio::st_volume_t vol_l, Audio::st_volume_t vol_r) {
+		const int inLen = frames * (stereo ? 2 : 1);
+		int16 *in = new int16[inLen + 1];
+		int16 *expected = new int16[frames * 2 + 1];
+		int16 *result = new int16[frames * 2 + 1];
+
+		fillSamples(in, inLen, frames);
+		fillSamples(expected, frames * 2, frames + 1);
+		memcpy(result, expected, frames * 2 * sizeof(int16));
+
+		const Audio::MixKernels &scalar = *Audio::getMixKernels(Audio::kMixKernelScalar);
+		if (stereo) {
+			scalar.mixStereo(expected, in, frames, vol_l, vol_r);
+			kernels.mixStereo(result, in, frames, vol_l, vol_r);
+		} else {
+			scalar.mixMono(expected, in, frames, vol_l, vol_r);
+			kernels.mixMono(result, in, frames, vol_l, vol_r);
+		}
+
+		TS_ASSERT_EQUALS(memcmp(expected, result, frames * 2 * sizeof(int16)), 0);
+
+		delete[] in;
+		delete[] expected;
+		delete[] result;
+	}
+
+	void compareKernels(Audio::MixKernelType type) {
+		const Audio::MixKernels *kernels = Audio::getMixKernels(type);
+		if (!kernels)
+			return;
+
+		static const Audio::st_volume_t volumes[] = { 0, 1, 127, 255, 256 };
+		for (int frames = 0; frames < 40; ++frames) {
+			for (int v = 0; v < ARRAYSIZE(volumes); ++v) {
+				compareKernelTemplate(*kernels, true, frames, volumes[v], volumes[ARRAYSIZE(volumes) - 1 - v]);
+				compareKernelTemplate(*kernels, false, frames, volumes[v], volumes[ARRAYSIZE(volumes) - 1 - v]);
+			}
+		}
+
+		compareKernelTemplate(*kernels, true, 44100, 256, 200);
+		compareKernelTemplate(*kernels, false, 44100, 200, 256);
+	}
+
+	void compareDotProduct(Audio::MixKernelType type) {
+		const Audio::MixKernels *kernels = Audio::getMixKernels(type);
+		if (!kernels)
+			return;
+
+		int16 a[128], b[128];
+		fillSamples(a, ARRAYSIZE(a), 1);
+		fillSamples(b, ARRAYSIZE(b), 2);
+		// Keep the coefficients in the range used by the resamplers
+		for (int i = 0; i < ARRAYSIZE(b); ++i)
+			b[i] >>= 2;
+
+		const Audio::MixKernels &scalar = *Audio::getMixKernels(Audio::kMixKernelScalar);
+		for (uint len = 8; len <= ARRAYSIZE(a) / 4; len += 8)
+			TS_ASSERT_EQUALS(kernels->dotProduct(a, b, len), scalar.dotProduct(a, b, len));
+	}
+
+	void sincConstantTemplate(int inRate, int outRate, bool stereo, Audio::RateConverterQuality quality) {
+		const int inFrames = inRate / 10;
+		const int inLen = inFrames * (stereo ? 2 : 1);
+		byte *data = (byte *)malloc(inLen * 2);
+		for (int i = 0; i < inLen; ++i)
+			WRITE_LE_UINT16(data + i * 2, 10000);
+
+		Audio::AudioStream *stream = Audio::makeRawStream(data, inLen * 2, inRate,
+		        Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | (stereo ? Audio::FLAG_STEREO : 0));
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, stereo, false, quality);
+
+		const int outFrames = outRate / 20;
+		int16 *out = new int16[outFrames * 2];
+		memset(out, 0, outFrames * 2 * sizeof(int16));
+		TS_ASSERT_EQUALS(converter->flow(*stream, out, outFrames, 256, 256), outFrames);
+
+		// Skip the fade in of the filter
+		for (int i = outFrames / 2; i < outFrames * 2; ++i)
+			TS_ASSERT_EQUALS(out[i], 10000);
+
+		delete[] out;
+		delete converter;
+		delete stream;
+	}
+
+public:
+	void test_kernel_scalar_available() {
+		TS_ASSERT(Audio::getMixKernels(Audio::kMixKernelScalar) != 0);
+	}
+
+	void test_kernel_sse2() {
+		compareKernels(Audio::kMixKernelSSE2);
+	}
+
+	void test_kernel_avx2() {
+		compareKernels(Audio::kMixKernelAVX2);
+	}
+
+	void test_kernel_neon() {
+		compareKernels(Audio::kMixKernelNEON);
+	}
+
+	void test_dot_product() {
+		compareDotProduct(Audio::kMixKernelSSE2);
+		compareDotProduct(Audio::kMixKernelAVX2);
+		compareDotProduct(Audio::kMixKernelNEON);
+	}
+
+	void test_sinc_constant_upsample() {
+		sincConstantTemplate(11025, 44100, false, Audio::kRateQualityLow);
+		sincConstantTemplate(11025, 48000, true, Audio::kRateQualityMedium);
+		sincConstantTemplate(22254, 44100, false, Audio::kRateQualityHigh);
+	}
+
+	void test_sinc_constant_downsample() {
+		sincConstantTemplate(44100, 22050, true, Audio::kRateQualityHigh);
+		sincConstantTemplate(48000, 44100, false, Audio::kRateQualityMedium);
+	}
+
+	void test_copy_reverse_stereo() {
+		static const int16 samples[] = { 100, -200, 300, -400, 500, -600 };
+		byte *data = (byte *)malloc(sizeof(samples));
+		for (int i = 0; i < ARRAYSIZE(samples); ++i)
+			WRITE_LE_UINT16(data + i * 2, samples[i]);
+
+		Audio::AudioStream *stream = Audio::makeRawStream(data, sizeof(samples), 22050,
+		        Audio::FLAG_16BITS | Audio::FLAG_STEREO | Audio::FLAG_LITTLE_ENDIAN);
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 22050, true, true);
+
+		int16 out[6] = { 0, 0, 0, 0, 0, 0 };
+		TS_ASSERT_EQUALS(converter->flow(*stream, out, 3, 256, 128), 3);
+
+		for (int i = 0; i < 3; ++i) {
+			TS_ASSERT_EQUALS(out[2 * i], samples[2 * i + 1] / 2);
+			TS_ASSERT_EQUALS(out[2 * i + 1], samples[2 * i]);
+		}
+
+		delete converter;
+		delete stream;
+	}
+};
@@ -1,5 +1,6 @@
 #include <cxxtest/TestSuite.h>
 
+#include "common/array.h"
 #include "common/rect.h"
 
 class RectTestSuite : public CxxTest::TestSuite
@@ -59,4 +60,31 @@ class RectTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(r2.right,  2);
 	}
 
+	void test_addDirtyRect() {
+		const Common::Rect clip(0, 0, 100, 100);
+		Common::Array<Common::Rect> rects;
+
+		// Clipped, and empty rects are dropped
+		Common::addDirtyRect(rects, Common::Rect(90, 90, 110, 110), clip);
+		Common::addDirtyRect(rects, Common::Rect(200, 200, 210, 210), clip);
+		TS_ASSERT_EQUALS(rects.size(), 1U);
+		TS_ASSERT(rects[0] == Common::Rect(90, 90, 100, 100));
+
+		// Separate rects stay apart
+		Common::addDirtyRect(rects, Common::Rect(0, 0, 10, 10), clip);
+		TS_ASSERT_EQUALS(rects.size(), 2U);
+
+		// A rect overlapping both merges them, including the new overlap
+		Common::addDirtyRect(rects, Common::Rect(5, 5, 95, 95), clip);
+		TS_ASSERT_EQUALS(rects.size(), 1U);
+		TS_ASSERT(rects[0] == Common::Rect(0, 0, 100, 100));
+
+		// Too many rects are merged into their bounding rect
+		rects.clear();
+		for (int i = 0; i <= Common::kMaxDirtyRects; ++i)
+			Common::addDirtyRect(rects, Common::Rect(i * 4, 0, i * 4 + 2, 2), clip);
+		TS_ASSERT_EQUALS(rects.size(), 1U);
+		TS_ASSERT(rects[0] == Common::Rect(0, 0, Common::kMaxDirtyRects * 4 + 2, 2));
+	}
+
 };
@@ -0,0 +1,163 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/unzip.h"
+
+#include <string.h>
+
+// A ZIP file with the stored (uncompressed) files "hello.txt", containing
+// "Hello, world!", and "dir/Data.bin", containing the bytes 0 to 31.
+static const byte zipTestData[] = {
+	0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x15, 0x51, 0x5d, 0xe6, 0xc6,
+	0xe6, 0xeb, 0x0d, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x68, 0x65,
+	0x6c, 0x6c, 0x6f, 0x2e, 0x74, 0x78, 0x74, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x77, 0x6f,
+	0x72, 0x6c, 0x64, 0x21, 0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x15,
+	0x51, 0x5d, 0x8a, 0x7e, 0x26, 0x91, 0x20, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x0c, 0x00,
+	0x00, 0x00, 0x64, 0x69, 0x72, 0x2f, 0x44, 0x61, 0x74, 0x61, 0x2e, 0x62, 0x69, 0x6e, 0x00, 0x01,
+	0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11,
+	0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x50, 0x4b,
+	0x01, 0x02, 0x14, 0x03, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0x15, 0x51, 0x5d, 0xe6, 0xc6,
+	0xe6, 0xeb, 0x0d, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x68, 0x65, 0x6c, 0x6c,
+	0x6f, 0x2e, 0x74, 0x78, 0x74, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x03, 0x14, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x61, 0x15, 0x51, 0x5d, 0x8a, 0x7e, 0x26, 0x91, 0x20, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00,
+	0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x34,
+	0x00, 0x00, 0x00, 0x64, 0x69, 0x72, 0x2f, 0x44, 0x61, 0x74, 0x61, 0x2e, 0x62, 0x69, 0x6e, 0x50,
+	0x4b, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00, 0x71, 0x00, 0x00, 0x00, 0x7e,
+	0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+class ZipArchiveTestSuite : public CxxTest::TestSuite {
+	Common::Archive *openTestArchive() {
+		return Common::makeZipArchive(new Common::MemoryReadStream(zipTestData, sizeof(zipTestData)));
+	}
+
+	// Offset of the name "hello.txt" in the central directory of zipTestData
+	enum {
+		kCentralDirHelloName = 172
+	};
+
+	// Open a copy of zipTestData, with the "hello.txt" central directory
+	// entry renamed to "hallo.txt", and a zipfile comment of commentLength
+	// bytes appended. The name only shows up if the central directory is
+	// actually read, instead of taking the index from the cache.
+	Common::Archive *openModifiedArchive(const Common::String &indexKey, uint commentLength) {
+		const uint size = sizeof(zipTestData) + commentLength;
+		byte *data = (byte *)malloc(size);
+		memcpy(data, zipTestData, sizeof(zipTestData));
+		memset(data + sizeof(zipTestData), 'x', commentLength);
+
+		data[kCentralDirHelloName + 1] = 'a';
+		data[sizeof(zipTestData) - 2] = commentLength & 0xFF;
+		data[sizeof(zipTestData) - 1] = commentLength >> 8;
+
+		return Common::makeZipArchive(new Common::MemoryReadStream(data, size, DisposeAfterUse::YES), indexKey);
+	}
+
+	public:
+	void test_list_members() {
+		Common::Archive *archive = openTestArchive();
+		TS_ASSERT(archive);
+
+		Common::ArchiveMemberList list;
+		TS_ASSERT_EQUALS(archive->listMembers(list), 2);
+		TS_ASSERT(archive->hasFile("hello.txt"));
+		TS_ASSERT(archive->hasFile("DIR/DATA.BIN"));
+		TS_ASSERT(!archive->hasFile("missing.txt"));
+
+		delete archive;
+	}
+
+	void test_stored_member() {
+		Common::Archive *archive = openTestArchive();
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("hello.txt");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 13);
+
+		char buffer[14];
+		TS_ASSERT_EQUALS(stream->read(buffer, 13), 13u);
+		buffer[13] = 0;
+		TS_ASSERT_EQUALS(Common::String(buffer), "Hello, world!");
+
+		stream->readByte();
+		TS_ASSERT(stream->eos());
+
+		stream->seek(7, SEEK_SET);
+		TS_ASSERT_EQUALS(stream->readByte(), 'w');
+
+		delete stream;
+		delete archive;
+	}
+
+	void test_interleaved_members() {
+		Common::Archive *archive = openTestArchive();
+		Common::SeekableReadStream *hello = archive->createReadStreamForMember("hello.txt");
+		Common::SeekableReadStream *data = archive->createReadStreamForMember("dir/Data.bin");
+		TS_ASSERT(hello && data);
+		TS_ASSERT_EQUALS(data->size(), 32);
+
+		for (int i = 0; i < 13; i++) {
+			TS_ASSERT_EQUALS(data->readByte(), i);
+			TS_ASSERT_EQUALS(hello->readByte(), (byte)"Hello, world!"[i]);
+		}
+
+		delete hello;
+		delete data;
+		delete archive;
+	}
+
+	void test_index_cache_hit() {
+		Common::Archive *archive = Common::makeZipArchive(new Common::MemoryReadStream(zipTestData, sizeof(zipTestData)), "cache_hit.zip");
+		TS_ASSERT(archive);
+		delete archive;
+
+		// The end of central directory record is the same, so the cached
+		// index is used, which still has the original name
+		archive = openModifiedArchive("cache_hit.zip", 0);
+		TS_ASSERT(archive);
+		TS_ASSERT(archive->hasFile("hello.txt"));
+		TS_ASSERT(!archive->hasFile("hallo.txt"));
+		TS_ASSERT(archive->hasFile("dir/Data.bin"));
+
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("hello.txt");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->readByte(), 'H');
+		delete stream;
+
+		delete archive;
+	}
+
+	void test_index_cache_changed_archive() {
+		Common::Archive *archive = Common::makeZipArchive(new Common::MemoryReadStream(zipTestData, sizeof(zipTestData)), "cache_changed.zip");
+		TS_ASSERT(archive);
+		delete archive;
+
+		// The comment changes the end of central directory record, so the
+		// cached index is dropped and the central directory is read again
+		archive = openModifiedArchive("cache_changed.zip", 4);
+		TS_ASSERT(archive);
+		TS_ASSERT(archive->hasFile("hallo.txt"));
+		TS_ASSERT(!archive->hasFile("hello.txt"));
+		TS_ASSERT(archive->hasFile("dir/Data.bin"));
+		delete archive;
+
+		// The new index replaced the stale one in the cache
+		archive = openModifiedArchive("cache_changed.zip", 4);
+		TS_ASSERT(archive);
+		TS_ASSERT(archive->hasFile("hallo.txt"));
+		delete archive;
+	}
+
+	void test_member_outlives_archive() {
+		Common::Archive *archive = openTestArchive();
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("dir/Data.bin");
+		delete archive;
+
+		stream->seek(-2, SEEK_END);
+		TS_ASSERT_EQUALS(stream->readByte(), 30);
+		TS_ASSERT_EQUALS(stream->readByte(), 31);
+
+		delete stream;
+	}
+};